@@ -9,6 +9,7 @@
 #include <cmath>
 #include <cstddef>
 #include <type_traits>
+#include <vector>
 
 namespace ieompp
 {
@@ -54,6 +55,9 @@ namespace ieompp
 
             bool neighboring(SiteIndex a, SiteIndex b) const;
 
+            // site permutations of the point group that keeps site 0 fixed: identity and inversion
+            std::vector<std::vector<SiteIndex>> point_group() const;
+
             ConstIterator begin() const;
             ConstIterator end() const;
             Iterator begin();
@@ -190,6 +194,17 @@ namespace ieompp
             return ((a + 1) % _size == b) || ((b + 1) % _size == a);
         }
 
+        template <typename Float, typename SiteIndex>
+        std::vector<std::vector<SiteIndex>> PeriodicChain<Float, SiteIndex>::point_group() const
+        {
+            std::vector<std::vector<SiteIndex>> group(2, std::vector<SiteIndex>(_size));
+            for(SiteIndex i = 0; i < _size; ++i) {
+                group[0][i] = i;
+                group[1][i] = (_size - i) % _size;
+            }
+            return group;
+        }
+
         template <typename Float, typename SiteIndex>
         typename PeriodicChain<Float, SiteIndex>::ConstIterator
         PeriodicChain<Float, SiteIndex>::begin() const
@@ -11,6 +11,8 @@
 #include <cmath>
 #include <cstddef>
 #include <type_traits>
+#include <utility>
+#include <vector>
 
 namespace ieompp
 {
@@ -67,9 +69,16 @@ namespace ieompp
 
             SiteIndex lattice_distance_x(const SiteIndex& a, const SiteIndex& b) const;
             SiteIndex lattice_distance_y(const SiteIndex& a, const SiteIndex& b) const;
+            // number of hops between the sites
+            SiteIndex lattice_distance(const SiteIndex& a, const SiteIndex& b) const;
 
             bool neighboring(SiteIndex a, SiteIndex b) const;
 
+            // site permutations of the point group that keeps site 0 fixed: the reflections
+            // x -> -x and y -> -y, for a square lattice with Nx = Ny additionally the reflection
+            // at the diagonal and the rotations by multiples of π/2
+            std::vector<std::vector<SiteIndex>> point_group() const;
+
             ConstIndexIterator begin() const;
             ConstIndexIterator end() const;
             IndexIterator begin();
@@ -286,6 +295,13 @@ namespace ieompp
             return std::min(dist, _size_y - dist);
         }
 
+        template <typename Float, typename Index>
+        Index PeriodicSquareLattice<Float, Index>::lattice_distance(const Index& a,
+                                                                    const Index& b) const
+        {
+            return lattice_distance_x(a, b) + lattice_distance_y(a, b);
+        }
+
         template <typename Float, typename Index>
         bool PeriodicSquareLattice<Float, Index>::neighboring(const Index a, const Index b) const
         {
@@ -305,6 +321,37 @@ namespace ieompp
             return false;
         }
 
+        template <typename Float, typename Index>
+        std::vector<std::vector<Index>> PeriodicSquareLattice<Float, Index>::point_group() const
+        {
+            const auto reflect_x = [this](Index x) { return (_size_x - x) % _size_x; };
+            const auto reflect_y = [this](Index y) { return (_size_y - y) % _size_y; };
+
+            std::vector<std::vector<Index>> group(4, std::vector<Index>(_size));
+            for(Index i = 0; i < _size; ++i) {
+                const auto x = x_index(i);
+                const auto y = y_index(i);
+                group[0][i]  = i;
+                group[1][i]  = index(reflect_x(x), y);
+                group[2][i]  = index(x, reflect_y(y));
+                group[3][i]  = index(reflect_x(x), reflect_y(y));
+            }
+
+            if(_size_x == _size_y) {
+                // compose the four elements with the reflection at the diagonal (x, y) -> (y, x)
+                for(Index g = 0; g < 4; ++g) {
+                    std::vector<Index> permutation(_size);
+                    for(Index i = 0; i < _size; ++i) {
+                        const auto image = group[g][i];
+                        permutation[i]   = index(y_index(image), x_index(image));
+                    }
+                    group.push_back(std::move(permutation));
+                }
+            }
+
+            return group;
+        }
+
         template <typename Float, typename Index>
         typename PeriodicSquareLattice<Float, Index>::ConstIndexIterator
         PeriodicSquareLattice<Float, Index>::begin() const
@@ -0,0 +1,58 @@
+#ifndef IEOMPP_MODELS_HUBBARD_CONJUGATE_BASIS_HPP_
+#define IEOMPP_MODELS_HUBBARD_CONJUGATE_BASIS_HPP_
+
+#include <cassert>
+#include <functional>
+
+namespace ieompp
+{
+    namespace models
+    {
+        namespace hubbard
+        {
+            // Read-only view of the conjugate of a basis: operator[] conjugates the monomial of the
+            // underlying basis on access instead of storing a conjugated copy of every monomial
+            // like Basis::get_conjugate(). The view references the basis, which therefore has to
+            // outlive it.
+            template <typename BasisT>
+            class ConjugateBasis
+            {
+            public:
+                using Basis      = BasisT;
+                using Monomial   = typename Basis::Monomial;
+                using BasisIndex = typename Basis::BasisIndex;
+
+            private:
+                std::reference_wrapper<const Basis> _basis;
+
+            public:
+                explicit ConjugateBasis(const Basis& basis) : _basis(basis) {}
+
+                BasisIndex size() const { return _basis.get().size(); }
+
+                Monomial operator[](BasisIndex index) const
+                {
+                    assert(index < size());
+                    return _basis.get()[index].get_conjugate();
+                }
+
+                template <typename... Indices>
+                BasisIndex get_3op_index(Indices... indices) const
+                {
+                    return _basis.get().get_3op_index(indices...);
+                }
+
+                // the conjugate of the conjugate basis is the basis itself
+                const Basis& get_conjugate() const { return _basis.get(); }
+            };
+
+            template <typename Basis>
+            ConjugateBasis<Basis> make_conjugate_basis(const Basis& basis)
+            {
+                return ConjugateBasis<Basis>(basis);
+            }
+        } // namespace hubbard
+    }     // namespace models
+} // namespace ieompp
+
+#endif
@@ -30,9 +30,9 @@ namespace ieompp
             public:
                 using Contribution = NonVanishingExpectationValue<IndexT, FloatT>;
 
-                template <typename Monomial, typename Dispersion>
+                template <typename Monomial, typename ConjugateBasis, typename Dispersion>
                 NonVanishingExpectationValues(const Basis3Operator<Monomial>& basis,
-                                              const Basis3Operator<Monomial>& conjugate_basis,
+                                              const ConjugateBasis& conjugate_basis,
                                               const Dispersion& dispersion,
                                               const typename Contribution::Float& fermi_energy = 0.)
                 {
@@ -42,11 +42,19 @@ namespace ieompp
                     using State      = ExcitedFermiSea<Monomial>;
                     using BasisIndex = typename Basis3Operator<Monomial>::BasisIndex;
 
-                    // calculate b_i^† |FS>
+                    // calculate b_i^† |FS> and whether b_i^† yields a δ_{k1,k2} once, a conjugate
+                    // basis view creates its monomials on every access
                     std::vector<State> states(basis_size);
+                    std::vector<char> conjugate_kronecker(basis_size, false);
                     for(BasisIndex i = 0; i < basis_size; ++i) {
-                        states[i].apply_monomial(conjugate_basis[i], dispersion, fermi_energy);
+                        const auto& conjugate_monomial = conjugate_basis[i];
+                        states[i].apply_monomial(conjugate_monomial, dispersion, fermi_energy);
+                        if(i > 0) {
+                            conjugate_kronecker[i] =
+                                (conjugate_monomial[0].index1 == conjugate_monomial[1].index1);
+                        }
                     }
+                    const auto conjugate_0 = conjugate_basis[0];
 
                     // check if b_0 b_0^† |FS> vanishes
                     auto state = states[0];
@@ -70,7 +78,7 @@ namespace ieompp
                         const bool kronecker = (basis[i][1].index1 == basis[i][2].index1);
                         if(kronecker) {
                             state = State();
-                            state.apply_operator(conjugate_basis[0][0], dispersion, fermi_energy);
+                            state.apply_operator(conjugate_0[0], dispersion, fermi_energy);
                             state.apply_operator(basis[i][0], dispersion, fermi_energy);
                             if(state.is_initial_fermi_sea()) {
                                 value += 1.;
@@ -95,9 +103,7 @@ namespace ieompp
                             vanishes = false;
                         }
 
-                        const bool kronecker =
-                            (conjugate_basis[i][0].index1 == conjugate_basis[i][1].index1);
-                        if(kronecker) {
+                        if(conjugate_kronecker[i]) {
                             state = State();
                             state.apply_operator(conjugate_basis[i][2], dispersion, fermi_energy);
                             state.apply_operator(basis[0][0], dispersion, fermi_energy);
@@ -126,8 +132,7 @@ namespace ieompp
                             }
 
                             const bool kronecker1 = (basis[i][1].index1 == basis[i][2].index1);
-                            const bool kronecker2 =
-                                (conjugate_basis[j][0].index1 == conjugate_basis[j][1].index1);
+                            const bool kronecker2 = conjugate_kronecker[j];
 
                             if(kronecker1) {
                                 state = states[j];
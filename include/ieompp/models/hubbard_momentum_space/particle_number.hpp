@@ -27,10 +27,12 @@ namespace ieompp
 
                 const NonVanishingExpectationValues<Index, Float> non_vanishing_expectation_values;
 
-                template <typename Dispersion>
+                // the conjugate basis is either basis.get_conjugate() or a hubbard::ConjugateBasis
+                // view of basis
+                template <typename ConjugateBasis, typename Dispersion>
                 ParticleNumber(const Basis3Operator<Monomial>& basis,
-                               const Basis3Operator<Monomial>& conjugate_basis,
-                               const Dispersion& dispersion, const Float& fermi_energy = 0.)
+                               const ConjugateBasis& conjugate_basis, const Dispersion& dispersion,
+                               const Float& fermi_energy = 0.)
                     : non_vanishing_expectation_values(basis, conjugate_basis, dispersion,
                                                        fermi_energy)
                 {
@@ -60,9 +62,9 @@ namespace ieompp
                 }
             };
 
-            template <typename Basis, typename Dispersion, typename Float>
+            template <typename Basis, typename ConjugateBasis, typename Dispersion, typename Float>
             ParticleNumber<Float, Basis>
-            make_particle_number(const Basis& basis, const Basis& conjugate_basis,
+            make_particle_number(const Basis& basis, const ConjugateBasis& conjugate_basis,
                                  const Dispersion& dispersion, const Float& fermi_energy = 0.)
             {
                 return ParticleNumber<Float, Basis>(basis, conjugate_basis, dispersion,
@@ -0,0 +1,108 @@
+#ifndef IEOMPP_MODELS_HUBBARD_REAL_SPACE_ADAPTIVE_BASIS_HPP_
+#define IEOMPP_MODELS_HUBBARD_REAL_SPACE_ADAPTIVE_BASIS_HPP_
+
+#include "ieompp/models/hubbard_real_space/implicit_basis.hpp"
+#include "ieompp/types/hash_index.hpp"
+
+#include <cassert>
+#include <utility>
+#include <vector>
+
+namespace ieompp
+{
+    namespace models
+    {
+        namespace hubbard_real_space
+        {
+            // Three operator basis that grows on demand: it starts with the one operator monomials
+            // c_{i,↑}^† and three operator monomials of the real-space basis are inserted later.
+            // Elements 0 to N - 1 are the one operator monomials, the three operator monomials
+            // follow in the order of their insertion, so the indices of the existing elements
+            // never change. The real-space indices of the inserted elements are looked up in a
+            // hash index.
+            template <typename OperatorT>
+            class AdaptiveBasis3Operator
+            {
+            public:
+                using Operator       = OperatorT;
+                using RealSpaceBasis = ImplicitBasis3Operator<Operator>;
+                using Monomial       = typename RealSpaceBasis::Monomial;
+                using BasisIndex     = typename RealSpaceBasis::BasisIndex;
+
+                const BasisIndex N;
+                const RealSpaceBasis real_space_basis;
+
+            private:
+                // real-space indices of the three operator elements in the order of insertion
+                std::vector<BasisIndex> _elements;
+                types::HashIndex<BasisIndex> _index;
+
+            public:
+                template <typename Lattice>
+                explicit AdaptiveBasis3Operator(const Lattice& lattice)
+                    : N(lattice.size()), real_space_basis(lattice)
+                {
+                }
+
+                BasisIndex size() const { return N + _elements.size(); }
+
+                Monomial operator[](BasisIndex index) const
+                {
+                    return real_space_basis[real_space_index(index)];
+                }
+
+                // index of the element in the real-space basis
+                BasisIndex real_space_index(BasisIndex index) const
+                {
+                    assert(index < size());
+                    return (index < N) ? index : _elements[index - N];
+                }
+
+                // index of the real-space element real_space_index, size() if it is not contained
+                BasisIndex find(BasisIndex real_space_index) const
+                {
+                    assert(real_space_index < real_space_basis.size());
+                    if(real_space_index < N) {
+                        return real_space_index;
+                    }
+                    const auto index = _index.find(real_space_index);
+                    return (index == _index.not_found) ? size() : index;
+                }
+
+                // append the real-space element real_space_index unless it is already contained,
+                // returns its index and whether it was inserted
+                std::pair<BasisIndex, bool> insert(BasisIndex real_space_index)
+                {
+                    assert(real_space_index < real_space_basis.size());
+                    if(real_space_index < N) {
+                        return std::make_pair(real_space_index, false);
+                    }
+                    const auto result = _index.insert(real_space_index, size());
+                    if(result.second) {
+                        _elements.push_back(real_space_index);
+                    }
+                    return result;
+                }
+            };
+
+            // h is resized to the dimension of the real-space basis, the elements that are not
+            // contained in the adaptive basis are zero
+            template <typename Operator, typename Vector, typename RealSpaceVector>
+            void adaptive_to_real_space(const AdaptiveBasis3Operator<Operator>& basis,
+                                        const Vector& v, RealSpaceVector& h)
+            {
+                using BasisIndex = typename AdaptiveBasis3Operator<Operator>::BasisIndex;
+
+                h.resize(basis.real_space_basis.size());
+                h.reset();
+                const BasisIndex size = basis.size();
+#pragma omp parallel for schedule(static)
+                for(BasisIndex i = 0; i < size; ++i) {
+                    h[basis.real_space_index(i)] = v[i];
+                }
+            }
+        } // namespace hubbard_real_space
+    }     // namespace models
+} // namespace ieompp
+
+#endif
@@ -0,0 +1,252 @@
+#ifndef IEOMPP_MODELS_HUBBARD_REAL_SPACE_ADAPTIVE_MATRIX_HPP_
+#define IEOMPP_MODELS_HUBBARD_REAL_SPACE_ADAPTIVE_MATRIX_HPP_
+
+#include "ieompp/models/hubbard_real_space/adaptive_basis.hpp"
+#include "ieompp/models/hubbard_real_space/blaze_sparse.hpp"
+#include "ieompp/openmp.hpp"
+#include "ieompp/types/function_matrix.hpp"
+#include "ieompp/types/growing_row_matrix.hpp"
+#include "ieompp/types/matrix.hpp"
+#include "ieompp/types/multiply_assign.hpp"
+#include "ieompp/types/triplet.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace ieompp
+{
+    namespace models
+    {
+        namespace hubbard_real_space
+        {
+            // Real Liouvillian matrix on an AdaptiveBasis3Operator that grows together with the
+            // basis. The matrix is the principal submatrix of the real-space matrix on the
+            // elements of the basis, the couplings of its rows to the elements outside of the
+            // basis are kept as the boundary. Since the real-space matrix is symmetric, the flux
+            // d h_j / dt = i Σ_i M[j, i] h_i into a boundary element j can be computed from the
+            // boundary alone.
+            //
+            // grow inserts the boundary elements with a large flux into the basis and appends
+            // their rows without rebuilding the existing ones: the new elements are the last
+            // columns, so their couplings are appended to the existing rows.
+            template <typename ScalarT, typename OperatorT, typename LiouvillianT,
+                      typename LatticeT>
+            class AdaptiveMatrix
+            {
+            public:
+                using Scalar      = ScalarT;
+                using Basis       = AdaptiveBasis3Operator<OperatorT>;
+                using BasisIndex  = typename Basis::BasisIndex;
+                using Index       = std::uint32_t;
+                using Matrix      = types::GrowingRowMatrix<Scalar, Index>;
+                using Liouvillian = LiouvillianT;
+                using Lattice     = LatticeT;
+
+            private:
+                const std::reference_wrapper<Basis> _basis_ref;
+                const Liouvillian _liouvillian;
+                const std::reference_wrapper<const Lattice> _lattice_ref;
+                Matrix _matrix;
+                // couplings (row, M[row, j]) of the rows to the real-space element j
+                std::unordered_map<BasisIndex, std::vector<std::pair<Index, Scalar>>> _boundary;
+
+            public:
+                AdaptiveMatrix(const Liouvillian& liouvillian, Basis& basis, const Lattice& lattice)
+                    : _basis_ref(basis), _liouvillian(liouvillian), _lattice_ref(lattice)
+                {
+                    extend();
+                }
+
+                Index rows() const { return _matrix.rows(); }
+                Index columns() const { return _matrix.columns(); }
+                std::size_t non_zeros() const { return _matrix.non_zeros(); }
+                std::size_t boundary_size() const { return _boundary.size(); }
+
+                const Basis& basis() const { return _basis_ref.get(); }
+                const Matrix& matrix() const { return _matrix; }
+
+                template <typename InputVector, typename OutputVector>
+                void multiply(const InputVector& x, OutputVector& y) const
+                {
+                    _matrix.multiply(x, y);
+                }
+
+                // append the rows of the basis elements that were inserted since the last call
+                void extend()
+                {
+                    const auto& basis     = _basis_ref.get();
+                    const Index first     = _matrix.rows();
+                    const BasisIndex size = basis.size();
+                    if(first == size) {
+                        return;
+                    }
+
+                    // the real-space rows of the new elements
+                    std::vector<types::TripletList<Scalar, BasisIndex>> real_space_rows;
+                    real_space_rows.resize(size - first);
+#pragma omp parallel for schedule(static)
+                    for(BasisIndex row = first; row < size; ++row) {
+                        auto& triplets = real_space_rows[row - first];
+                        detail::matrix_row(_liouvillian, basis.real_space_basis,
+                                           _lattice_ref.get(), basis.real_space_index(row),
+                                           triplets);
+                        triplets.merge_columns();
+                    }
+
+                    _matrix.resize(size, size);
+                    types::TripletList<Scalar, Index> triplets;
+                    for(BasisIndex row = first; row < size; ++row) {
+                        triplets.clear();
+                        for(const auto& triplet : real_space_rows[row - first]) {
+                            const auto column = basis.find(triplet.column);
+                            if(column == size) {
+                                _boundary[triplet.column].emplace_back(row, triplet.value);
+                                continue;
+                            }
+                            triplets.emplace_back(row, column, triplet.value);
+                            // the existing rows get the new columns in increasing order
+                            if(column < first) {
+                                _matrix.append(column, row, triplet.value);
+                            }
+                        }
+                        triplets.sort();
+                        for(const auto& triplet : triplets) {
+                            _matrix.append(row, triplet.column, triplet.value);
+                        }
+                    }
+
+                    for(BasisIndex row = first; row < size; ++row) {
+                        _boundary.erase(basis.real_space_index(row));
+                    }
+                }
+
+                // real-space indices of the boundary elements j with |d h_j / dt| > threshold in
+                // increasing order, returns the norm of the flux into all boundary elements
+                template <typename Vector>
+                Scalar flux(const Vector& h, const Scalar& threshold,
+                            std::vector<BasisIndex>& elements) const
+                {
+                    using Value = typename types::ScalarType<Vector>::Type;
+
+                    std::vector<Scalar> norms(omp_get_max_threads(), 0.);
+                    std::vector<std::vector<BasisIndex>> selected(omp_get_max_threads());
+
+                    const std::size_t buckets = _boundary.bucket_count();
+#pragma omp parallel for schedule(static)
+                    for(std::size_t bucket = 0; bucket < buckets; ++bucket) {
+                        const auto thread = omp_get_thread_num();
+                        for(auto it = _boundary.begin(bucket); it != _boundary.end(bucket); ++it) {
+                            Value sum = 0.;
+                            for(const auto& coupling : it->second) {
+                                sum += coupling.second * h[coupling.first];
+                            }
+                            const Scalar value = std::abs(sum);
+                            if(value > threshold) {
+                                selected[thread].push_back(it->first);
+                            }
+                            norms[thread] += value * value;
+                        }
+                    }
+
+                    elements.clear();
+                    Scalar norm = 0.;
+                    for(std::size_t thread = 0; thread < selected.size(); ++thread) {
+                        elements.insert(elements.end(), selected[thread].begin(),
+                                        selected[thread].end());
+                        norm += norms[thread];
+                    }
+                    std::sort(elements.begin(), elements.end());
+                    return std::sqrt(norm);
+                }
+
+                // insert the boundary elements with a flux above the threshold into the basis,
+                // append their rows and extend h by zeros. Returns the norm of the flux out of the
+                // basis before the growth.
+                template <typename Vector>
+                Scalar grow(Vector& h, const Scalar& threshold)
+                {
+                    assert(h.size() == rows());
+
+                    std::vector<BasisIndex> elements;
+                    const auto norm = flux(h, threshold, elements);
+                    if(elements.empty()) {
+                        return norm;
+                    }
+
+                    auto& basis = _basis_ref.get();
+                    for(auto element : elements) {
+                        basis.insert(element);
+                    }
+                    const Index old_size = rows();
+                    extend();
+
+                    Vector grown(rows());
+                    grown.reset();
+#pragma omp parallel for schedule(static)
+                    for(Index i = 0; i < old_size; ++i) {
+                        grown[i] = h[i];
+                    }
+                    using std::swap;
+                    swap(h, grown);
+
+                    return norm;
+                }
+            };
+        } // namespace hubbard_real_space
+    }     // namespace models
+
+    namespace types
+    {
+        template <typename Scalar, typename Operator, typename Liouvillian, typename Lattice>
+        struct is_function_matrix<
+            models::hubbard_real_space::AdaptiveMatrix<Scalar, Operator, Liouvillian, Lattice>> {
+            static constexpr bool value = true;
+        };
+
+        template <typename Scalar, typename Operator, typename Liouvillian, typename Lattice>
+        struct ScalarType<
+            models::hubbard_real_space::AdaptiveMatrix<Scalar, Operator, Liouvillian, Lattice>> {
+            using Type = Scalar;
+        };
+
+        template <typename Scalar, typename Operator, typename Liouvillian, typename Lattice>
+        struct IndexType<
+            models::hubbard_real_space::AdaptiveMatrix<Scalar, Operator, Liouvillian, Lattice>> {
+            using Type = std::uint32_t;
+        };
+
+        template <typename Scalar, typename Operator, typename Liouvillian, typename Lattice>
+        struct MatrixDimensionInfo<
+            models::hubbard_real_space::AdaptiveMatrix<Scalar, Operator, Liouvillian, Lattice>> {
+            using Matrix =
+                models::hubbard_real_space::AdaptiveMatrix<Scalar, Operator, Liouvillian, Lattice>;
+
+            static std::uint32_t rows(const Matrix& m) { return m.rows(); }
+            static std::uint32_t columns(const Matrix& m) { return m.columns(); }
+        };
+
+        template <typename Scalar, typename Operator, typename Liouvillian, typename Lattice>
+        struct MultiplyAssign<
+            models::hubbard_real_space::AdaptiveMatrix<Scalar, Operator, Liouvillian, Lattice>> {
+            using Matrix =
+                models::hubbard_real_space::AdaptiveMatrix<Scalar, Operator, Liouvillian, Lattice>;
+
+            template <typename Vector>
+            static void apply(const Matrix& matrix, Vector& vector)
+            {
+                Vector temp(matrix.rows());
+                matrix.multiply(vector, temp);
+                using std::swap;
+                swap(vector, temp);
+            }
+        };
+    } // namespace types
+} // namespace ieompp
+
+#endif
@@ -0,0 +1,71 @@
+#ifndef IEOMPP_MODELS_HUBBARD_REAL_SPACE_BASIS_ORDERING_HPP_
+#define IEOMPP_MODELS_HUBBARD_REAL_SPACE_BASIS_ORDERING_HPP_
+
+#include "ieompp/models/hubbard_real_space/basis.hpp"
+#include "ieompp/types/permutation.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <vector>
+
+namespace ieompp
+{
+    namespace models
+    {
+        namespace hubbard_real_space
+        {
+            // Calls f(index) for the indices of the basis in the blocked order: the 1-operator
+            // monomials keep their position at the front, the 3-operator monomials follow in
+            // cubic tiles of block_size^3 site triples (i1, i2, i3), the tiles and the triples
+            // within a tile are lexicographic.
+            template <typename Basis, typename Function>
+            void for_each_blocked_index(const Basis& basis, typename Basis::BasisIndex block_size,
+                                        const Function& f)
+            {
+                using Index = typename Basis::BasisIndex;
+
+                assert(block_size > 0);
+
+                const Index N = basis.N;
+                for(Index i = 0; i < basis.N; ++i) {
+                    f(i);
+                }
+
+                for(Index b1 = 0; b1 < N; b1 += block_size) {
+                    for(Index b2 = 0; b2 < N; b2 += block_size) {
+                        for(Index b3 = 0; b3 < N; b3 += block_size) {
+                            for(Index i1 = b1; i1 < std::min(b1 + block_size, N); ++i1) {
+                                for(Index i2 = b2; i2 < std::min(b2 + block_size, N); ++i2) {
+                                    for(Index i3 = b3; i3 < std::min(b3 + block_size, N);
+                                        ++i3) {
+                                        f(basis.get_3op_index(i1, i2, i3));
+                                    }
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+
+            // Order the basis as for_each_blocked_index. A hopping on any of the three sites
+            // mostly stays within a tile, while the lexicographic order of get_3op_index moves by
+            // N^2 for a hopping on i1.
+            template <typename Basis>
+            types::Permutation<typename Basis::BasisIndex>
+            blocked_basis_ordering(const Basis& basis, typename Basis::BasisIndex block_size)
+            {
+                using Index = typename Basis::BasisIndex;
+
+                std::vector<Index> new_to_old;
+                new_to_old.reserve(basis.size());
+                for_each_blocked_index(basis, block_size,
+                                       [&new_to_old](Index index) { new_to_old.push_back(index); });
+
+                assert(new_to_old.size() == basis.size());
+                return types::Permutation<Index>(std::move(new_to_old));
+            }
+        } // namespace hubbard_real_space
+    }     // namespace models
+} // namespace ieompp
+
+#endif
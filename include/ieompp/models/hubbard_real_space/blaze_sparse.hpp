@@ -3,9 +3,19 @@
 
 #include "ieompp/models/hubbard_real_space/basis.hpp"
 #include "ieompp/models/hubbard_real_space/liouvillian.hpp"
+#include "ieompp/models/hubbard_real_space/split_matrix.hpp"
+#include "ieompp/models/hubbard_real_space/symmetric_basis.hpp"
+#include "ieompp/models/hubbard_real_space/translation_basis.hpp"
+#include "ieompp/models/hubbard_real_space/truncated_basis.hpp"
+#include "ieompp/types/row_assembly.hpp"
 #include "ieompp/types/triplet.hpp"
 
+#include <cmath>
+#include <complex>
 #include <cstdint>
+#include <type_traits>
+#include <utility>
+#include <vector>
 
 namespace ieompp
 {
@@ -13,41 +23,42 @@ namespace ieompp
     {
         namespace hubbard_real_space
         {
+            // The element counts are exact for the real-space bases of lattices whose sites have
+            // distinct neighbors, otherwise they are upper bounds. A one operator row couples to
+            // the neighbors of its site, a three operator row to the neighbors of each of its
+            // three sites.
             template <typename Monomial, typename Lattice>
             uint64_t number_of_kinetic_elements(const Basis1Operator<Monomial>& basis)
             {
                 return basis.N * Lattice::coordination_number;
             }
 
-            template <typename Monomial, typename Lattice>
-            uint64_t number_of_kinetic_elements(const Basis3Operator<Monomial>& basis)
+            template <typename Basis, typename Lattice>
+            typename std::enable_if<IsThreeOperatorBasis<Basis>::value, uint64_t>::type
+            number_of_kinetic_elements(const Basis& basis)
             {
                 return (basis.N * Lattice::coordination_number)
-                       + (basis.N * basis.N_squared * 6 * Lattice::coordination_number);
+                       + ((basis.size() - basis.N) * 3 * Lattice::coordination_number);
             }
 
-            template <typename Monomial>
-            uint64_t number_of_interaction_elements(const Basis3Operator<Monomial>& basis)
+            // every row has a diagonal element, c_{i,↑}^† and c_{i,↑}^† c_{i,↓}^† c_{i,↓} couple
+            // to each other
+            template <typename Basis>
+            uint64_t number_of_interaction_elements(const Basis& basis)
             {
-                return basis.size() * 2;
+                return basis.size() + 2 * basis.N;
             }
 
-            template <typename Liouvillian, typename Matrix, typename Monomial, typename Lattice>
-            void init_kinetic_matrix(const Liouvillian& liouvillian, Matrix& matrix,
-                                     const Basis1Operator<Monomial>& basis, const Lattice& lattice)
+            namespace detail
             {
-                using Scalar = typename types::ScalarType<Matrix>::Type;
-                using Index  = typename types::IndexType<Matrix>::Type;
-
-                static_assert(hubbard::IsHubbardOperator<typename Monomial::Operator>::value,
-                              "Operator-type in Monomial-type must be a Hubbard like operator!");
-
-                matrix.resize(basis.size(), basis.size(), false);
-                matrix.reset();
-                matrix.reserve(number_of_kinetic_elements<Monomial, Lattice>(basis));
-
-                types::TripletList<Scalar, Index> triplets;
-                for(Index row = 0; row < basis.N; ++row) {
+                template <typename Liouvillian, typename Monomial, typename Lattice,
+                          typename Scalar, typename Index>
+                void kinetic_matrix_row(const Liouvillian& liouvillian,
+                                        const Basis1Operator<Monomial>& basis,
+                                        const Lattice& lattice, Index row,
+                                        types::TripletList<Scalar, Index>& triplets)
+                {
+                    static_cast<void>(basis);
                     triplets.clear();
 
                     const auto neighbors = lattice.neighbors(row);
@@ -55,50 +66,28 @@ namespace ieompp
                         triplets.emplace_back(row, neighbor, -liouvillian.J);
                     }
                     triplets.sort();
-
-                    for(const auto triplet : triplets) {
-                        matrix.append(row, triplet.column, triplet.value);
-                    }
-                    matrix.finalize(row);
                 }
-            }
-
-            template <typename Liouvillian, typename Matrix, typename Monomial, typename Lattice>
-            void init_matrix(const Liouvillian& liouvillian, Matrix& matrix,
-                             const Basis3Operator<Monomial>& basis, const Lattice& lattice)
-            {
-                using Scalar = typename types::ScalarType<Matrix>::Type;
-                using Index  = typename types::IndexType<Matrix>::Type;
 
-                static_assert(hubbard::IsHubbardOperator<typename Monomial::Operator>::value,
-                              "Operator-type in Monomial-type must be a Hubbard like operator!");
-
-                matrix.resize(basis.size(), basis.size(), false);
-                matrix.reset();
-                matrix.reserve(number_of_kinetic_elements<Monomial, Lattice>(basis)
-                               + number_of_interaction_elements(basis));
-
-                types::TripletList<Scalar, Index> triplets;
-                for(Index row = 0; row < basis.N; ++row) {
+                template <typename Liouvillian, typename Basis, typename Lattice,
+                          typename Scalar, typename Index>
+                void matrix_row(const Liouvillian& liouvillian, const Basis& basis,
+                                const Lattice& lattice, Index row,
+                                types::TripletList<Scalar, Index>& triplets)
+                {
                     triplets.clear();
 
-                    auto neighbors = lattice.neighbors(row);
-                    for(auto neighbor : neighbors) {
-                        triplets.emplace_back(row, neighbor, -liouvillian.J);
-                    }
-                    triplets.emplace_back(row, row, liouvillian.U / 2.);
-                    triplets.emplace_back(row, basis.get_3op_index(row, row, row),
-                                          liouvillian.U / 2.);
+                    if(row < basis.N) {
+                        auto neighbors = lattice.neighbors(row);
+                        for(auto neighbor : neighbors) {
+                            triplets.emplace_back(row, neighbor, -liouvillian.J);
+                        }
+                        triplets.emplace_back(row, row, liouvillian.U / 2.);
+                        triplets.emplace_back(row, basis.get_3op_index(row, row, row),
+                                              liouvillian.U / 2.);
 
-                    triplets.sort();
-                    for(const auto triplet : triplets) {
-                        matrix.append(row, triplet.column, triplet.value);
+                        triplets.sort();
+                        return;
                     }
-                    matrix.finalize(row);
-                }
-
-                for(Index row = basis.N; row < basis.size(); ++row) {
-                    triplets.clear();
 
                     const auto& monomial = basis[row];
                     auto neighbors       = lattice.neighbors(monomial[0].index1);
@@ -130,12 +119,285 @@ namespace ieompp
                     triplets.emplace_back(row, row, liouvillian.U / 2.);
 
                     triplets.sort();
+                }
+
+                // row of the momentum sector matrix M_q[r, r'] = Σ_s M[(0, r), (s, r')] e^{-i q s},
+                // the real-space row of the representative r is folded onto the representatives
+                template <typename Liouvillian, typename Operator, typename Lattice,
+                          typename Scalar, typename Index>
+                void matrix_row(const Liouvillian& liouvillian,
+                                const TranslationBasis3Operator<Operator>& basis,
+                                const Lattice& lattice, const std::vector<Scalar>& phases,
+                                Index row, types::TripletList<Scalar, Index>& real_space_triplets,
+                                types::TripletList<Scalar, Index>& triplets)
+                {
+                    matrix_row(liouvillian, basis.real_space_basis, lattice,
+                               Index(basis.real_space_index(0, row)), real_space_triplets);
+
+                    triplets.clear();
+                    for(const auto& triplet : real_space_triplets) {
+                        const auto reduced = basis.reduce(triplet.column);
+                        triplets.emplace_back(row, reduced.first,
+                                              triplet.value * phases[reduced.second]);
+                    }
+                    triplets.sort();
+                    triplets.merge_columns();
+                }
+
+                // row of the symmetric sector matrix
+                //   M_G[O, O'] = sqrt(|O| / |O'|) Σ_{b in O'} M[rep(O), b],
+                // the real-space row of the representative is folded onto the orbits
+                template <typename Liouvillian, typename Operator, typename Lattice,
+                          typename Scalar, typename Index>
+                void matrix_row(const Liouvillian& liouvillian,
+                                const SymmetricBasis3Operator<Operator>& basis,
+                                const Lattice& lattice, Index row,
+                                types::TripletList<Scalar, Index>& real_space_triplets,
+                                types::TripletList<Scalar, Index>& triplets)
+                {
+                    matrix_row(liouvillian, basis.real_space_basis, lattice,
+                               Index(basis.representative(row)), real_space_triplets);
+
+                    const auto row_size = Scalar(basis.orbit_size(row));
+                    triplets.clear();
+                    for(const auto& triplet : real_space_triplets) {
+                        const auto column = basis.reduce(triplet.column);
+                        triplets.emplace_back(
+                            row, column,
+                            triplet.value * std::sqrt(row_size / Scalar(basis.orbit_size(column))));
+                    }
+                    triplets.sort();
+                    triplets.merge_columns();
+                }
+
+                // row of the truncated matrix, the real-space row without the couplings to
+                // elements outside of the basis. The columns stay sorted since the truncated basis
+                // keeps the order of the real-space basis.
+                template <typename Liouvillian, typename Operator, typename Lattice,
+                          typename Scalar, typename Index>
+                void matrix_row(const Liouvillian& liouvillian,
+                                const TruncatedBasis3Operator<Operator>& basis,
+                                const Lattice& lattice, Index row,
+                                types::TripletList<Scalar, Index>& real_space_triplets,
+                                types::TripletList<Scalar, Index>& triplets)
+                {
+                    matrix_row(liouvillian, basis.real_space_basis, lattice,
+                               Index(basis.real_space_index(row)), real_space_triplets);
+
+                    const auto size = basis.size();
+                    triplets.clear();
+                    for(const auto& triplet : real_space_triplets) {
+                        const auto column = basis.find(triplet.column);
+                        if(column != size) {
+                            triplets.emplace_back(row, column, triplet.value);
+                        }
+                    }
+                }
+            } // namespace detail
+
+            template <typename Liouvillian, typename Matrix, typename Monomial, typename Lattice>
+            void init_kinetic_matrix(const Liouvillian& liouvillian, Matrix& matrix,
+                                     const Basis1Operator<Monomial>& basis, const Lattice& lattice)
+            {
+                using Scalar = typename types::ScalarType<Matrix>::Type;
+                using Index  = typename types::IndexType<Matrix>::Type;
+
+                static_assert(hubbard::IsHubbardOperator<typename Monomial::Operator>::value,
+                              "Operator-type in Monomial-type must be a Hubbard like operator!");
+
+                matrix.resize(basis.size(), basis.size(), false);
+                matrix.reset();
+                matrix.reserve(number_of_kinetic_elements<Monomial, Lattice>(basis));
+
+                types::TripletList<Scalar, Index> triplets;
+                for(Index row = 0; row < basis.N; ++row) {
+                    detail::kinetic_matrix_row(liouvillian, basis, lattice, row, triplets);
+
+                    for(const auto triplet : triplets) {
+                        matrix.append(row, triplet.column, triplet.value);
+                    }
+                    matrix.finalize(row);
+                }
+            }
+
+            template <typename Liouvillian, typename Matrix, typename Basis, typename Lattice>
+            void init_matrix(const Liouvillian& liouvillian, Matrix& matrix, const Basis& basis,
+                             const Lattice& lattice)
+            {
+                using Scalar = typename types::ScalarType<Matrix>::Type;
+                using Index  = typename types::IndexType<Matrix>::Type;
+
+                static_assert(IsThreeOperatorBasis<Basis>::value,
+                              "Basis must be a three operator basis");
+                static_assert(
+                    hubbard::IsHubbardOperator<typename Basis::Monomial::Operator>::value,
+                    "Operator-type in Monomial-type must be a Hubbard like operator!");
+
+                matrix.resize(basis.size(), basis.size(), false);
+                matrix.reset();
+                matrix.reserve(number_of_kinetic_elements<Basis, Lattice>(basis)
+                               + number_of_interaction_elements(basis));
+
+                types::TripletList<Scalar, Index> triplets;
+                for(Index row = 0; row < basis.size(); ++row) {
+                    detail::matrix_row(liouvillian, basis, lattice, row, triplets);
+
                     for(const auto triplet : triplets) {
                         matrix.append(row, triplet.column, triplet.value);
                     }
                     matrix.finalize(row);
                 }
             }
+
+            // same result as init_kinetic_matrix, the rows are computed by all threads and handed
+            // to matrix by types::assign_rows
+            template <typename Liouvillian, typename Matrix, typename Monomial, typename Lattice>
+            void init_kinetic_matrix_parallel(const Liouvillian& liouvillian, Matrix& matrix,
+                                              const Basis1Operator<Monomial>& basis,
+                                              const Lattice& lattice)
+            {
+                using Scalar = typename types::ScalarType<Matrix>::Type;
+                using Index  = typename types::IndexType<Matrix>::Type;
+
+                static_assert(hubbard::IsHubbardOperator<typename Monomial::Operator>::value,
+                              "Operator-type in Monomial-type must be a Hubbard like operator!");
+
+                auto rows = types::assemble_rows_parallel<Scalar, Index>(
+                    basis.size(),
+                    [&](Index row, types::TripletList<Scalar, Index>& triplets) {
+                        detail::kinetic_matrix_row(liouvillian, basis, lattice, row, triplets);
+                    },
+                    Lattice::coordination_number);
+
+                types::assign_rows(matrix, basis.size(), std::move(rows));
+            }
+
+            // same result as init_matrix, the rows are computed by all threads and handed to
+            // matrix by types::assign_rows
+            template <typename Liouvillian, typename Matrix, typename Basis, typename Lattice>
+            void init_matrix_parallel(const Liouvillian& liouvillian, Matrix& matrix,
+                                      const Basis& basis, const Lattice& lattice)
+            {
+                using Scalar = typename types::ScalarType<Matrix>::Type;
+                using Index  = typename types::IndexType<Matrix>::Type;
+
+                static_assert(IsThreeOperatorBasis<Basis>::value,
+                              "Basis must be a three operator basis");
+                static_assert(
+                    hubbard::IsHubbardOperator<typename Basis::Monomial::Operator>::value,
+                    "Operator-type in Monomial-type must be a Hubbard like operator!");
+
+                auto rows = types::assemble_rows_parallel<Scalar, Index>(
+                    basis.size(),
+                    [&](Index row, types::TripletList<Scalar, Index>& triplets) {
+                        detail::matrix_row(liouvillian, basis, lattice, row, triplets);
+                    },
+                    3 * Lattice::coordination_number + 2);
+
+                types::assign_rows(matrix, basis.size(), std::move(rows));
+            }
+
+            // complex Hermitian matrix of the momentum sector basis.momentum_index, the
+            // coefficients of the sector obey dĥ/dt = i M_q ĥ like the real-space ones
+            template <typename Liouvillian, typename Matrix, typename Operator, typename Lattice>
+            void init_matrix_parallel(const Liouvillian& liouvillian, Matrix& matrix,
+                                      const TranslationBasis3Operator<Operator>& basis,
+                                      const Lattice& lattice)
+            {
+                using Scalar = typename types::ScalarType<Matrix>::Type;
+                using Index  = typename types::IndexType<Matrix>::Type;
+                using Float  = typename Scalar::value_type;
+
+                static_assert(std::is_same<Scalar, std::complex<Float>>::value,
+                              "Matrix of a momentum sector must be complex");
+
+                // e^{-i q s} for all translations s
+                std::vector<Scalar> phases(basis.N);
+                for(Index s = 0; s < basis.N; ++s) {
+                    const auto arg = -basis.template momentum<Float>() * Float(s);
+                    phases[s]      = Scalar(std::cos(arg), std::sin(arg));
+                }
+
+                auto rows = types::assemble_rows_parallel<Scalar, Index>(
+                    basis.size(),
+                    [&](Index row, types::TripletList<Scalar, Index>& triplets) {
+                        thread_local types::TripletList<Scalar, Index> real_space_triplets;
+                        detail::matrix_row(liouvillian, basis, lattice, phases, row,
+                                           real_space_triplets, triplets);
+                    },
+                    3 * Lattice::coordination_number + 2);
+
+                types::assign_rows(matrix, basis.size(), std::move(rows));
+            }
+
+            // real symmetric matrix of the symmetric sector, the coefficients of the sector obey
+            // dv/dt = i M_G v like the real-space ones
+            template <typename Liouvillian, typename Matrix, typename Operator, typename Lattice>
+            void init_matrix_parallel(const Liouvillian& liouvillian, Matrix& matrix,
+                                      const SymmetricBasis3Operator<Operator>& basis,
+                                      const Lattice& lattice)
+            {
+                using Scalar = typename types::ScalarType<Matrix>::Type;
+                using Index  = typename types::IndexType<Matrix>::Type;
+
+                auto rows = types::assemble_rows_parallel<Scalar, Index>(
+                    basis.size(),
+                    [&](Index row, types::TripletList<Scalar, Index>& triplets) {
+                        thread_local types::TripletList<Scalar, Index> real_space_triplets;
+                        detail::matrix_row(liouvillian, basis, lattice, row, real_space_triplets,
+                                           triplets);
+                    },
+                    3 * Lattice::coordination_number + 2);
+
+                types::assign_rows(matrix, basis.size(), std::move(rows));
+            }
+
+            // real symmetric matrix of the truncated basis, the principal submatrix of the
+            // real-space matrix
+            template <typename Liouvillian, typename Matrix, typename Operator, typename Lattice>
+            void init_matrix_parallel(const Liouvillian& liouvillian, Matrix& matrix,
+                                      const TruncatedBasis3Operator<Operator>& basis,
+                                      const Lattice& lattice)
+            {
+                using Scalar = typename types::ScalarType<Matrix>::Type;
+                using Index  = typename types::IndexType<Matrix>::Type;
+
+                auto rows = types::assemble_rows_parallel<Scalar, Index>(
+                    basis.size(),
+                    [&](Index row, types::TripletList<Scalar, Index>& triplets) {
+                        thread_local types::TripletList<Scalar, Index> real_space_triplets;
+                        detail::matrix_row(liouvillian, basis, lattice, row, real_space_triplets,
+                                           triplets);
+                    },
+                    3 * Lattice::coordination_number + 2);
+
+                types::assign_rows(matrix, basis.size(), std::move(rows));
+            }
+
+            // assemble the kinetic and the interaction part of the matrix built by init_matrix on
+            // their merged pattern, combine them with init_combined_matrix and
+            // update_combined_matrix
+            template <typename Float, typename Basis, typename Lattice>
+            SplitMatrix<Float, typename Basis::BasisIndex>
+            init_split_matrix(const Basis& basis, const Lattice& lattice)
+            {
+                using Index   = typename Basis::BasisIndex;
+                using Carrier = std::complex<Float>;
+
+                static_assert(IsThreeOperatorBasis<Basis>::value,
+                              "Basis must be a three operator basis");
+                static_assert(
+                    hubbard::IsHubbardOperator<typename Basis::Monomial::Operator>::value,
+                    "Operator-type in Monomial-type must be a Hubbard like operator!");
+
+                const auto liouvillian = make_liouvillian(Carrier(1., 0.), Carrier(0., 1.));
+                return detail::make_split_matrix(types::assemble_rows_parallel<Carrier, Index>(
+                    basis.size(),
+                    [&](Index row, types::TripletList<Carrier, Index>& triplets) {
+                        detail::matrix_row(liouvillian, basis, lattice, row, triplets);
+                    },
+                    3 * Lattice::coordination_number + 2));
+            }
         } // namespace hubbard_real_space
     }     // namespace models
 } // namespace ieompp
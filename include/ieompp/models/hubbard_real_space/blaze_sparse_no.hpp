@@ -3,10 +3,15 @@
 
 #include "ieompp/models/hubbard_real_space/basis.hpp"
 #include "ieompp/models/hubbard_real_space/liouvillian.hpp"
+#include "ieompp/models/hubbard_real_space/split_matrix.hpp"
 #include "ieompp/types/number.hpp"
+#include "ieompp/types/row_assembly.hpp"
 #include "ieompp/types/triplet.hpp"
 
+#include <complex>
 #include <cstdint>
+#include <type_traits>
+#include <utility>
 
 namespace ieompp
 {
@@ -20,36 +25,30 @@ namespace ieompp
                 return basis.N * Lattice::coordination_number;
             }
 
-            template <typename Monomial, typename Lattice>
-            uint64_t number_of_kinetic_elements_no(const Basis3Operator<Monomial>& basis)
+            template <typename Basis, typename Lattice>
+            typename std::enable_if<IsThreeOperatorBasis<Basis>::value, uint64_t>::type
+            number_of_kinetic_elements_no(const Basis& basis)
             {
                 return (basis.N * Lattice::coordination_number)
                        + ((basis.size() - basis.N) * 6 * Lattice::coordination_number);
             }
 
-            template <typename Monomial>
-            uint64_t number_of_interaction_elements_no(const Basis3Operator<Monomial>& basis)
+            template <typename Basis>
+            uint64_t number_of_interaction_elements_no(const Basis& basis)
             {
                 return (basis.N * 2) + ((basis.size() - basis.N) * 8);
             }
 
-            template <typename Liouvillian, typename Matrix, typename Monomial, typename Lattice>
-            void init_kinetic_matrix_no(const Liouvillian& liouvillian, Matrix& matrix,
-                                        const Basis1Operator<Monomial>& basis,
-                                        const Lattice& lattice)
+            namespace detail
             {
-                using Scalar = typename types::ScalarType<Matrix>::Type;
-                using Index  = typename types::IndexType<Matrix>::Type;
-
-                static_assert(hubbard::IsHubbardOperator<typename Monomial::Operator>::value,
-                              "Operator-type in Monomial-type must be a Hubbard like operator!");
-
-                matrix.resize(basis.size(), basis.size(), false);
-                matrix.reset();
-                matrix.reserve(number_of_kinetic_elements_no<Monomial, Lattice>(basis));
-
-                types::TripletList<Scalar, Index> triplets;
-                for(Index row = 0; row < basis.N; ++row) {
+                template <typename Liouvillian, typename Monomial, typename Lattice,
+                          typename Scalar, typename Index>
+                void kinetic_matrix_row_no(const Liouvillian& liouvillian,
+                                           const Basis1Operator<Monomial>& basis,
+                                           const Lattice& lattice, Index row,
+                                           types::TripletList<Scalar, Index>& triplets)
+                {
+                    static_cast<void>(basis);
                     triplets.clear();
 
                     const auto neighbors = lattice.neighbors(row);
@@ -57,56 +56,31 @@ namespace ieompp
                         triplets.emplace_back(row, neighbor, -liouvillian.J);
                     }
                     triplets.sort();
-
-                    for(const auto triplet : triplets) {
-                        matrix.append(row, triplet.column, triplet.value);
-                    }
-                    matrix.finalize(row);
                 }
-            }
 
-            template <typename Liouvillian, typename Matrix, typename Monomial, typename Lattice,
-                      typename ExpectationValueFunction>
-            void init_matrix_no(const Liouvillian& liouvillian, Matrix& matrix,
-                                const Basis3Operator<Monomial>& basis, const Lattice& lattice,
-                                const ExpectationValueFunction& expectation_value)
-            {
-                using Scalar = typename types::ScalarType<Matrix>::Type;
-                using Index  = typename types::IndexType<Matrix>::Type;
-
-                static_assert(hubbard::IsHubbardOperator<typename Monomial::Operator>::value,
-                              "Operator-type in Monomial-type must be a Hubbard like operator!");
-
-                matrix.resize(basis.size(), basis.size(), false);
-                matrix.reset();
-                matrix.reserve(number_of_kinetic_elements_no<Monomial, Lattice>(basis)
-                               + number_of_interaction_elements_no(basis));
-
-                types::TripletList<Scalar, Index> triplets;
-                for(Index row = 0; row < basis.N; ++row) {
+                template <typename Liouvillian, typename Basis, typename Lattice,
+                          typename ExpectationValueFunction, typename Scalar, typename Index>
+                void matrix_row_no(const Liouvillian& liouvillian, const Basis& basis,
+                                   const Lattice& lattice,
+                                   const ExpectationValueFunction& expectation_value, Index row,
+                                   types::TripletList<Scalar, Index>& triplets)
+                {
                     triplets.clear();
 
-                    auto neighbors = lattice.neighbors(row);
-                    for(auto neighbor : neighbors) {
-                        triplets.emplace_back(row, neighbor, -liouvillian.J);
-                    }
+                    if(row < basis.N) {
+                        auto neighbors = lattice.neighbors(row);
+                        for(auto neighbor : neighbors) {
+                            triplets.emplace_back(row, neighbor, -liouvillian.J);
+                        }
 
-                    // clang-format off
-                    triplets.emplace_back(row, row, liouvillian.U);
-                    triplets.emplace_back(row, basis.get_3op_index(row, row, row), liouvillian.U * expectation_value(basis[row].front().index1, basis[row].front().index1));
-                    // clang-format on
+                        // clang-format off
+                        triplets.emplace_back(row, row, liouvillian.U);
+                        triplets.emplace_back(row, basis.get_3op_index(row, row, row), liouvillian.U * expectation_value(basis[row].front().index1, basis[row].front().index1));
+                        // clang-format on
 
-                    triplets.sort();
-                    for(const auto triplet : triplets) {
-                        matrix.append(row, triplet.column, triplet.value);
+                        triplets.sort();
+                        return;
                     }
-                    matrix.finalize(row);
-                }
-
-                triplets.clear();
-                triplets.reserve((Lattice::coordination_number * 3) + 8);
-                for(Index row = basis.N; row < basis.size(); ++row) {
-                    triplets.clear();
 
                     const auto& monomial = basis[row];
                     const auto& op1      = monomial[0];
@@ -159,7 +133,61 @@ namespace ieompp
 
                     // triplet list may contain triplets for the same column
                     triplets.sort();
-                    triplets = triplets.make_columns_unique();
+                    triplets.merge_columns();
+                }
+            } // namespace detail
+
+            template <typename Liouvillian, typename Matrix, typename Monomial, typename Lattice>
+            void init_kinetic_matrix_no(const Liouvillian& liouvillian, Matrix& matrix,
+                                        const Basis1Operator<Monomial>& basis,
+                                        const Lattice& lattice)
+            {
+                using Scalar = typename types::ScalarType<Matrix>::Type;
+                using Index  = typename types::IndexType<Matrix>::Type;
+
+                static_assert(hubbard::IsHubbardOperator<typename Monomial::Operator>::value,
+                              "Operator-type in Monomial-type must be a Hubbard like operator!");
+
+                matrix.resize(basis.size(), basis.size(), false);
+                matrix.reset();
+                matrix.reserve(number_of_kinetic_elements_no<Monomial, Lattice>(basis));
+
+                types::TripletList<Scalar, Index> triplets;
+                for(Index row = 0; row < basis.N; ++row) {
+                    detail::kinetic_matrix_row_no(liouvillian, basis, lattice, row, triplets);
+
+                    for(const auto triplet : triplets) {
+                        matrix.append(row, triplet.column, triplet.value);
+                    }
+                    matrix.finalize(row);
+                }
+            }
+
+            template <typename Liouvillian, typename Matrix, typename Basis, typename Lattice,
+                      typename ExpectationValueFunction>
+            void init_matrix_no(const Liouvillian& liouvillian, Matrix& matrix, const Basis& basis,
+                                const Lattice& lattice,
+                                const ExpectationValueFunction& expectation_value)
+            {
+                using Scalar = typename types::ScalarType<Matrix>::Type;
+                using Index  = typename types::IndexType<Matrix>::Type;
+
+                static_assert(IsThreeOperatorBasis<Basis>::value,
+                              "Basis must be a three operator basis");
+                static_assert(
+                    hubbard::IsHubbardOperator<typename Basis::Monomial::Operator>::value,
+                    "Operator-type in Monomial-type must be a Hubbard like operator!");
+
+                matrix.resize(basis.size(), basis.size(), false);
+                matrix.reset();
+                matrix.reserve(number_of_kinetic_elements_no<Basis, Lattice>(basis)
+                               + number_of_interaction_elements_no(basis));
+
+                types::TripletList<Scalar, Index> triplets;
+                triplets.reserve((Lattice::coordination_number * 3) + 8);
+                for(Index row = 0; row < basis.size(); ++row) {
+                    detail::matrix_row_no(liouvillian, basis, lattice, expectation_value, row,
+                                          triplets);
 
                     for(const auto triplet : triplets) {
                         matrix.append(row, triplet.column, triplet.value);
@@ -167,6 +195,85 @@ namespace ieompp
                     matrix.finalize(row);
                 }
             }
+
+            // same result as init_kinetic_matrix_no, the rows are computed by all threads and
+            // handed to matrix by types::assign_rows
+            template <typename Liouvillian, typename Matrix, typename Monomial, typename Lattice>
+            void init_kinetic_matrix_no_parallel(const Liouvillian& liouvillian, Matrix& matrix,
+                                                 const Basis1Operator<Monomial>& basis,
+                                                 const Lattice& lattice)
+            {
+                using Scalar = typename types::ScalarType<Matrix>::Type;
+                using Index  = typename types::IndexType<Matrix>::Type;
+
+                static_assert(hubbard::IsHubbardOperator<typename Monomial::Operator>::value,
+                              "Operator-type in Monomial-type must be a Hubbard like operator!");
+
+                auto rows = types::assemble_rows_parallel<Scalar, Index>(
+                    basis.size(),
+                    [&](Index row, types::TripletList<Scalar, Index>& triplets) {
+                        detail::kinetic_matrix_row_no(liouvillian, basis, lattice, row, triplets);
+                    },
+                    Lattice::coordination_number);
+
+                types::assign_rows(matrix, basis.size(), std::move(rows));
+            }
+
+            // same result as init_matrix_no, the rows are computed by all threads and handed to
+            // matrix by types::assign_rows
+            template <typename Liouvillian, typename Matrix, typename Basis, typename Lattice,
+                      typename ExpectationValueFunction>
+            void init_matrix_no_parallel(const Liouvillian& liouvillian, Matrix& matrix,
+                                         const Basis& basis, const Lattice& lattice,
+                                         const ExpectationValueFunction& expectation_value)
+            {
+                using Scalar = typename types::ScalarType<Matrix>::Type;
+                using Index  = typename types::IndexType<Matrix>::Type;
+
+                static_assert(IsThreeOperatorBasis<Basis>::value,
+                              "Basis must be a three operator basis");
+                static_assert(
+                    hubbard::IsHubbardOperator<typename Basis::Monomial::Operator>::value,
+                    "Operator-type in Monomial-type must be a Hubbard like operator!");
+
+                auto rows = types::assemble_rows_parallel<Scalar, Index>(
+                    basis.size(),
+                    [&](Index row, types::TripletList<Scalar, Index>& triplets) {
+                        detail::matrix_row_no(liouvillian, basis, lattice, expectation_value, row,
+                                              triplets);
+                    },
+                    (Lattice::coordination_number * 3) + 8);
+
+                types::assign_rows(matrix, basis.size(), std::move(rows));
+            }
+
+            // assemble the kinetic and the interaction part of the matrix built by init_matrix_no
+            // on their merged pattern, combine them with init_combined_matrix and
+            // update_combined_matrix
+            template <typename Float, typename Basis, typename Lattice,
+                      typename ExpectationValueFunction>
+            SplitMatrix<Float, typename Basis::BasisIndex>
+            init_split_matrix_no(const Basis& basis, const Lattice& lattice,
+                                 const ExpectationValueFunction& expectation_value)
+            {
+                using Index   = typename Basis::BasisIndex;
+                using Carrier = std::complex<Float>;
+
+                static_assert(IsThreeOperatorBasis<Basis>::value,
+                              "Basis must be a three operator basis");
+                static_assert(
+                    hubbard::IsHubbardOperator<typename Basis::Monomial::Operator>::value,
+                    "Operator-type in Monomial-type must be a Hubbard like operator!");
+
+                const auto liouvillian = make_liouvillian(Carrier(1., 0.), Carrier(0., 1.));
+                return detail::make_split_matrix(types::assemble_rows_parallel<Carrier, Index>(
+                    basis.size(),
+                    [&](Index row, types::TripletList<Carrier, Index>& triplets) {
+                        detail::matrix_row_no(liouvillian, basis, lattice, expectation_value, row,
+                                              triplets);
+                    },
+                    (Lattice::coordination_number * 3) + 8));
+            }
         } // namespace hubbard_real_space
     }     // namespace models
 } // namespace ieompp
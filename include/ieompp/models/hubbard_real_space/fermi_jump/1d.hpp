@@ -1,13 +1,21 @@
 #ifndef IEOMPP_MODELS_HUBBARD_REAL_SPACE_FERMI_JUMP_1D_HPP_
 #define IEOMPP_MODELS_HUBBARD_REAL_SPACE_FERMI_JUMP_1D_HPP_
 
+#include "ieompp/exception.hpp"
 #include "ieompp/models/hubbard_real_space/basis.hpp"
+#include "ieompp/models/hubbard_real_space/fermi_jump/adaptive.hpp"
+#include "ieompp/models/hubbard_real_space/fermi_jump/symmetric.hpp"
+#include "ieompp/models/hubbard_real_space/fermi_jump/truncated.hpp"
+#include "ieompp/models/hubbard_real_space/translation_basis.hpp"
 #include "ieompp/openmp.hpp"
 #include "ieompp/types/number.hpp"
 
 #include <cmath>
+#include <complex>
 #include <functional>
 #include <numeric>
+#include <string>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
@@ -17,7 +25,23 @@ namespace ieompp
     {
         namespace hubbard_real_space
         {
-            template <typename Float, typename Basis>
+            namespace detail
+            {
+                // calculate e^{i k_F * r_i}
+                template <typename Float, typename Lattice>
+                std::vector<std::complex<Float>> fourier_coefficients_1d(const Lattice& lattice,
+                                                                         const Float& k_F)
+                {
+                    std::vector<std::complex<Float>> coefficients(lattice.size());
+                    for(auto i : lattice) {
+                        const auto prod = k_F * lattice[i];
+                        coefficients[i] = std::complex<Float>(std::cos(prod), std::sin(prod));
+                    }
+                    return coefficients;
+                }
+            } // namespace detail
+
+            template <typename Float, typename Basis, typename Enable = void>
             class FermiJump1D
             {
             };
@@ -80,13 +104,14 @@ namespace ieompp
                 }
             };
 
-            template <typename FloatT, typename MonomialT>
-            class FermiJump1D<FloatT, Basis3Operator<MonomialT>>
+            template <typename FloatT, typename BasisT>
+            class FermiJump1D<
+                FloatT, BasisT, typename std::enable_if<IsThreeOperatorBasis<BasisT>::value>::type>
             {
             public:
                 using Float    = FloatT;
-                using Monomial = MonomialT;
-                using Basis    = Basis3Operator<Monomial>;
+                using Basis    = BasisT;
+                using Monomial = typename Basis::Monomial;
                 using Operator = typename Monomial::Operator;
                 using ExpectationValueFunction =
                     std::function<Float(const Operator&, const Operator&)>;
@@ -153,6 +178,122 @@ namespace ieompp
                     return std::norm(std::accumulate(results.begin(), results.end(), Complex(0.)));
                 }
             };
+
+            // <Δn_{k_F,↑}> from the momentum sector k_F alone: the Fourier transform of h^NO in
+            // the three operator specialization is Σ_r w_r ĥ_{k_F}(r) with the weights w_0 = 1 and
+            // w_{(d2,d3)} = 2 <c_{d2,↓}^† c_{d3,↓}> - δ_{d2,d3} of the representatives, provided
+            // the expectation value function is translation invariant.
+            template <typename FloatT, typename OperatorT>
+            class FermiJump1D<FloatT, TranslationBasis3Operator<OperatorT>>
+            {
+            public:
+                using Float    = FloatT;
+                using Basis    = TranslationBasis3Operator<OperatorT>;
+                using Monomial = typename Basis::Monomial;
+                using Operator = typename Monomial::Operator;
+                using ExpectationValueFunction =
+                    std::function<Float(const Operator&, const Operator&)>;
+                using Complex = std::complex<Float>;
+                using Index   = typename Basis::BasisIndex;
+
+            private:
+                std::vector<Float> _weights;
+
+            public:
+                template <typename Lattice>
+                FermiJump1D(const Basis& basis, const Lattice& lattice,
+                            const ExpectationValueFunction& ev, const Float& k_F)
+                    : _weights(basis.size(), 1.)
+                {
+                    if(translation_momentum_index(lattice, k_F) != basis.momentum_index) {
+                        THROW(Exception, "Basis does not contain the momentum sector k_F="
+                                             + std::to_string(k_F));
+                    }
+
+                    const auto& real_space_basis = basis.real_space_basis;
+#pragma omp parallel for
+                    for(Index d2 = 0; d2 < basis.N; ++d2) {
+                        for(Index d3 = 0; d3 < basis.N; ++d3) {
+                            // calculate 2*<c_{d2,↓}^† c_{d3,↓}> - δ_{d2,d3}
+                            auto weight =
+                                2 * ev(real_space_basis[d2].front(), real_space_basis[d3].front());
+                            if(d2 == d3) {
+                                weight -= 1.;
+                            }
+                            _weights[basis.get_3op_index(d2, d3)] = weight;
+                        }
+                    }
+                }
+
+                const std::vector<Float>& weights() const { return _weights; }
+
+                template <typename Vector>
+                Float operator()(const Vector& h) const
+                {
+                    const Index size = _weights.size();
+                    std::vector<Complex> results(omp_get_max_threads(), 0.);
+#pragma omp parallel for
+                    for(Index i = 0; i < size; ++i) {
+                        results[omp_get_thread_num()] += _weights[i] * h[i];
+                    }
+
+                    return std::norm(std::accumulate(results.begin(), results.end(), Complex(0.)));
+                }
+            };
+
+            template <typename FloatT, typename OperatorT>
+            class FermiJump1D<FloatT, SymmetricBasis3Operator<OperatorT>>
+                : public detail::SymmetricFermiJump<FloatT, OperatorT>
+            {
+            public:
+                using Base = detail::SymmetricFermiJump<FloatT, OperatorT>;
+                using typename Base::Float;
+                using typename Base::Basis;
+                using typename Base::ExpectationValueFunction;
+
+                template <typename Lattice>
+                FermiJump1D(const Basis& basis, const Lattice& lattice,
+                            const ExpectationValueFunction& ev, const Float& k_F)
+                    : Base(basis, ev, detail::fourier_coefficients_1d(lattice, k_F))
+                {
+                }
+            };
+
+            template <typename FloatT, typename OperatorT>
+            class FermiJump1D<FloatT, TruncatedBasis3Operator<OperatorT>>
+                : public detail::TruncatedFermiJump<FloatT, OperatorT>
+            {
+            public:
+                using Base = detail::TruncatedFermiJump<FloatT, OperatorT>;
+                using typename Base::Float;
+                using typename Base::Basis;
+                using typename Base::ExpectationValueFunction;
+
+                template <typename Lattice>
+                FermiJump1D(const Basis& basis, const Lattice& lattice,
+                            const ExpectationValueFunction& ev, const Float& k_F)
+                    : Base(basis, ev, detail::fourier_coefficients_1d(lattice, k_F))
+                {
+                }
+            };
+
+            template <typename FloatT, typename OperatorT>
+            class FermiJump1D<FloatT, AdaptiveBasis3Operator<OperatorT>>
+                : public detail::AdaptiveFermiJump<FloatT, OperatorT>
+            {
+            public:
+                using Base = detail::AdaptiveFermiJump<FloatT, OperatorT>;
+                using typename Base::Float;
+                using typename Base::Basis;
+                using typename Base::ExpectationValueFunction;
+
+                template <typename Lattice>
+                FermiJump1D(const Basis& basis, const Lattice& lattice,
+                            const ExpectationValueFunction& ev, const Float& k_F)
+                    : Base(basis, ev, detail::fourier_coefficients_1d(lattice, k_F))
+                {
+                }
+            };
         } // namespace hubbard_real_space
     }     // namespace models
 } // namespace ieompp
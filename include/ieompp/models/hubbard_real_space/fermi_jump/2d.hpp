@@ -2,12 +2,18 @@
 #define IEOMPP_MODELS_HUBBARD_REAL_SPACE_FERMI_JUMP_2D_HPP_
 
 #include "ieompp/models/hubbard_real_space/basis.hpp"
+#include "ieompp/models/hubbard_real_space/fermi_jump/adaptive.hpp"
+#include "ieompp/models/hubbard_real_space/fermi_jump/symmetric.hpp"
+#include "ieompp/models/hubbard_real_space/fermi_jump/truncated.hpp"
 #include "ieompp/openmp.hpp"
 #include "ieompp/types/dot_product.hpp"
 #include "ieompp/types/number.hpp"
 
 #include <cmath>
+#include <complex>
 #include <functional>
+#include <type_traits>
+#include <vector>
 
 namespace ieompp
 {
@@ -15,18 +21,35 @@ namespace ieompp
     {
         namespace hubbard_real_space
         {
-            template <typename Float, typename Basis>
+            namespace detail
+            {
+                // calculate e^{i k_F * r_i}
+                template <typename Float, typename Lattice>
+                std::vector<std::complex<Float>>
+                fourier_coefficients_2d(const Lattice& lattice, const typename Lattice::Vector& k_F)
+                {
+                    std::vector<std::complex<Float>> coefficients(lattice.size());
+                    for(auto i : lattice) {
+                        const auto prod = types::dot_product(k_F, lattice[i]);
+                        coefficients[i] = std::complex<Float>(std::cos(prod), std::sin(prod));
+                    }
+                    return coefficients;
+                }
+            }
+
+            template <typename Float, typename Basis, typename Enable = void>
             class FermiJump2D
             {
             };
 
-            template <typename FloatT, typename MonomialT>
-            class FermiJump2D<FloatT, Basis3Operator<MonomialT>>
+            template <typename FloatT, typename BasisT>
+            class FermiJump2D<
+                FloatT, BasisT, typename std::enable_if<IsThreeOperatorBasis<BasisT>::value>::type>
             {
             public:
                 using Float    = FloatT;
-                using Monomial = MonomialT;
-                using Basis    = Basis3Operator<Monomial>;
+                using Basis    = BasisT;
+                using Monomial = typename Basis::Monomial;
                 using Operator = typename Monomial::Operator;
                 using ExpectationValueFunction =
                     std::function<Float(const Operator&, const Operator&)>;
@@ -93,6 +116,60 @@ namespace ieompp
                     return std::norm(std::accumulate(results.begin(), results.end(), Complex(0.)));
                 }
             };
+
+            template <typename FloatT, typename OperatorT>
+            class FermiJump2D<FloatT, SymmetricBasis3Operator<OperatorT>>
+                : public detail::SymmetricFermiJump<FloatT, OperatorT>
+            {
+            public:
+                using Base = detail::SymmetricFermiJump<FloatT, OperatorT>;
+                using typename Base::Float;
+                using typename Base::Basis;
+                using typename Base::ExpectationValueFunction;
+
+                template <typename Lattice>
+                FermiJump2D(const Basis& basis, const Lattice& lattice,
+                            const ExpectationValueFunction& ev, const typename Lattice::Vector& k_F)
+                    : Base(basis, ev, detail::fourier_coefficients_2d<Float>(lattice, k_F))
+                {
+                }
+            };
+
+            template <typename FloatT, typename OperatorT>
+            class FermiJump2D<FloatT, TruncatedBasis3Operator<OperatorT>>
+                : public detail::TruncatedFermiJump<FloatT, OperatorT>
+            {
+            public:
+                using Base = detail::TruncatedFermiJump<FloatT, OperatorT>;
+                using typename Base::Float;
+                using typename Base::Basis;
+                using typename Base::ExpectationValueFunction;
+
+                template <typename Lattice>
+                FermiJump2D(const Basis& basis, const Lattice& lattice,
+                            const ExpectationValueFunction& ev, const typename Lattice::Vector& k_F)
+                    : Base(basis, ev, detail::fourier_coefficients_2d<Float>(lattice, k_F))
+                {
+                }
+            };
+
+            template <typename FloatT, typename OperatorT>
+            class FermiJump2D<FloatT, AdaptiveBasis3Operator<OperatorT>>
+                : public detail::AdaptiveFermiJump<FloatT, OperatorT>
+            {
+            public:
+                using Base = detail::AdaptiveFermiJump<FloatT, OperatorT>;
+                using typename Base::Float;
+                using typename Base::Basis;
+                using typename Base::ExpectationValueFunction;
+
+                template <typename Lattice>
+                FermiJump2D(const Basis& basis, const Lattice& lattice,
+                            const ExpectationValueFunction& ev, const typename Lattice::Vector& k_F)
+                    : Base(basis, ev, detail::fourier_coefficients_2d<Float>(lattice, k_F))
+                {
+                }
+            };
         }
     }
 }
@@ -0,0 +1,103 @@
+#ifndef IEOMPP_MODELS_HUBBARD_REAL_SPACE_FERMI_JUMP_ADAPTIVE_HPP_
+#define IEOMPP_MODELS_HUBBARD_REAL_SPACE_FERMI_JUMP_ADAPTIVE_HPP_
+
+#include "ieompp/models/hubbard_real_space/adaptive_basis.hpp"
+#include "ieompp/openmp.hpp"
+
+#include <complex>
+#include <functional>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+namespace ieompp
+{
+    namespace models
+    {
+        namespace hubbard_real_space
+        {
+            namespace detail
+            {
+                // <Δn_{k_F,↑}> for the coefficients of an adaptive basis. Since h^NO_i is linear in
+                // h the result is Σ_i e^{i k_F r_i} h_i + Σ_k e^{i k_F r_{i1(k)}} w_k h_k with the
+                // weights w_k = 2 <c_{i2,↓}^† c_{i3,↓}> - δ_{i2,i3} of the three operator elements.
+                // The basis may grow between two evaluations, the weights of the new elements are
+                // computed on the next evaluation.
+                template <typename FloatT, typename OperatorT>
+                class AdaptiveFermiJump
+                {
+                public:
+                    using Float    = FloatT;
+                    using Basis    = AdaptiveBasis3Operator<OperatorT>;
+                    using Monomial = typename Basis::Monomial;
+                    using Operator = typename Monomial::Operator;
+                    using ExpectationValueFunction =
+                        std::function<Float(const Operator&, const Operator&)>;
+                    using Complex = std::complex<Float>;
+                    using Index   = typename Basis::BasisIndex;
+
+                private:
+                    const std::reference_wrapper<const Basis> _basis_ref;
+                    const ExpectationValueFunction _ev;
+                    std::vector<Complex> _fourier_coefficients;
+                    mutable std::vector<Float> _weights;
+
+                    void update_weights() const
+                    {
+                        const auto& basis = _basis_ref.get();
+                        const Index first = basis.N + _weights.size();
+                        const Index size  = basis.size();
+                        _weights.resize(size - basis.N);
+#pragma omp parallel for
+                        for(Index i = first; i < size; ++i) {
+                            const auto monomial = basis[i];
+
+                            // calculate 2*<c_{j,↓}^† c_{k,↓}> - δ_{j,k}
+                            auto weight = 2 * _ev(monomial[1], monomial[2]);
+                            if(monomial[1].index1 == monomial[2].index1) {
+                                weight -= 1.;
+                            }
+                            _weights[i - basis.N] = weight;
+                        }
+                    }
+
+                public:
+                    AdaptiveFermiJump(const Basis& basis, const ExpectationValueFunction& ev,
+                                      std::vector<Complex> fourier_coefficients)
+                        : _basis_ref(basis), _ev(ev),
+                          _fourier_coefficients(std::move(fourier_coefficients))
+                    {
+                    }
+
+                    auto& fourier_coefficients() const { return _fourier_coefficients; }
+
+                    template <typename Vector>
+                    Float operator()(const Vector& h) const
+                    {
+                        const auto& basis = _basis_ref.get();
+                        update_weights();
+
+                        std::vector<Complex> results(omp_get_max_threads(), 0.);
+                        const Index size = basis.size();
+#pragma omp parallel for
+                        for(Index i = 0; i < size; ++i) {
+                            if(i < basis.N) {
+                                results[omp_get_thread_num()] += _fourier_coefficients[i] * h[i];
+                            } else {
+                                const auto site = (basis.real_space_index(i) - basis.N)
+                                                  / basis.real_space_basis.N_squared;
+                                results[omp_get_thread_num()] +=
+                                    _fourier_coefficients[site] * _weights[i - basis.N] * h[i];
+                            }
+                        }
+
+                        return std::norm(
+                            std::accumulate(results.begin(), results.end(), Complex(0.)));
+                    }
+                };
+            } // namespace detail
+        }     // namespace hubbard_real_space
+    }         // namespace models
+} // namespace ieompp
+
+#endif
@@ -0,0 +1,95 @@
+#ifndef IEOMPP_MODELS_HUBBARD_REAL_SPACE_FERMI_JUMP_SYMMETRIC_HPP_
+#define IEOMPP_MODELS_HUBBARD_REAL_SPACE_FERMI_JUMP_SYMMETRIC_HPP_
+
+#include "ieompp/models/hubbard_real_space/symmetric_basis.hpp"
+#include "ieompp/openmp.hpp"
+
+#include <complex>
+#include <functional>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+namespace ieompp
+{
+    namespace models
+    {
+        namespace hubbard_real_space
+        {
+            namespace detail
+            {
+                // <Δn_{k_F,↑}> for the coefficients of a symmetric sector, the real-space
+                // coefficients are looked up in their orbits while h^NO is accumulated, which is
+                // exact for any k_F. FermiJump1D and FermiJump2D only differ in the Fourier
+                // coefficients e^{i k_F r_i}.
+                template <typename FloatT, typename OperatorT>
+                class SymmetricFermiJump
+                {
+                public:
+                    using Float    = FloatT;
+                    using Basis    = SymmetricBasis3Operator<OperatorT>;
+                    using Monomial = typename Basis::Monomial;
+                    using Operator = typename Monomial::Operator;
+                    using ExpectationValueFunction =
+                        std::function<Float(const Operator&, const Operator&)>;
+                    using Complex = std::complex<Float>;
+                    using Index   = typename Basis::BasisIndex;
+
+                private:
+                    const std::reference_wrapper<const Basis> _basis_ref;
+                    std::vector<Complex> _fourier_coefficients;
+                    std::vector<Float> _weights;
+
+                public:
+                    SymmetricFermiJump(const Basis& basis, const ExpectationValueFunction& ev,
+                                       std::vector<Complex> fourier_coefficients)
+                        : _basis_ref(basis), _fourier_coefficients(std::move(fourier_coefficients)),
+                          _weights(basis.N * basis.N)
+                    {
+                        const auto& real_space_basis = basis.real_space_basis;
+#pragma omp parallel for
+                        for(Index j = 0; j < basis.N; ++j) {
+                            for(Index k = 0; k < basis.N; ++k) {
+                                // calculate 2*<c_{j,↓}^† c_{k,↓}> - δ_{j,k}
+                                auto weight = 2 * ev(real_space_basis[j].front(),
+                                                     real_space_basis[k].front());
+                                if(j == k) {
+                                    weight -= 1.;
+                                }
+                                _weights[basis.N * j + k] = weight;
+                            }
+                        }
+                    }
+
+                    auto& fourier_coefficients() const { return _fourier_coefficients; }
+
+                    template <typename Vector>
+                    Float operator()(const Vector& h) const
+                    {
+                        const auto& basis            = _basis_ref.get();
+                        const auto& real_space_basis = basis.real_space_basis;
+
+                        std::vector<Complex> results(omp_get_max_threads(), 0.);
+#pragma omp parallel for
+                        for(Index i = 0; i < basis.N; ++i) {
+                            Complex h_NO = basis.real_space_coefficient(h, i);
+                            for(Index j = 0; j < basis.N; ++j) {
+                                for(Index k = 0; k < basis.N; ++k) {
+                                    h_NO += _weights[basis.N * j + k]
+                                            * basis.real_space_coefficient(
+                                                  h, real_space_basis.get_3op_index(i, j, k));
+                                }
+                            }
+                            results[omp_get_thread_num()] += _fourier_coefficients[i] * h_NO;
+                        }
+
+                        return std::norm(
+                            std::accumulate(results.begin(), results.end(), Complex(0.)));
+                    }
+                };
+            } // namespace detail
+        }     // namespace hubbard_real_space
+    }         // namespace models
+} // namespace ieompp
+
+#endif
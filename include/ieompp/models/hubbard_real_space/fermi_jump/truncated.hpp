@@ -0,0 +1,91 @@
+#ifndef IEOMPP_MODELS_HUBBARD_REAL_SPACE_FERMI_JUMP_TRUNCATED_HPP_
+#define IEOMPP_MODELS_HUBBARD_REAL_SPACE_FERMI_JUMP_TRUNCATED_HPP_
+
+#include "ieompp/models/hubbard_real_space/truncated_basis.hpp"
+#include "ieompp/openmp.hpp"
+
+#include <complex>
+#include <functional>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+namespace ieompp
+{
+    namespace models
+    {
+        namespace hubbard_real_space
+        {
+            namespace detail
+            {
+                // <Δn_{k_F,↑}> for the coefficients of a truncated basis, h^NO only collects the
+                // three operator elements of the basis. The weights 2 <c_{j,↓}^† c_{k,↓}> - δ_{j,k}
+                // are stored per element, so the memory scales with the basis instead of N^2.
+                // FermiJump1D and FermiJump2D only differ in the Fourier coefficients
+                // e^{i k_F r_i}.
+                template <typename FloatT, typename OperatorT>
+                class TruncatedFermiJump
+                {
+                public:
+                    using Float    = FloatT;
+                    using Basis    = TruncatedBasis3Operator<OperatorT>;
+                    using Monomial = typename Basis::Monomial;
+                    using Operator = typename Monomial::Operator;
+                    using ExpectationValueFunction =
+                        std::function<Float(const Operator&, const Operator&)>;
+                    using Complex = std::complex<Float>;
+                    using Index   = typename Basis::BasisIndex;
+
+                private:
+                    const std::reference_wrapper<const Basis> _basis_ref;
+                    std::vector<Complex> _fourier_coefficients;
+                    std::vector<Float> _weights;
+
+                public:
+                    TruncatedFermiJump(const Basis& basis, const ExpectationValueFunction& ev,
+                                       std::vector<Complex> fourier_coefficients)
+                        : _basis_ref(basis), _fourier_coefficients(std::move(fourier_coefficients)),
+                          _weights(basis.size() - basis.N)
+                    {
+                        const Index size = basis.size();
+#pragma omp parallel for
+                        for(Index i = basis.N; i < size; ++i) {
+                            const auto monomial = basis[i];
+
+                            // calculate 2*<c_{j,↓}^† c_{k,↓}> - δ_{j,k}
+                            auto weight = 2 * ev(monomial[1], monomial[2]);
+                            if(monomial[1].index1 == monomial[2].index1) {
+                                weight -= 1.;
+                            }
+                            _weights[i - basis.N] = weight;
+                        }
+                    }
+
+                    auto& fourier_coefficients() const { return _fourier_coefficients; }
+
+                    template <typename Vector>
+                    Float operator()(const Vector& h) const
+                    {
+                        const auto& basis = _basis_ref.get();
+
+                        std::vector<Complex> results(omp_get_max_threads(), 0.);
+#pragma omp parallel for
+                        for(Index i = 0; i < basis.N; ++i) {
+                            Complex h_NO     = h[i];
+                            const auto range = basis.three_operator_range(i);
+                            for(Index k = range.first; k < range.second; ++k) {
+                                h_NO += _weights[k - basis.N] * h[k];
+                            }
+                            results[omp_get_thread_num()] += _fourier_coefficients[i] * h_NO;
+                        }
+
+                        return std::norm(
+                            std::accumulate(results.begin(), results.end(), Complex(0.)));
+                    }
+                };
+            } // namespace detail
+        }     // namespace hubbard_real_space
+    }         // namespace models
+} // namespace ieompp
+
+#endif
@@ -10,6 +10,7 @@
 #include <cmath>
 #include <functional>
 #include <numeric>
+#include <type_traits>
 #include <utility>
 #include <vector>
 
@@ -19,7 +20,7 @@ namespace ieompp
     {
         namespace hubbard_real_space
         {
-            template <typename Float, typename Basis>
+            template <typename Float, typename Basis, typename Enable = void>
             class FermiJump1D_NO
             {
             };
@@ -44,16 +45,15 @@ namespace ieompp
 
             public:
                 template <typename Lattice>
-                FermiJump1D_NO(const Lattice& lattice, ExpectationValueFunction expectation_value)
+                FermiJump1D_NO(const Lattice& lattice, ExpectationValueFunction expectation_value,
+                               const Float& fermi_momentum = HalfPi<Float>::value)
                     : _N(lattice.size()), _expectation_value(std::move(expectation_value))
                 {
-                    static const auto k_F = HalfPi<double>::value;
-
-                    _fourier_coefficients.reserve(_N);
+                    _fourier_coefficients.resize(_N);
 
 #pragma omp parallel for
                     for(Index i = 0; i < _N; ++i) {
-                        const auto prod          = k_F * lattice[i];
+                        const auto prod          = fermi_momentum * lattice[i];
                         _fourier_coefficients[i] = Complex(std::cos(prod), std::sin(prod));
                     }
                 }
@@ -82,14 +82,15 @@ namespace ieompp
                 }
             };
 
-            template <typename FloatT, typename MonomialT>
-            class FermiJump1D_NO<FloatT, Basis3Operator<MonomialT>>
+            template <typename FloatT, typename BasisT>
+            class FermiJump1D_NO<
+                FloatT, BasisT, typename std::enable_if<IsThreeOperatorBasis<BasisT>::value>::type>
             {
             public:
                 using Float    = FloatT;
-                using Monomial = MonomialT;
+                using Basis    = BasisT;
+                using Monomial = typename Basis::Monomial;
                 using Operator = typename Monomial::Operator;
-                using Basis    = Basis3Operator<Monomial>;
                 using Index    = typename Operator::Index1;
                 using Complex  = std::complex<Float>;
                 using ExpectationValueFunction =
@@ -102,16 +103,15 @@ namespace ieompp
 
             public:
                 template <typename Lattice>
-                FermiJump1D_NO(const Lattice& lattice, ExpectationValueFunction expectation_value)
+                FermiJump1D_NO(const Lattice& lattice, ExpectationValueFunction expectation_value,
+                               const Float& fermi_momentum = HalfPi<Float>::value)
                     : _N(lattice.size()), _expectation_value(std::move(expectation_value))
                 {
-                    static const auto k_F = HalfPi<double>::value;
-
-                    _fourier_coefficients.reserve(_N);
+                    _fourier_coefficients.resize(_N);
 
 #pragma omp parallel for
                     for(Index i = 0; i < _N; ++i) {
-                        const auto prod          = k_F * lattice[i];
+                        const auto prod          = fermi_momentum * lattice[i];
                         _fourier_coefficients[i] = Complex(std::cos(prod), std::sin(prod));
                     }
                 }
@@ -0,0 +1,146 @@
+#ifndef IEOMPP_MODELS_HUBBARD_REAL_SPACE_IMPLICIT_BASIS_HPP_
+#define IEOMPP_MODELS_HUBBARD_REAL_SPACE_IMPLICIT_BASIS_HPP_
+
+#include "ieompp/models/hubbard/operator_traits.hpp"
+#include "ieompp/models/hubbard_real_space/basis.hpp"
+
+#include <array>
+#include <cassert>
+#include <cstdint>
+
+namespace ieompp
+{
+    namespace models
+    {
+        namespace hubbard_real_space
+        {
+            // Monomial of a three operator basis that is described by its sites only, the operators
+            // are created on access: c_{i,↑}^† or c_{i1,↑}^† c_{i2,↓}^† c_{i3,↓}, and their
+            // conjugates for a conjugated monomial
+            template <typename OperatorT>
+            class ImplicitMonomial
+            {
+            public:
+                using Operator = OperatorT;
+                using Index    = typename Operator::Index1;
+
+            private:
+                std::array<Index, 3> _sites;
+                std::uint8_t _size;
+                bool _conjugated;
+
+                Operator get_operator(std::size_t position) const
+                {
+                    if(_size == 1) {
+                        return Operator{true, _sites[0], true};
+                    }
+                    return Operator{position < 2, _sites[position], position == 0};
+                }
+
+            public:
+                ImplicitMonomial(Index i, bool conjugated = false)
+                    : _sites{{i, 0, 0}}, _size(1), _conjugated(conjugated)
+                {
+                }
+
+                ImplicitMonomial(Index i1, Index i2, Index i3, bool conjugated = false)
+                    : _sites{{i1, i2, i3}}, _size(3), _conjugated(conjugated)
+                {
+                }
+
+                std::size_t size() const { return _size; }
+
+                Operator operator[](std::size_t position) const
+                {
+                    assert(position < _size);
+                    if(_conjugated) {
+                        return get_operator(_size - 1 - position).get_conjugate();
+                    }
+                    return get_operator(position);
+                }
+
+                Operator front() const { return (*this)[0]; }
+                Operator back() const { return (*this)[_size - 1]; }
+
+                void conjugate() { _conjugated = !_conjugated; }
+
+                ImplicitMonomial get_conjugate() const
+                {
+                    ImplicitMonomial conj(*this);
+                    conj.conjugate();
+                    return conj;
+                }
+
+                // materialize as a monomial type that can be built from a list of operators
+                template <typename Monomial>
+                Monomial to_monomial() const
+                {
+                    Monomial monomial;
+                    for(std::size_t i = 0; i < _size; ++i) {
+                        monomial.push_back((*this)[i]);
+                    }
+                    return monomial;
+                }
+            };
+
+            // Same basis as Basis3Operator, but the monomials are computed from their index on
+            // access instead of being stored: operator[] inverts get_3op_index arithmetically and
+            // returns an ImplicitMonomial by value. Construction and get_conjugate() only store N.
+            template <typename OperatorT>
+            struct ImplicitBasis3Operator {
+                using Operator   = OperatorT;
+                using Monomial   = ImplicitMonomial<Operator>;
+                using BasisIndex = std::size_t;
+
+                static_assert(hubbard::IsHubbardOperator<Operator>::value,
+                              "Operator must be of Hubbard type");
+
+                const BasisIndex N;
+                const BasisIndex N_squared;
+
+            private:
+                bool _conjugated;
+
+            public:
+                template <typename Lattice>
+                ImplicitBasis3Operator(const Lattice& lattice)
+                    : N(lattice.size()), N_squared(N * N), _conjugated(false)
+                {
+                }
+
+                BasisIndex size() const { return N * (N_squared + 1); }
+
+                Monomial operator[](BasisIndex index) const
+                {
+                    assert(index < size());
+                    if(index < N) {
+                        return Monomial(index, _conjugated);
+                    }
+                    index -= N;
+                    return Monomial(index / N_squared, (index / N) % N, index % N, _conjugated);
+                }
+
+                BasisIndex get_3op_index(BasisIndex i1, BasisIndex i2, BasisIndex i3) const
+                {
+                    return N + N_squared * i1 + N * i2 + i3;
+                }
+
+                bool is_conjugated() const { return _conjugated; }
+
+                ImplicitBasis3Operator get_conjugate() const
+                {
+                    ImplicitBasis3Operator conj_basis(*this);
+                    conj_basis._conjugated = !_conjugated;
+                    return conj_basis;
+                }
+            };
+
+            template <typename Operator>
+            struct IsThreeOperatorBasis<ImplicitBasis3Operator<Operator>> {
+                static constexpr bool value = true;
+            };
+        } // namespace hubbard_real_space
+    }     // namespace models
+} // namespace ieompp
+
+#endif
@@ -0,0 +1,164 @@
+#ifndef IEOMPP_MODELS_HUBBARD_REAL_SPACE_MATRIX_FREE_HPP_
+#define IEOMPP_MODELS_HUBBARD_REAL_SPACE_MATRIX_FREE_HPP_
+
+#include "ieompp/models/hubbard_real_space/basis.hpp"
+#include "ieompp/models/hubbard_real_space/liouvillian.hpp"
+#include "ieompp/types/function_matrix.hpp"
+#include "ieompp/types/matrix.hpp"
+#include "ieompp/types/multiply_assign.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace ieompp
+{
+    namespace models
+    {
+        namespace hubbard_real_space
+        {
+            // Applies the same operator as init_matrix(liouvillian, matrix, basis, lattice) scaled
+            // by prefactor without storing any matrix elements. The hopping stencil is evaluated
+            // along each of the three site indices directly from the (i1, i2, i3) structure of the
+            // basis, only a table of the lattice neighbors is kept.
+            template <typename ScalarT, typename BasisT>
+            class MatrixFreeLiouvillian
+            {
+                static_assert(IsThreeOperatorBasis<BasisT>::value,
+                              "MatrixFreeLiouvillian requires a three operator basis");
+
+            public:
+                using Scalar = ScalarT;
+                using Basis  = BasisT;
+                using Index  = typename Basis::BasisIndex;
+
+            private:
+                const Index _N, _N_squared, _size;
+                const Index _coordination_number;
+                std::vector<Index> _neighbors;
+                const Scalar _hopping, _interaction;
+
+                Index get_3op_index(Index i1, Index i2, Index i3) const
+                {
+                    return _N + _N_squared * i1 + _N * i2 + i3;
+                }
+
+            public:
+                template <typename Liouvillian, typename Lattice>
+                MatrixFreeLiouvillian(const Liouvillian& liouvillian, const Basis& basis,
+                                      const Lattice& lattice, const Scalar& prefactor = 1.)
+                    : _N(basis.N), _N_squared(basis.N * basis.N), _size(basis.size()),
+                      _coordination_number(Lattice::coordination_number),
+                      _neighbors(basis.N * Lattice::coordination_number),
+                      _hopping(-liouvillian.J * prefactor),
+                      _interaction(liouvillian.U / 2. * prefactor)
+                {
+                    for(Index site = 0; site < _N; ++site) {
+                        const auto neighbors = lattice.neighbors(site);
+                        std::copy(neighbors.begin(), neighbors.end(),
+                                  _neighbors.begin() + site * _coordination_number);
+                    }
+                }
+
+                Index rows() const { return _size; }
+                Index columns() const { return _size; }
+
+                template <typename Vector>
+                void multiply(const Vector& x, Vector& y) const
+                {
+                    assert(x.size() == _size);
+                    assert(y.size() == _size);
+
+                    // the vector may be complex while the Liouvillian itself is real
+                    using Value = typename types::ScalarType<Vector>::Type;
+
+                    const auto cn = _coordination_number;
+
+#pragma omp parallel for
+                    for(Index i = 0; i < _N; ++i) {
+                        const auto neighbors = _neighbors.data() + i * cn;
+
+                        Value sum = _interaction * (x[i] + x[get_3op_index(i, i, i)]);
+                        for(Index n = 0; n < cn; ++n) {
+                            sum += _hopping * x[neighbors[n]];
+                        }
+                        y[i] = sum;
+                    }
+
+#pragma omp parallel for
+                    for(Index i1 = 0; i1 < _N; ++i1) {
+                        const auto neighbors1 = _neighbors.data() + i1 * cn;
+                        for(Index i2 = 0; i2 < _N; ++i2) {
+                            const auto neighbors2 = _neighbors.data() + i2 * cn;
+                            for(Index i3 = 0; i3 < _N; ++i3) {
+                                const auto neighbors3 = _neighbors.data() + i3 * cn;
+                                const auto row        = get_3op_index(i1, i2, i3);
+
+                                Value sum = _interaction * x[row];
+                                if((i1 == i2) && (i1 == i3)) {
+                                    sum += _interaction * x[i1];
+                                }
+
+                                // hopping of c_{i1,↑}^† and c_{i2,↓}^† enters with -J, hopping of
+                                // c_{i3,↓} with +J
+                                Value hopping_sum = 0.;
+                                for(Index n = 0; n < cn; ++n) {
+                                    hopping_sum += x[get_3op_index(neighbors1[n], i2, i3)];
+                                    hopping_sum += x[get_3op_index(i1, neighbors2[n], i3)];
+                                    hopping_sum -= x[get_3op_index(i1, i2, neighbors3[n])];
+                                }
+                                y[row] = sum + _hopping * hopping_sum;
+                            }
+                        }
+                    }
+                }
+            };
+        } // namespace hubbard_real_space
+    }     // namespace models
+
+    namespace types
+    {
+        template <typename Scalar, typename Basis>
+        struct is_function_matrix<
+            models::hubbard_real_space::MatrixFreeLiouvillian<Scalar, Basis>> {
+            static constexpr bool value = true;
+        };
+
+        template <typename Scalar, typename Basis>
+        struct ScalarType<models::hubbard_real_space::MatrixFreeLiouvillian<Scalar, Basis>> {
+            using Type = Scalar;
+        };
+
+        template <typename Scalar, typename Basis>
+        struct IndexType<models::hubbard_real_space::MatrixFreeLiouvillian<Scalar, Basis>> {
+            using Type = typename Basis::BasisIndex;
+        };
+
+        template <typename Scalar, typename Basis>
+        struct MatrixDimensionInfo<
+            models::hubbard_real_space::MatrixFreeLiouvillian<Scalar, Basis>> {
+            using Matrix = models::hubbard_real_space::MatrixFreeLiouvillian<Scalar, Basis>;
+
+            static typename Basis::BasisIndex rows(const Matrix& m) { return m.rows(); }
+            static typename Basis::BasisIndex columns(const Matrix& m) { return m.columns(); }
+        };
+
+        template <typename Scalar, typename Basis>
+        struct MultiplyAssign<models::hubbard_real_space::MatrixFreeLiouvillian<Scalar, Basis>> {
+            template <typename Vector>
+            static void
+            apply(const models::hubbard_real_space::MatrixFreeLiouvillian<Scalar, Basis>& matrix,
+                  Vector& vector)
+            {
+                Vector temp(matrix.rows());
+                matrix.multiply(vector, temp);
+                using std::swap;
+                swap(vector, temp);
+            }
+        };
+    } // namespace types
+} // namespace ieompp
+
+#endif
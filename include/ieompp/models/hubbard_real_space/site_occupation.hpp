@@ -2,12 +2,18 @@
 #define IEOMPP_MODELS_HUBBARD_REAL_SPACE_SITE_OCCUPATION_HPP_
 
 #include "ieompp/models/hubbard_real_space/basis.hpp"
+#include "ieompp/models/hubbard_real_space/symmetric_basis.hpp"
+#include "ieompp/models/hubbard_real_space/translation_basis.hpp"
+#include "ieompp/models/hubbard_real_space/truncated_basis.hpp"
 #include "ieompp/openmp.hpp"
 #include "ieompp/types/matrix.hpp"
 #include "ieompp/types/number.hpp"
 
+#include <cmath>
+#include <complex>
 #include <functional>
 #include <numeric>
+#include <type_traits>
 #include <vector>
 
 namespace ieompp
@@ -16,22 +22,26 @@ namespace ieompp
     {
         namespace hubbard_real_space
         {
-            template <typename Float, typename Basis>
+            // the conjugate basis is either a copy returned by Basis::get_conjugate() or a
+            // hubbard::ConjugateBasis view of the basis
+            template <typename Float, typename Basis, typename ConjugateBasis = Basis,
+                      typename Enable = void>
             struct SiteOccupation {
             };
 
-            template <typename FloatT, typename MonomialT>
-            struct SiteOccupation<FloatT, Basis1Operator<MonomialT>> {
-                using Float    = FloatT;
-                using Monomial = MonomialT;
-                using Basis    = Basis1Operator<Monomial>;
-                using Operator = typename Monomial::Operator;
+            template <typename FloatT, typename MonomialT, typename ConjugateBasisT>
+            struct SiteOccupation<FloatT, Basis1Operator<MonomialT>, ConjugateBasisT> {
+                using Float          = FloatT;
+                using Monomial       = MonomialT;
+                using Basis          = Basis1Operator<Monomial>;
+                using ConjugateBasis = ConjugateBasisT;
+                using Operator       = typename Monomial::Operator;
                 using ExpectationValueFunction =
                     std::function<Float(const Operator&, const Operator&)>;
 
                 ExpectationValueFunction expectation_value_function;
                 std::reference_wrapper<const Basis1Operator<Monomial>> basis_ref;
-                std::reference_wrapper<const Basis1Operator<Monomial>> conjugate_basis_ref;
+                std::reference_wrapper<const ConjugateBasis> conjugate_basis_ref;
 
                 Float expectation_value(const Monomial& a, const Monomial& b) const
                 {
@@ -68,19 +78,38 @@ namespace ieompp
                 }
             };
 
-            template <typename FloatT, typename MonomialT>
-            struct SiteOccupation<FloatT, Basis3Operator<MonomialT>> {
-                using Float    = FloatT;
-                using Monomial = MonomialT;
-                using Basis    = Basis3Operator<Monomial>;
-                using Operator = typename Monomial::Operator;
+            template <typename FloatT, typename BasisT, typename ConjugateBasisT>
+            struct SiteOccupation<
+                FloatT, BasisT, ConjugateBasisT,
+                typename std::enable_if<IsThreeOperatorBasis<BasisT>::value>::type> {
+                using Float          = FloatT;
+                using Basis          = BasisT;
+                using ConjugateBasis = ConjugateBasisT;
+                using Monomial       = typename Basis::Monomial;
+                using Operator       = typename Monomial::Operator;
                 using ExpectationValueFunction =
                     std::function<Float(const Operator&, const Operator&)>;
 
                 ExpectationValueFunction expectation_value_function;
-                std::reference_wrapper<const Basis3Operator<Monomial>> basis_ref;
-                std::reference_wrapper<const Basis3Operator<Monomial>> conjugate_basis_ref;
+                std::reference_wrapper<const Basis> basis_ref;
+                std::reference_wrapper<const ConjugateBasis> conjugate_basis_ref;
                 bool exploit_inversion_symmetry = true;
+                // position of the coefficient of basis element i in the measured vector, empty if
+                // the vector is in the order of the basis
+                std::vector<std::size_t> positions;
+
+                // measure vectors whose entries are relabeled by permutation, e.g. the permuted
+                // vector propagated with a reordered matrix, without restoring them first
+                template <typename Permutation>
+                void permute(const Permutation& permutation)
+                {
+                    const auto size = basis_ref.get().size();
+                    assert(permutation.size() == size);
+                    positions.resize(size);
+                    for(std::size_t i = 0; i < size; ++i) {
+                        positions[i] = permutation.new_index(i);
+                    }
+                }
 
                 Float expectation_value_1_1(const Monomial& a, const Monomial& b) const
                 {
@@ -234,7 +263,7 @@ namespace ieompp
                     if(b.size() == 1) {
                         return expectation_value_3_1(a, b);
                     }
-                    return expectation_value_3_3();
+                    return expectation_value_3_3(a, b);
                 }
 
                 template <typename Vector>
@@ -246,6 +275,10 @@ namespace ieompp
                     const auto basis_size       = basis.size();
                     std::vector<std::complex<Float>> results(omp_get_max_threads(), 0.0);
 
+                    const auto at = [&](std::size_t i) {
+                        return positions.empty() ? vector[i] : vector[positions[i]];
+                    };
+
                     if(exploit_inversion_symmetry) {
 #pragma omp parallel for
                         for(auto i = 0ul; i < N; ++i) {
@@ -253,10 +286,10 @@ namespace ieompp
                             for(auto j = 0ul; j < i; ++j) {
                                 results[thread] +=
                                     expectation_value_1_1(basis[i], conjugate_basis[j])
-                                    * types::add_conjugate_products(vector[i], vector[j]) / 2.;
+                                    * types::add_conjugate_products(at(i), at(j)) / 2.;
                             }
                             results[thread] += expectation_value_1_1(basis[i], conjugate_basis[i])
-                                               * std::norm(vector[i]) / 2.;
+                                               * std::norm(at(i)) / 2.;
                         }
 
 #pragma omp parallel for
@@ -265,7 +298,7 @@ namespace ieompp
                             for(auto j = N; j < basis_size; ++j) {
                                 results[thread] +=
                                     expectation_value_1_3(basis[i], conjugate_basis[j])
-                                    * types::add_conjugate_products(vector[i], vector[j]) / 2.;
+                                    * types::add_conjugate_products(at(i), at(j)) / 2.;
                             }
                         }
 
@@ -275,10 +308,10 @@ namespace ieompp
                             for(auto j = N; j < i; ++j) {
                                 results[thread] +=
                                     expectation_value_3_3(basis[i], conjugate_basis[j])
-                                    * types::add_conjugate_products(vector[i], vector[j]) / 2.;
+                                    * types::add_conjugate_products(at(i), at(j)) / 2.;
                             }
                             results[thread] += expectation_value_3_3(basis[i], conjugate_basis[i])
-                                               * std::norm(vector[i]) / 2.;
+                                               * std::norm(at(i)) / 2.;
                         }
 
                     } else {
@@ -288,7 +321,7 @@ namespace ieompp
                             for(auto j = 0ul; j < N; ++j) {
                                 results[thread] +=
                                     expectation_value_1_1(basis[i], conjugate_basis[j])
-                                    * types::multiply_with_conjugate(vector[i], vector[j]) / 2.;
+                                    * types::multiply_with_conjugate(at(i), at(j)) / 2.;
                             }
                         }
 
@@ -298,10 +331,9 @@ namespace ieompp
                             for(auto j = N; j < basis_size; ++j) {
                                 results[thread] +=
                                     expectation_value_1_3(basis[i], conjugate_basis[j])
-                                        * types::multiply_with_conjugate(vector[i], vector[j]) / 2.
+                                        * types::multiply_with_conjugate(at(i), at(j)) / 2.
                                     + expectation_value_3_1(basis[j], conjugate_basis[i])
-                                          * types::multiply_with_conjugate(vector[j], vector[i])
-                                          / 2.;
+                                          * types::multiply_with_conjugate(at(j), at(i)) / 2.;
                             }
                         }
 
@@ -311,7 +343,7 @@ namespace ieompp
                             for(auto j = N; j < basis_size; ++j) {
                                 results[thread] +=
                                     expectation_value_3_3(basis[i], conjugate_basis[j])
-                                    * types::multiply_with_conjugate(vector[i], vector[j]) / 2.;
+                                    * types::multiply_with_conjugate(at(i), at(j)) / 2.;
                             }
                         }
                     }
@@ -325,6 +357,182 @@ namespace ieompp
                     return result.real();
                 }
             };
+
+            // Contribution of one momentum sector q to <n_{0,↑}>. For a translation invariant
+            // expectation value function the sectors decouple and <n_{0,↑}> is the sum of the
+            // contributions of all N sectors,
+            //   1/(2N) Σ_{r,r'} ĥ_q(r) ĥ_q(r')^* Σ_s E((0, r), (s, r')) e^{i q s},
+            // where E is the expectation value of the real-space SiteOccupation.
+            template <typename FloatT, typename OperatorT, typename ConjugateBasisT>
+            struct SiteOccupation<FloatT, TranslationBasis3Operator<OperatorT>, ConjugateBasisT> {
+                using Float    = FloatT;
+                using Basis    = TranslationBasis3Operator<OperatorT>;
+                using Monomial = typename Basis::Monomial;
+                using Operator = typename Monomial::Operator;
+                using ExpectationValueFunction =
+                    std::function<Float(const Operator&, const Operator&)>;
+                using RealSpaceSiteOccupation =
+                    SiteOccupation<Float, typename Basis::RealSpaceBasis>;
+
+                ExpectationValueFunction expectation_value_function;
+                std::reference_wrapper<const Basis> basis_ref;
+
+                template <typename Vector>
+                Float operator()(const Vector& vector) const
+                {
+                    const auto& basis               = basis_ref.get();
+                    const auto& real_space_basis    = basis.real_space_basis;
+                    const auto real_space_conjugate = real_space_basis.get_conjugate();
+                    const RealSpaceSiteOccupation real_space{expectation_value_function,
+                                                             std::cref(real_space_basis),
+                                                             std::cref(real_space_conjugate)};
+                    const auto N          = basis.N;
+                    const auto basis_size = basis.size();
+
+                    // e^{i q s} for all translations s
+                    std::vector<std::complex<Float>> phases(N);
+                    for(auto s = 0ul; s < N; ++s) {
+                        const auto arg = basis.template momentum<Float>() * Float(s);
+                        phases[s]      = std::complex<Float>(std::cos(arg), std::sin(arg));
+                    }
+
+                    std::vector<std::complex<Float>> results(omp_get_max_threads(), 0.0);
+
+#pragma omp parallel for schedule(dynamic, 1)
+                    for(auto i = 0ul; i < basis_size; ++i) {
+                        const auto thread = omp_get_thread_num();
+                        const auto a      = real_space_basis[basis.real_space_index(0, i)];
+                        for(auto j = 0ul; j < basis_size; ++j) {
+                            std::complex<Float> ev = 0.;
+                            for(auto s = 0ul; s < N; ++s) {
+                                ev += real_space.expectation_value(
+                                          a, real_space_conjugate[basis.real_space_index(s, j)])
+                                      * phases[s];
+                            }
+                            results[thread] +=
+                                ev * types::multiply_with_conjugate(vector[i], vector[j]) / 2.;
+                        }
+                    }
+
+                    const auto result =
+                        std::accumulate(results.begin(), results.end(), std::complex<Float>(0.))
+                        / Float(N);
+
+                    // the phases spoil the exact cancellation of the imaginary parts
+                    assert(types::IsZero(result.imag(),
+                                         Float(1e-10) * (1 + std::abs(result.real()))));
+                    return result.real();
+                }
+            };
+
+            // <n_{0,↑}> for the coefficients of a symmetric sector. For an expectation value
+            // function that is invariant under the symmetry group G the real-space sum collapses
+            // onto the orbits,
+            //   1/2 Σ_{O,O'} v_O v_O'^* sqrt(|O| |O'|) / |G| Σ_g E(rep(O), g rep(O')),
+            // which is symmetric in O and O' like the real-space expectation values.
+            template <typename FloatT, typename OperatorT, typename ConjugateBasisT>
+            struct SiteOccupation<FloatT, SymmetricBasis3Operator<OperatorT>, ConjugateBasisT> {
+                using Float    = FloatT;
+                using Basis    = SymmetricBasis3Operator<OperatorT>;
+                using Monomial = typename Basis::Monomial;
+                using Operator = typename Monomial::Operator;
+                using ExpectationValueFunction =
+                    std::function<Float(const Operator&, const Operator&)>;
+                using RealSpaceSiteOccupation =
+                    SiteOccupation<Float, typename Basis::RealSpaceBasis>;
+
+                ExpectationValueFunction expectation_value_function;
+                std::reference_wrapper<const Basis> basis_ref;
+
+                template <typename Vector>
+                Float operator()(const Vector& vector) const
+                {
+                    const auto& basis               = basis_ref.get();
+                    const auto& real_space_basis    = basis.real_space_basis;
+                    const auto real_space_conjugate = real_space_basis.get_conjugate();
+                    const RealSpaceSiteOccupation real_space{expectation_value_function,
+                                                             std::cref(real_space_basis),
+                                                             std::cref(real_space_conjugate)};
+                    const auto& group     = basis.group();
+                    const auto basis_size = basis.size();
+
+                    // E(rep(O), O') summed over the orbit O'
+                    const auto orbit_expectation_value = [&](std::size_t i, std::size_t j) {
+                        const auto a = real_space_basis[basis.representative(i)];
+                        Float ev     = 0.;
+                        for(const auto& g : group) {
+                            const auto b = basis.transform(g, basis.representative(j));
+                            ev += real_space.expectation_value(a, real_space_conjugate[b]);
+                        }
+                        return ev * std::sqrt(Float(basis.orbit_size(i) * basis.orbit_size(j)))
+                               / Float(group.size());
+                    };
+
+                    std::vector<Float> results(omp_get_max_threads(), 0.0);
+
+#pragma omp parallel for schedule(dynamic, 1)
+                    for(auto i = 0ul; i < basis_size; ++i) {
+                        const auto thread = omp_get_thread_num();
+                        for(auto j = 0ul; j < i; ++j) {
+                            results[thread] += orbit_expectation_value(i, j)
+                                               * types::add_conjugate_products(vector[i], vector[j])
+                                               / 2.;
+                        }
+                        results[thread] +=
+                            orbit_expectation_value(i, i) * std::norm(vector[i]) / 2.;
+                    }
+
+                    return std::accumulate(results.begin(), results.end(), Float(0.));
+                }
+            };
+
+            // <n_{0,↑}> for the coefficients of a truncated basis, the real-space sum restricted to
+            // the elements of the basis
+            template <typename FloatT, typename OperatorT, typename ConjugateBasisT>
+            struct SiteOccupation<FloatT, TruncatedBasis3Operator<OperatorT>, ConjugateBasisT> {
+                using Float    = FloatT;
+                using Basis    = TruncatedBasis3Operator<OperatorT>;
+                using Monomial = typename Basis::Monomial;
+                using Operator = typename Monomial::Operator;
+                using ExpectationValueFunction =
+                    std::function<Float(const Operator&, const Operator&)>;
+                using RealSpaceSiteOccupation =
+                    SiteOccupation<Float, typename Basis::RealSpaceBasis>;
+
+                ExpectationValueFunction expectation_value_function;
+                std::reference_wrapper<const Basis> basis_ref;
+
+                template <typename Vector>
+                Float operator()(const Vector& vector) const
+                {
+                    const auto& basis               = basis_ref.get();
+                    const auto& real_space_basis    = basis.real_space_basis;
+                    const auto real_space_conjugate = real_space_basis.get_conjugate();
+                    const RealSpaceSiteOccupation real_space{expectation_value_function,
+                                                             std::cref(real_space_basis),
+                                                             std::cref(real_space_conjugate)};
+                    const auto basis_size = basis.size();
+
+                    std::vector<Float> results(omp_get_max_threads(), 0.0);
+
+#pragma omp parallel for schedule(dynamic, 1)
+                    for(auto i = 0ul; i < basis_size; ++i) {
+                        const auto thread = omp_get_thread_num();
+                        const auto a      = basis[i];
+                        for(auto j = 0ul; j < i; ++j) {
+                            const auto b = real_space_conjugate[basis.real_space_index(j)];
+                            results[thread] += real_space.expectation_value(a, b)
+                                               * types::add_conjugate_products(vector[i], vector[j])
+                                               / 2.;
+                        }
+                        const auto b = real_space_conjugate[basis.real_space_index(i)];
+                        results[thread] +=
+                            real_space.expectation_value(a, b) * std::norm(vector[i]) / 2.;
+                    }
+
+                    return std::accumulate(results.begin(), results.end(), Float(0.));
+                }
+            };
         } // namespace hubbard_real_space
     }     // namespace models
 } // namespace ieompp
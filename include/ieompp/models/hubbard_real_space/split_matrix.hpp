@@ -0,0 +1,115 @@
+#ifndef IEOMPP_MODELS_HUBBARD_REAL_SPACE_SPLIT_MATRIX_HPP_
+#define IEOMPP_MODELS_HUBBARD_REAL_SPACE_SPLIT_MATRIX_HPP_
+
+#include "ieompp/types/matrix.hpp"
+#include "ieompp/types/row_assembly.hpp"
+
+#include <cassert>
+#include <complex>
+#include <utility>
+#include <vector>
+
+namespace ieompp
+{
+    namespace models
+    {
+        namespace hubbard_real_space
+        {
+            // Kinetic part K and interaction part V of a real-space Liouvillian stored on their
+            // merged sparsity pattern, the Liouvillian for given J and U is J * K + U * V.
+            template <typename FloatT, typename IndexT>
+            struct SplitMatrix {
+                using Float = FloatT;
+                using Index = IndexT;
+
+                std::vector<std::size_t> row_pointers;
+                std::vector<Index> columns;
+                std::vector<Float> kinetic;
+                std::vector<Float> interaction;
+
+                Index rows() const { return row_pointers.empty() ? 0 : row_pointers.size() - 1; }
+                std::size_t non_zeros() const { return columns.size(); }
+            };
+
+            namespace detail
+            {
+                // Every matrix element of the real-space Liouvillians is linear in J and U with
+                // real coefficients. Building the rows with J = 1 and U = i therefore yields the
+                // coefficient of J in the real and the coefficient of U in the imaginary part of
+                // each element on the merged pattern of both parts.
+                template <typename Float, typename Index>
+                SplitMatrix<Float, Index>
+                make_split_matrix(types::CompressedRows<std::complex<Float>, Index>&& rows)
+                {
+                    SplitMatrix<Float, Index> split;
+                    split.row_pointers = std::move(rows.row_pointers);
+                    split.columns      = std::move(rows.columns);
+                    split.kinetic.resize(rows.values.size());
+                    split.interaction.resize(rows.values.size());
+
+                    const auto size = rows.values.size();
+#pragma omp parallel for
+                    for(std::size_t i = 0; i < size; ++i) {
+                        split.kinetic[i]     = rows.values[i].real();
+                        split.interaction[i] = rows.values[i].imag();
+                    }
+
+                    return split;
+                }
+            } // namespace detail
+
+            // append prefactor * (J * K + U * V) to an empty matrix that supports the
+            // append/finalize interface
+            template <typename Float, typename Index, typename Liouvillian, typename Matrix>
+            void init_combined_matrix(const SplitMatrix<Float, Index>& split,
+                                      const Liouvillian& liouvillian, Matrix& matrix,
+                                      const typename types::ScalarType<Matrix>::Type& prefactor
+                                      = 1.)
+            {
+                using Scalar = typename types::ScalarType<Matrix>::Type;
+
+                const auto rows = split.rows();
+                matrix.resize(rows, rows, false);
+                matrix.reset();
+                matrix.reserve(split.non_zeros());
+
+                const Scalar J = prefactor * liouvillian.J, U = prefactor * liouvillian.U;
+                for(Index row = 0; row < rows; ++row) {
+                    for(auto pos = split.row_pointers[row]; pos < split.row_pointers[row + 1];
+                        ++pos) {
+                        matrix.append(row, split.columns[pos],
+                                      J * split.kinetic[pos] + U * split.interaction[pos]);
+                    }
+                    matrix.finalize(row);
+                }
+            }
+
+            // overwrite the values of a matrix previously filled by init_combined_matrix with
+            // prefactor * (J * K + U * V) in a single parallel pass without touching the pattern
+            template <typename Float, typename Index, typename Liouvillian, typename Matrix>
+            void update_combined_matrix(const SplitMatrix<Float, Index>& split,
+                                        const Liouvillian& liouvillian, Matrix& matrix,
+                                        const typename types::ScalarType<Matrix>::Type& prefactor
+                                        = 1.)
+            {
+                using Scalar = typename types::ScalarType<Matrix>::Type;
+
+                assert(types::MatrixDimensionInfo<Matrix>::rows(matrix) == split.rows());
+
+                const auto rows = split.rows();
+                const Scalar J = prefactor * liouvillian.J, U = prefactor * liouvillian.U;
+#pragma omp parallel for
+                for(Index row = 0; row < rows; ++row) {
+                    auto pos = split.row_pointers[row];
+                    for(auto it = matrix.begin(row); it != matrix.end(row); ++it, ++pos) {
+                        assert(it->index() == split.columns[pos]);
+                        it->value() = J * split.kinetic[pos] + U * split.interaction[pos];
+                    }
+                    assert(pos == split.row_pointers[row + 1]);
+                }
+            }
+        } // namespace hubbard_real_space
+    }     // namespace models
+} // namespace ieompp
+
+#endif
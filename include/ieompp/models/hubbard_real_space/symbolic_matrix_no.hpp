@@ -0,0 +1,309 @@
+#ifndef IEOMPP_MODELS_HUBBARD_REAL_SPACE_SYMBOLIC_MATRIX_NO_HPP_
+#define IEOMPP_MODELS_HUBBARD_REAL_SPACE_SYMBOLIC_MATRIX_NO_HPP_
+
+#include "ieompp/models/hubbard/operator_traits.hpp"
+#include "ieompp/models/hubbard_real_space/basis.hpp"
+#include "ieompp/types/matrix.hpp"
+#include "ieompp/types/row_assembly.hpp"
+#include "ieompp/types/triplet.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace ieompp
+{
+    namespace models
+    {
+        namespace hubbard_real_space
+        {
+            // factor of a matrix element of the normal-ordered Liouvillian: 1, <c_a^† c_b> or
+            // δ_ab - <c_b^† c_a>
+            template <typename IndexT>
+            struct ExpectationValueFactor {
+                using Index = IndexT;
+
+                enum class Kind : std::uint8_t { One, Plain, Conjugate };
+
+                Kind kind;
+                Index a, b;
+
+                template <typename ExpectationValueFunction>
+                auto evaluate(const ExpectationValueFunction& expectation_value) const
+                    -> decltype(expectation_value(a, b))
+                {
+                    switch(kind) {
+                        case Kind::Plain:
+                            return expectation_value(a, b);
+                        case Kind::Conjugate:
+                            return ((a == b) ? 1 : 0) - expectation_value(b, a);
+                        default:
+                            return 1;
+                    }
+                }
+
+                bool operator==(const ExpectationValueFactor& rhs) const
+                {
+                    return (kind == rhs.kind) && (a == rhs.a) && (b == rhs.b);
+                }
+            };
+
+            // contribution coefficient * (J or U) * first * second to a matrix element
+            template <typename FloatT, typename IndexT>
+            struct MatrixRecipeTerm {
+                using Float  = FloatT;
+                using Index  = IndexT;
+                using Factor = ExpectationValueFactor<Index>;
+
+                Float coefficient;
+                bool interaction;
+                Factor first, second;
+
+                bool has_same_factors(const MatrixRecipeTerm& rhs) const
+                {
+                    return (interaction == rhs.interaction) && (first == rhs.first)
+                           && (second == rhs.second);
+                }
+            };
+
+            // Sparsity pattern of the matrix built by init_matrix_no together with the recipe for
+            // each element, the terms of element i occupy [term_pointers[i], term_pointers[i + 1]).
+            // The pattern contains every element that is non-zero for generic J, U and expectation
+            // values, elements that cancel for a particular choice are stored as explicit zeros.
+            template <typename FloatT, typename IndexT>
+            struct SymbolicMatrixNo {
+                using Float = FloatT;
+                using Index = IndexT;
+                using Term  = MatrixRecipeTerm<Float, Index>;
+
+                std::vector<std::size_t> row_pointers;
+                std::vector<Index> columns;
+                std::vector<std::size_t> term_pointers;
+                std::vector<Term> terms;
+
+                Index rows() const { return row_pointers.empty() ? 0 : row_pointers.size() - 1; }
+                std::size_t non_zeros() const { return columns.size(); }
+
+                template <typename Liouvillian, typename ExpectationValueFunction>
+                auto value(std::size_t element, const Liouvillian& liouvillian,
+                           const ExpectationValueFunction& expectation_value) const
+                {
+                    decltype(liouvillian.J * terms.front().first.evaluate(expectation_value)) sum =
+                        0.;
+                    for(auto pos = term_pointers[element]; pos < term_pointers[element + 1];
+                        ++pos) {
+                        const auto& term = terms[pos];
+                        sum += term.coefficient * (term.interaction ? liouvillian.U : liouvillian.J)
+                               * term.first.evaluate(expectation_value)
+                               * term.second.evaluate(expectation_value);
+                    }
+                    return sum;
+                }
+            };
+
+            namespace detail
+            {
+                // same structure as matrix_row_no, each emitted triplet carries a single term
+                template <typename Basis, typename Lattice, typename Float, typename Index>
+                void symbolic_matrix_row_no(
+                    const Basis& basis, const Lattice& lattice, Index row,
+                    types::TripletList<MatrixRecipeTerm<Float, Index>, Index>& triplets)
+                {
+                    using Term   = MatrixRecipeTerm<Float, Index>;
+                    using Factor = typename Term::Factor;
+                    using Kind   = typename Factor::Kind;
+
+                    const Factor one{Kind::One, 0, 0};
+                    const auto plain = [](Index a, Index b) { return Factor{Kind::Plain, a, b}; };
+                    const auto conj  = [](Index a, Index b) {
+                        return Factor{Kind::Conjugate, a, b};
+                    };
+                    const auto hopping = [&one](Float coefficient) {
+                        return Term{coefficient, false, one, one};
+                    };
+                    const auto interaction = [](Float coefficient, Factor first, Factor second) {
+                        return Term{coefficient, true, first, second};
+                    };
+
+                    triplets.clear();
+
+                    if(row < basis.N) {
+                        const auto r = basis[row].front().index1;
+                        for(auto neighbor : lattice.neighbors(row)) {
+                            triplets.emplace_back(row, neighbor, hopping(-1.));
+                        }
+                        triplets.emplace_back(row, row, interaction(1., one, one));
+                        triplets.emplace_back(row, basis.get_3op_index(row, row, row),
+                                              interaction(1., plain(r, r), one));
+                    } else {
+                        const auto& monomial = basis[row];
+                        const Index r1       = monomial[0].index1;
+                        const Index r2       = monomial[1].index1;
+                        const Index r3       = monomial[2].index1;
+
+                        for(auto neighbor : lattice.neighbors(r1)) {
+                            triplets.emplace_back(row, basis.get_3op_index(neighbor, r2, r3),
+                                                  hopping(-1.));
+                        }
+                        for(auto neighbor : lattice.neighbors(r2)) {
+                            triplets.emplace_back(row, basis.get_3op_index(r1, neighbor, r3),
+                                                  hopping(-1.));
+                        }
+                        for(auto neighbor : lattice.neighbors(r3)) {
+                            triplets.emplace_back(row, basis.get_3op_index(r1, r2, neighbor),
+                                                  hopping(1.));
+                        }
+
+                        // 1-operator monomials
+                        triplets.emplace_back(row, r1,
+                                              interaction(1., plain(r2, r1), conj(r3, r1)));
+                        triplets.emplace_back(row, r2,
+                                              interaction(1., conj(r2, r1), plain(r2, r3)));
+                        triplets.emplace_back(row, r3,
+                                              interaction(-1., plain(r3, r1), plain(r2, r3)));
+
+                        // 3-operator monomials
+                        triplets.emplace_back(row, row, interaction(1., plain(r1, r1), one));
+                        triplets.emplace_back(row, basis.get_3op_index(r1, r1, r3),
+                                              interaction(-1., plain(r2, r1), one));
+                        triplets.emplace_back(row, basis.get_3op_index(r1, r2, r1),
+                                              interaction(1., conj(r3, r1), one));
+                        if(r2 != r3) {
+                            triplets.emplace_back(row, basis.get_3op_index(r2, r2, r3),
+                                                  interaction(1., plain(r2, r1), one));
+                            triplets.emplace_back(row, basis.get_3op_index(r3, r2, r3),
+                                                  interaction(-1., plain(r3, r1), one));
+                        }
+                    }
+
+                    triplets.sort();
+
+                    // merge terms with the same factors within each column and drop the ones that
+                    // cancel exactly
+                    auto out = triplets.begin(), group = triplets.begin();
+                    for(auto it = triplets.begin(); it != triplets.end(); ++it) {
+                        if((out == triplets.begin()) || (it->column != (out - 1)->column)) {
+                            group = out;
+                        }
+                        const auto match = std::find_if(group, out, [&it](const auto& t) {
+                            return t.value.has_same_factors(it->value);
+                        });
+                        if(match != out) {
+                            match->value.coefficient += it->value.coefficient;
+                        } else {
+                            *out = *it;
+                            ++out;
+                        }
+                    }
+                    triplets.erase(out, triplets.end());
+                    triplets.erase(std::remove_if(triplets.begin(), triplets.end(),
+                                                  [](const auto& t) {
+                                                      return t.value.coefficient == 0.;
+                                                  }),
+                                   triplets.end());
+                }
+            } // namespace detail
+
+            // symbolic phase of init_matrix_no: the pattern and the recipes only depend on the
+            // basis and the lattice, not on J, U or the expectation values
+            template <typename Float, typename Basis, typename Lattice>
+            SymbolicMatrixNo<Float, typename Basis::BasisIndex>
+            init_symbolic_matrix_no(const Basis& basis, const Lattice& lattice)
+            {
+                using Index = typename Basis::BasisIndex;
+                using Term  = MatrixRecipeTerm<Float, Index>;
+
+                static_assert(IsThreeOperatorBasis<Basis>::value,
+                              "Basis must be a three operator basis");
+                static_assert(
+                    hubbard::IsHubbardOperator<typename Basis::Monomial::Operator>::value,
+                    "Operator-type in Monomial-type must be a Hubbard like operator!");
+
+                auto rows = types::assemble_rows_parallel<Term, Index>(
+                    basis.size(),
+                    [&](Index row, types::TripletList<Term, Index>& triplets) {
+                        detail::symbolic_matrix_row_no(basis, lattice, row, triplets);
+                    },
+                    (Lattice::coordination_number * 3) + 8);
+
+                SymbolicMatrixNo<Float, Index> symbolic;
+                symbolic.terms = std::move(rows.values);
+                symbolic.row_pointers.assign(basis.size() + 1, 0);
+                symbolic.columns.reserve(symbolic.terms.size());
+                symbolic.term_pointers.reserve(symbolic.terms.size() + 1);
+
+                for(Index row = 0; row < basis.size(); ++row) {
+                    for(auto pos = rows.row_pointers[row]; pos < rows.row_pointers[row + 1];
+                        ++pos) {
+                        if((pos == rows.row_pointers[row])
+                           || (rows.columns[pos] != rows.columns[pos - 1])) {
+                            symbolic.columns.push_back(rows.columns[pos]);
+                            symbolic.term_pointers.push_back(pos);
+                        }
+                    }
+                    symbolic.row_pointers[row + 1] = symbolic.columns.size();
+                }
+                symbolic.term_pointers.push_back(symbolic.terms.size());
+
+                return symbolic;
+            }
+
+            // numeric phase of init_matrix_no: fill an empty matrix that supports the
+            // append/finalize interface, the values are evaluated by all threads
+            template <typename Float, typename Index, typename Liouvillian, typename Matrix,
+                      typename ExpectationValueFunction>
+            void init_numeric_matrix_no(const SymbolicMatrixNo<Float, Index>& symbolic,
+                                        const Liouvillian& liouvillian, Matrix& matrix,
+                                        const ExpectationValueFunction& expectation_value)
+            {
+                using Scalar = typename types::ScalarType<Matrix>::Type;
+
+                const auto rows      = symbolic.rows();
+                const auto non_zeros = symbolic.non_zeros();
+
+                std::vector<Scalar> values(non_zeros);
+#pragma omp parallel for schedule(static)
+                for(std::size_t element = 0; element < non_zeros; ++element) {
+                    values[element] = symbolic.value(element, liouvillian, expectation_value);
+                }
+
+                matrix.resize(rows, rows, false);
+                matrix.reset();
+                matrix.reserve(non_zeros);
+                for(Index row = 0; row < rows; ++row) {
+                    for(auto pos = symbolic.row_pointers[row]; pos < symbolic.row_pointers[row + 1];
+                        ++pos) {
+                        matrix.append(row, symbolic.columns[pos], values[pos]);
+                    }
+                    matrix.finalize(row);
+                }
+            }
+
+            // overwrite the values of a matrix previously filled by init_numeric_matrix_no in a
+            // single parallel pass without touching the pattern
+            template <typename Float, typename Index, typename Liouvillian, typename Matrix,
+                      typename ExpectationValueFunction>
+            void update_numeric_matrix_no(const SymbolicMatrixNo<Float, Index>& symbolic,
+                                          const Liouvillian& liouvillian, Matrix& matrix,
+                                          const ExpectationValueFunction& expectation_value)
+            {
+                assert(types::MatrixDimensionInfo<Matrix>::rows(matrix) == symbolic.rows());
+
+                const auto rows = symbolic.rows();
+#pragma omp parallel for schedule(static)
+                for(Index row = 0; row < rows; ++row) {
+                    auto pos = symbolic.row_pointers[row];
+                    for(auto it = matrix.begin(row); it != matrix.end(row); ++it, ++pos) {
+                        assert(it->index() == symbolic.columns[pos]);
+                        it->value() = symbolic.value(pos, liouvillian, expectation_value);
+                    }
+                    assert(pos == symbolic.row_pointers[row + 1]);
+                }
+            }
+        } // namespace hubbard_real_space
+    }     // namespace models
+} // namespace ieompp
+
+#endif
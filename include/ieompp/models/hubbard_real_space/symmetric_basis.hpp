@@ -0,0 +1,215 @@
+#ifndef IEOMPP_MODELS_HUBBARD_REAL_SPACE_SYMMETRIC_BASIS_HPP_
+#define IEOMPP_MODELS_HUBBARD_REAL_SPACE_SYMMETRIC_BASIS_HPP_
+
+#include "ieompp/exception.hpp"
+#include "ieompp/models/hubbard_real_space/implicit_basis.hpp"
+#include "ieompp/types/hash_index.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace ieompp
+{
+    namespace models
+    {
+        namespace hubbard_real_space
+        {
+            // Symmetric sector of the three operator basis under a group G of site permutations
+            // that keep site 0 fixed and map neighbors onto neighbors, e.g. the point group of the
+            // lattice. The Liouvillian commutes with G and c_{0,↑}^† is invariant, therefore the
+            // coefficients h_a of the real-space basis stay constant on the orbits O = {g a} and
+            // one coefficient per orbit suffices. The element of the orbit with the smallest
+            // real-space index is its representative.
+            //
+            // The coefficient of an orbit is v_O = sqrt(|O|) h_a for a in O, with this
+            // normalization the sector matrix stays real symmetric and |v| = |h|.
+            template <typename OperatorT>
+            class SymmetricBasis3Operator
+            {
+            public:
+                using Operator       = OperatorT;
+                using RealSpaceBasis = ImplicitBasis3Operator<Operator>;
+                using Monomial       = typename RealSpaceBasis::Monomial;
+                using BasisIndex     = typename RealSpaceBasis::BasisIndex;
+                using SiteIndex      = typename Operator::Index1;
+                using Permutation    = std::vector<SiteIndex>;
+
+                const BasisIndex N;
+                const RealSpaceBasis real_space_basis;
+
+            private:
+                std::vector<Permutation> _group;
+                std::vector<BasisIndex> _representatives;
+                std::vector<std::uint8_t> _orbit_sizes;
+                // orbit index of the representatives
+                types::HashIndex<BasisIndex> _index;
+
+            public:
+                template <typename Lattice>
+                SymmetricBasis3Operator(const Lattice& lattice)
+                    : SymmetricBasis3Operator(lattice, lattice.point_group())
+                {
+                }
+
+                template <typename Lattice>
+                SymmetricBasis3Operator(const Lattice& lattice, std::vector<Permutation> group)
+                    : N(lattice.size()), real_space_basis(lattice), _group(std::move(group))
+                {
+                    std::sort(_group.begin(), _group.end());
+                    _group.erase(std::unique(_group.begin(), _group.end()), _group.end());
+                    if(_group.size() > 255) {
+                        THROW(Exception, "Symmetry group is limited to 255 elements");
+                    }
+
+                    for(const auto& g : _group) {
+                        if(g.size() != N) {
+                            THROW(Exception, "Permutation has " + std::to_string(g.size())
+                                                 + " instead of " + std::to_string(N)
+                                                 + " sites");
+                        }
+                        if(g[0] != 0) {
+                            THROW(Exception, "Permutation does not keep site 0 fixed");
+                        }
+                        for(SiteIndex i = 0; i < N; ++i) {
+                            for(auto neighbor : lattice.neighbors(i)) {
+                                if(!lattice.neighboring(g[i], g[neighbor])) {
+                                    THROW(Exception, "Permutation does not map neighbors onto "
+                                                     "neighbors");
+                                }
+                            }
+                        }
+                    }
+
+                    // an element is a representative if no image has a smaller index
+                    const BasisIndex real_space_size = real_space_basis.size();
+                    std::vector<std::uint8_t> orbit_sizes(real_space_size, 0);
+#pragma omp parallel for schedule(static)
+                    for(BasisIndex i = 0; i < real_space_size; ++i) {
+                        std::vector<BasisIndex> images;
+                        images.reserve(_group.size());
+                        for(const auto& g : _group) {
+                            images.push_back(transform(g, i));
+                        }
+                        std::sort(images.begin(), images.end());
+                        if(images.front() == i) {
+                            orbit_sizes[i] = std::unique(images.begin(), images.end())
+                                             - images.begin();
+                        }
+                    }
+
+                    for(BasisIndex i = 0; i < real_space_size; ++i) {
+                        if(orbit_sizes[i] != 0) {
+                            _representatives.push_back(i);
+                            _orbit_sizes.push_back(orbit_sizes[i]);
+                        }
+                    }
+                    _representatives.shrink_to_fit();
+                    _orbit_sizes.shrink_to_fit();
+                    _index = types::HashIndex<BasisIndex>(_representatives);
+                }
+
+                BasisIndex size() const { return _representatives.size(); }
+
+                const std::vector<Permutation>& group() const { return _group; }
+
+                Monomial operator[](BasisIndex index) const
+                {
+                    return real_space_basis[representative(index)];
+                }
+
+                // real-space index of the representative of the orbit index
+                BasisIndex representative(BasisIndex index) const
+                {
+                    assert(index < size());
+                    return _representatives[index];
+                }
+
+                BasisIndex orbit_size(BasisIndex index) const
+                {
+                    assert(index < size());
+                    return _orbit_sizes[index];
+                }
+
+                // real-space index of the image of the real-space element index under g
+                BasisIndex transform(const Permutation& g, BasisIndex index) const
+                {
+                    if(index < N) {
+                        return g[index];
+                    }
+                    const auto monomial = real_space_basis[index];
+                    return real_space_basis.get_3op_index(
+                        g[monomial[0].index1], g[monomial[1].index1], g[monomial[2].index1]);
+                }
+
+                // index of the orbit of the real-space element index
+                BasisIndex reduce(BasisIndex index) const
+                {
+                    auto canonical = index;
+                    for(const auto& g : _group) {
+                        canonical = std::min(canonical, transform(g, index));
+                    }
+                    const auto orbit = _index.find(canonical);
+                    assert(orbit != _index.not_found);
+                    return orbit;
+                }
+
+                // coefficient h_a of the real-space element index for the sector coefficients v
+                template <typename Vector>
+                auto real_space_coefficient(const Vector& v, BasisIndex index) const
+                {
+                    const auto orbit = reduce(index);
+                    return v[orbit] / std::sqrt(double(_orbit_sizes[orbit]));
+                }
+            };
+
+            // h_a = v_O / sqrt(|O|), h is resized to the dimension of the real-space basis
+            template <typename Operator, typename Vector, typename RealSpaceVector>
+            void symmetric_to_real_space(const SymmetricBasis3Operator<Operator>& basis,
+                                         const Vector& v, RealSpaceVector& h)
+            {
+                using BasisIndex = typename SymmetricBasis3Operator<Operator>::BasisIndex;
+
+                const BasisIndex size = basis.real_space_basis.size();
+                h.resize(size);
+#pragma omp parallel for schedule(static)
+                for(BasisIndex i = 0; i < size; ++i) {
+                    h[i] = basis.real_space_coefficient(v, i);
+                }
+            }
+
+            // v_O = 1/sqrt(|O|) Σ_{a in O} h_a, the orthogonal projection onto the sector, which
+            // inverts symmetric_to_real_space for symmetric h
+            template <typename Operator, typename RealSpaceVector, typename Vector>
+            void real_space_to_symmetric(const SymmetricBasis3Operator<Operator>& basis,
+                                         const RealSpaceVector& h, Vector& v)
+            {
+                using BasisIndex = typename SymmetricBasis3Operator<Operator>::BasisIndex;
+
+                const BasisIndex size = basis.size();
+                v.resize(size);
+#pragma omp parallel for schedule(static)
+                for(BasisIndex index = 0; index < size; ++index) {
+                    std::vector<BasisIndex> orbit;
+                    for(const auto& g : basis.group()) {
+                        orbit.push_back(basis.transform(g, basis.representative(index)));
+                    }
+                    std::sort(orbit.begin(), orbit.end());
+                    orbit.erase(std::unique(orbit.begin(), orbit.end()), orbit.end());
+
+                    v[index] = 0.;
+                    for(auto i : orbit) {
+                        v[index] += h[i];
+                    }
+                    v[index] /= std::sqrt(double(orbit.size()));
+                }
+            }
+        } // namespace hubbard_real_space
+    }     // namespace models
+} // namespace ieompp
+
+#endif
@@ -0,0 +1,190 @@
+#ifndef IEOMPP_MODELS_HUBBARD_REAL_SPACE_TRANSLATION_BASIS_HPP_
+#define IEOMPP_MODELS_HUBBARD_REAL_SPACE_TRANSLATION_BASIS_HPP_
+
+#include "ieompp/constants.hpp"
+#include "ieompp/exception.hpp"
+#include "ieompp/models/hubbard_real_space/implicit_basis.hpp"
+
+#include <cassert>
+#include <cmath>
+#include <complex>
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace ieompp
+{
+    namespace models
+    {
+        namespace hubbard_real_space
+        {
+            // Momentum sector of the three operator basis on a periodic chain. The translations
+            // T: j -> j + 1 commute with the Liouvillian, so the real-space basis splits into the
+            // orbits of c_{0,↑}^† and of c_{0,↑}^† c_{d2,↓}^† c_{d3,↓} under T, and the real-space
+            // coefficients h(j, r) of the translated representatives r into N independent sectors
+            //   ĥ_k(r) = Σ_j e^{i q_k j} h(j, r),    q_k = 2π k / N,
+            // each of dimension N^2 + 1. Element 0 is the representative c_{0,↑}^†, element
+            // 1 + N * d2 + d3 is c_{0,↑}^† c_{d2,↓}^† c_{d3,↓}. The sector matrices are complex
+            // Hermitian. The real-space coefficients are recovered exactly from all N sectors by
+            //   h(j, r) = 1/N Σ_k e^{-i q_k j} ĥ_k(r),
+            // see translation_sectors_to_real_space.
+            template <typename OperatorT>
+            struct TranslationBasis3Operator {
+                using Operator       = OperatorT;
+                using RealSpaceBasis = ImplicitBasis3Operator<Operator>;
+                using Monomial       = typename RealSpaceBasis::Monomial;
+                using BasisIndex     = typename RealSpaceBasis::BasisIndex;
+
+                const BasisIndex N;
+                const BasisIndex momentum_index;
+                const RealSpaceBasis real_space_basis;
+
+                template <typename Lattice>
+                TranslationBasis3Operator(BasisIndex momentum_index, const Lattice& lattice)
+                    : N(lattice.size()), momentum_index(momentum_index), real_space_basis(lattice)
+                {
+                    assert(momentum_index < N);
+                }
+
+                BasisIndex size() const { return N * N + 1; }
+
+                template <typename Float>
+                Float momentum() const
+                {
+                    return TwoPi<Float>::value * Float(momentum_index) / Float(N);
+                }
+
+                // representative of the orbit
+                Monomial operator[](BasisIndex index) const
+                {
+                    return real_space_basis[real_space_index(0, index)];
+                }
+
+                BasisIndex get_3op_index(BasisIndex d2, BasisIndex d3) const
+                {
+                    return 1 + N * d2 + d3;
+                }
+
+                // index of the representative translated by shift in the real-space basis
+                BasisIndex real_space_index(BasisIndex shift, BasisIndex index) const
+                {
+                    assert(shift < N);
+                    assert(index < size());
+                    if(index == 0) {
+                        return shift;
+                    }
+                    --index;
+                    return real_space_basis.get_3op_index(shift, (shift + index / N) % N,
+                                                          (shift + index % N) % N);
+                }
+
+                // inverse of real_space_index: the representative of the orbit the real-space
+                // basis element belongs to and the translation that maps the representative onto it
+                std::pair<BasisIndex, BasisIndex> reduce(BasisIndex real_space_index) const
+                {
+                    assert(real_space_index < real_space_basis.size());
+                    if(real_space_index < N) {
+                        return std::make_pair(BasisIndex(0), real_space_index);
+                    }
+                    real_space_index -= N;
+                    const auto i1 = real_space_index / (N * N);
+                    const auto i2 = (real_space_index / N) % N;
+                    const auto i3 = real_space_index % N;
+                    return std::make_pair(get_3op_index((i2 + N - i1) % N, (i3 + N - i1) % N), i1);
+                }
+            };
+
+            // index of the sector containing the Fourier component with momentum q (in units of
+            // the inverse lattice spacing), throws if q is not a multiple of 2π / N
+            template <typename Float, typename Lattice>
+            std::uint64_t translation_momentum_index(const Lattice& lattice, const Float& q)
+            {
+                const auto N = lattice.size();
+                const Float k = q * lattice.dx() * Float(N) / TwoPi<Float>::value;
+                const Float k_rounded = std::round(k);
+                if(std::abs(k - k_rounded) > 1e-8) {
+                    THROW(Exception, "Momentum " + std::to_string(q)
+                                         + " is not compatible with a chain of "
+                                         + std::to_string(N) + " sites");
+                }
+                const auto N_signed = static_cast<std::int64_t>(N);
+                return static_cast<std::uint64_t>(
+                    ((static_cast<std::int64_t>(k_rounded) % N_signed) + N_signed) % N_signed);
+            }
+
+            // h(j, r) = 1/N Σ_k e^{-i q_k j} ĥ_k(r), sectors[k] holds ĥ_k and h is resized to the
+            // dimension of the real-space basis
+            template <typename Operator, typename Vector, typename RealSpaceVector>
+            void translation_sectors_to_real_space(const TranslationBasis3Operator<Operator>& basis,
+                                                   const std::vector<Vector>& sectors,
+                                                   RealSpaceVector& h)
+            {
+                using BasisIndex = typename TranslationBasis3Operator<Operator>::BasisIndex;
+                using Complex    = typename std::decay<decltype(h[0])>::type;
+                using Float      = typename Complex::value_type;
+
+                const auto N    = basis.N;
+                const auto size = basis.size();
+                assert(sectors.size() == N);
+
+                // e^{-i q_k j} only depends on k * j mod N
+                std::vector<Complex> phases(N);
+                for(BasisIndex i = 0; i < N; ++i) {
+                    const auto arg = -TwoPi<Float>::value * Float(i) / Float(N);
+                    phases[i]      = Complex(std::cos(arg), std::sin(arg));
+                }
+
+                h.resize(basis.real_space_basis.size());
+#pragma omp parallel for schedule(static)
+                for(BasisIndex index = 0; index < size; ++index) {
+                    for(BasisIndex j = 0; j < N; ++j) {
+                        Complex sum = 0.;
+                        for(BasisIndex k = 0; k < N; ++k) {
+                            sum += phases[(k * j) % N] * sectors[k][index];
+                        }
+                        h[basis.real_space_index(j, index)] = sum / Float(N);
+                    }
+                }
+            }
+
+            // ĥ_k(r) = Σ_j e^{i q_k j} h(j, r), inverse of translation_sectors_to_real_space
+            template <typename Operator, typename RealSpaceVector, typename Vector>
+            void real_space_to_translation_sectors(const TranslationBasis3Operator<Operator>& basis,
+                                                   const RealSpaceVector& h,
+                                                   std::vector<Vector>& sectors)
+            {
+                using BasisIndex = typename TranslationBasis3Operator<Operator>::BasisIndex;
+                using Complex    = typename std::decay<decltype(h[0])>::type;
+                using Float      = typename Complex::value_type;
+
+                const auto N    = basis.N;
+                const auto size = basis.size();
+                assert(h.size() == basis.real_space_basis.size());
+
+                std::vector<Complex> phases(N);
+                for(BasisIndex i = 0; i < N; ++i) {
+                    const auto arg = TwoPi<Float>::value * Float(i) / Float(N);
+                    phases[i]      = Complex(std::cos(arg), std::sin(arg));
+                }
+
+                sectors.resize(N);
+                for(auto& sector : sectors) {
+                    sector.resize(size);
+                }
+#pragma omp parallel for schedule(static)
+                for(BasisIndex index = 0; index < size; ++index) {
+                    for(BasisIndex k = 0; k < N; ++k) {
+                        Complex sum = 0.;
+                        for(BasisIndex j = 0; j < N; ++j) {
+                            sum += phases[(k * j) % N] * h[basis.real_space_index(j, index)];
+                        }
+                        sectors[k][index] = sum;
+                    }
+                }
+            }
+        } // namespace hubbard_real_space
+    }     // namespace models
+} // namespace ieompp
+
+#endif
@@ -0,0 +1,146 @@
+#ifndef IEOMPP_MODELS_HUBBARD_REAL_SPACE_TRUNCATED_BASIS_HPP_
+#define IEOMPP_MODELS_HUBBARD_REAL_SPACE_TRUNCATED_BASIS_HPP_
+
+#include "ieompp/models/hubbard_real_space/implicit_basis.hpp"
+#include "ieompp/types/hash_index.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <utility>
+#include <vector>
+
+namespace ieompp
+{
+    namespace models
+    {
+        namespace hubbard_real_space
+        {
+            // Three operator basis restricted to the local monomials: c_{i,↑}^† for all sites and
+            // c_{i1,↑}^† c_{i2,↓}^† c_{i3,↓} only if the lattice distances of all pairs of i1, i2
+            // and i3 are at most the cutoff R. The basis has N + O(N R^(2d)) elements instead of
+            // N + N^3 and reproduces the real-space basis for R >= the diameter of the lattice.
+            //
+            // Elements 0 to N - 1 are the one operator monomials, the three operator monomials
+            // follow in the order of the real-space basis. The sites within the cutoff are found
+            // by a breadth-first search along the neighbors, lattice_distance has to count the
+            // hops between the sites as for PeriodicChain and PeriodicSquareLattice. find looks up
+            // the real-space indices in a hash index.
+            template <typename OperatorT>
+            class TruncatedBasis3Operator
+            {
+            public:
+                using Operator       = OperatorT;
+                using RealSpaceBasis = ImplicitBasis3Operator<Operator>;
+                using Monomial       = typename RealSpaceBasis::Monomial;
+                using BasisIndex     = typename RealSpaceBasis::BasisIndex;
+                using SiteIndex      = typename Operator::Index1;
+
+                const BasisIndex N;
+                const BasisIndex cutoff;
+                const RealSpaceBasis real_space_basis;
+
+            private:
+                // real-space indices of the three operator elements
+                std::vector<BasisIndex> _elements;
+                // the three operator elements with i1 = i are N + _offsets[i] to N + _offsets[i+1]
+                std::vector<BasisIndex> _offsets;
+                // position of the real-space indices in _elements
+                types::HashIndex<BasisIndex> _index;
+
+            public:
+                template <typename Lattice>
+                TruncatedBasis3Operator(const Lattice& lattice, BasisIndex cutoff)
+                    : N(lattice.size()), cutoff(cutoff), real_space_basis(lattice), _offsets(N + 1)
+                {
+                    std::vector<BasisIndex> depth(N, N);
+                    std::vector<SiteIndex> ball;
+
+                    for(SiteIndex i1 = 0; i1 < N; ++i1) {
+                        // sites within the cutoff of i1, depth is reset for the visited ones only
+                        ball.assign(1, i1);
+                        depth[i1] = 0;
+                        for(std::size_t pos = 0; pos < ball.size(); ++pos) {
+                            const auto site = ball[pos];
+                            if(depth[site] == cutoff) {
+                                continue;
+                            }
+                            for(auto neighbor : lattice.neighbors(site)) {
+                                if(depth[neighbor] == N) {
+                                    depth[neighbor] = depth[site] + 1;
+                                    ball.push_back(neighbor);
+                                }
+                            }
+                        }
+                        for(auto site : ball) {
+                            depth[site] = N;
+                        }
+                        std::sort(ball.begin(), ball.end());
+
+                        _offsets[i1] = _elements.size();
+                        for(auto i2 : ball) {
+                            for(auto i3 : ball) {
+                                if(lattice.lattice_distance(i2, i3) <= cutoff) {
+                                    _elements.push_back(real_space_basis.get_3op_index(i1, i2, i3));
+                                }
+                            }
+                        }
+                    }
+                    _offsets[N] = _elements.size();
+                    _elements.shrink_to_fit();
+                    _index = types::HashIndex<BasisIndex>(_elements);
+                }
+
+                BasisIndex size() const { return N + _elements.size(); }
+
+                Monomial operator[](BasisIndex index) const
+                {
+                    return real_space_basis[real_space_index(index)];
+                }
+
+                // index of the element in the real-space basis
+                BasisIndex real_space_index(BasisIndex index) const
+                {
+                    assert(index < size());
+                    return (index < N) ? index : _elements[index - N];
+                }
+
+                // index of the real-space element real_space_index, size() if it is not contained
+                BasisIndex find(BasisIndex real_space_index) const
+                {
+                    assert(real_space_index < real_space_basis.size());
+                    if(real_space_index < N) {
+                        return real_space_index;
+                    }
+                    const auto position = _index.find(real_space_index);
+                    return (position == _index.not_found) ? size() : N + position;
+                }
+
+                // range [first, last) of the indices of the three operator elements with i1 = site
+                std::pair<BasisIndex, BasisIndex> three_operator_range(SiteIndex site) const
+                {
+                    assert(site < N);
+                    return std::make_pair(N + _offsets[site], N + _offsets[site + 1]);
+                }
+            };
+
+            // h is resized to the dimension of the real-space basis, the elements that are not
+            // contained in the truncated basis are zero
+            template <typename Operator, typename Vector, typename RealSpaceVector>
+            void truncated_to_real_space(const TruncatedBasis3Operator<Operator>& basis,
+                                         const Vector& v, RealSpaceVector& h)
+            {
+                using BasisIndex = typename TruncatedBasis3Operator<Operator>::BasisIndex;
+
+                h.resize(basis.real_space_basis.size());
+                h.reset();
+                const BasisIndex size = basis.size();
+#pragma omp parallel for schedule(static)
+                for(BasisIndex i = 0; i < size; ++i) {
+                    h[basis.real_space_index(i)] = v[i];
+                }
+            }
+        } // namespace hubbard_real_space
+    }     // namespace models
+} // namespace ieompp
+
+#endif
@@ -0,0 +1,213 @@
+#ifndef IEOMPP_ODE_ACTIVE_SET_RK4_HPP_
+#define IEOMPP_ODE_ACTIVE_SET_RK4_HPP_
+
+#include "ieompp/types/compressed_row_matrix.hpp"
+#include "ieompp/types/matrix.hpp"
+#include "ieompp/types/matrix_check.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <complex>
+#include <cstdint>
+#include <vector>
+
+namespace ieompp
+{
+    namespace ode
+    {
+        // RK4 integrator for du/dt = i * m * u that only updates the active set of rows. A row
+        // becomes active when it can receive a contribution during the next step: the four
+        // stages of a step spread the coefficients by at most four hops along the pattern of m,
+        // so the 4-hop neighborhood of every coefficient with |u_i| > tolerance is activated
+        // before the step. Coefficients outside of the active set stay zero and the active set
+        // only grows. For tolerance 0 the step equals RK4::step_imaginary exactly, otherwise the
+        // contributions of the coefficients below the tolerance to inactive rows are dropped.
+        //
+        // The pattern of m has to be symmetric (as for the Liouvillian matrices), since the
+        // neighbors of a row are looked up in its own columns. Once the active set covers more
+        // than dense_fraction of the rows the integrator stops tracking it and updates all rows.
+        template <typename FloatT>
+        class ActiveSetRK4
+        {
+            using Float = FloatT;
+
+        private:
+            enum class State : std::uint8_t { Inactive, Active, Expanded };
+
+            static constexpr std::size_t hops = 4;
+
+            const std::size_t _dimension;
+            const Float _step_size;
+            const Float _tolerance;
+            const Float _dense_fraction;
+
+            bool _initialized, _dense;
+            std::vector<std::size_t> _active;
+            std::vector<State> _state;
+            std::vector<std::uint32_t> _visited;
+            std::uint32_t _stamp;
+            std::vector<std::complex<Float>> _y, _k, _sum;
+
+        public:
+            ActiveSetRK4(std::size_t dimension, const Float& step_size, const Float& tolerance,
+                         const Float& dense_fraction = 0.5)
+                : _dimension(dimension), _step_size(step_size), _tolerance(tolerance),
+                  _dense_fraction(dense_fraction), _initialized(false), _dense(false), _stamp(0)
+            {
+            }
+
+            const Float& step_size() const { return _step_size; }
+            std::size_t dimension() const { return _dimension; }
+            const Float& tolerance() const { return _tolerance; }
+
+            bool is_dense() const { return _dense; }
+            std::size_t active() const { return _dense ? _dimension : _active.size(); }
+
+            // forget the active set, has to be called before integrating another vector
+            void reset()
+            {
+                _initialized = false;
+                _dense       = false;
+                _active.clear();
+            }
+
+            template <typename Scalar, typename Index, typename Offset, typename Vector>
+            void step_imaginary(const types::CompressedRowMatrix<Scalar, Index, Offset>& m,
+                                Vector& u)
+            {
+                assert(types::is_quadratic(m));
+                assert(m.rows() == _dimension);
+                assert(types::MatrixDimensionInfo<Vector>::rows(u) == _dimension);
+
+                using Value = std::complex<Float>;
+                const Value half_step(0, _step_size / 2), full_step(0, _step_size),
+                    sixth_step(0, _step_size / 6);
+
+                if(!_initialized) {
+                    initialize(u);
+                }
+                if(!_dense) {
+                    expand(m, u);
+                }
+
+                const auto& row_pointers = m.row_pointers();
+                const auto& columns      = m.column_indices();
+                const auto& values       = m.values();
+                const std::size_t count  = active();
+                const auto row_at        = [this](std::size_t pos) {
+                    return _dense ? pos : _active[pos];
+                };
+
+                // k = m * y on the active rows, the stage weight 1, 2, 2, 1 is added to the sum
+                // and y is updated to u + coefficient * k
+                const auto stage = [&](const auto& y, Float weight, const Value& coefficient,
+                                       bool first) {
+#pragma omp parallel for schedule(static)
+                    for(std::size_t pos = 0; pos < count; ++pos) {
+                        const auto row = row_at(pos);
+                        Value k        = 0.;
+                        for(Offset i = row_pointers[row]; i < row_pointers[row + 1]; ++i) {
+                            k += values[i] * y[columns[i]];
+                        }
+                        _k[row] = k;
+                    }
+#pragma omp parallel for schedule(static)
+                    for(std::size_t pos = 0; pos < count; ++pos) {
+                        const auto row = row_at(pos);
+                        _sum[row]      = (first ? Value(0.) : _sum[row]) + weight * _k[row];
+                        _y[row]        = u[row] + coefficient * _k[row];
+                    }
+                };
+
+                stage(u, 1., half_step, true);
+                stage(_y, 2., half_step, false);
+                stage(_y, 2., full_step, false);
+                stage(_y, 1., 0., false);
+
+#pragma omp parallel for schedule(static)
+                for(std::size_t pos = 0; pos < count; ++pos) {
+                    const auto row = row_at(pos);
+                    u[row] += sixth_step * _sum[row];
+                }
+            }
+
+        private:
+            template <typename Vector>
+            void initialize(const Vector& u)
+            {
+                _y.assign(_dimension, 0.);
+                _k.assign(_dimension, 0.);
+                _sum.assign(_dimension, 0.);
+                _state.assign(_dimension, State::Inactive);
+                _visited.assign(_dimension, 0);
+                _stamp = 0;
+
+                _active.clear();
+                for(std::size_t i = 0; i < _dimension; ++i) {
+                    if(u[i] != std::complex<Float>(0.)) {
+                        _state[i] = State::Active;
+                        _active.push_back(i);
+                    }
+                }
+                _initialized = true;
+            }
+
+            // activate the 4-hop neighborhoods of the coefficients that exceeded the tolerance
+            // since the last step, a row whose neighborhood is already active ends the search
+            template <typename Scalar, typename Index, typename Offset, typename Vector>
+            void expand(const types::CompressedRowMatrix<Scalar, Index, Offset>& m,
+                        const Vector& u)
+            {
+                const auto& row_pointers = m.row_pointers();
+                const auto& columns      = m.column_indices();
+
+                // the seeds start the search, their neighborhood is active afterwards
+                std::vector<std::size_t> level, next;
+                ++_stamp;
+                for(auto i : _active) {
+                    if((_state[i] == State::Active) && (std::abs(u[i]) > _tolerance)) {
+                        _state[i]   = State::Expanded;
+                        _visited[i] = _stamp;
+                        level.push_back(i);
+                    }
+                }
+                if(level.empty()) {
+                    return;
+                }
+
+                const auto old_size = _active.size();
+                for(std::size_t hop = 0; hop < hops; ++hop) {
+                    next.clear();
+                    for(auto row : level) {
+                        for(Offset i = row_pointers[row]; i < row_pointers[row + 1]; ++i) {
+                            const std::size_t column = columns[i];
+                            if((_visited[column] == _stamp)
+                               || (_state[column] == State::Expanded)) {
+                                continue;
+                            }
+                            _visited[column] = _stamp;
+                            if(_state[column] == State::Inactive) {
+                                _state[column] = State::Active;
+                                _active.push_back(column);
+                            }
+                            next.push_back(column);
+                        }
+                    }
+                    std::swap(level, next);
+                }
+
+                if(_active.size() > _dense_fraction * _dimension) {
+                    _dense = true;
+                    _active.clear();
+                    _active.shrink_to_fit();
+                    return;
+                }
+
+                std::sort(_active.begin() + old_size, _active.end());
+                std::inplace_merge(_active.begin(), _active.begin() + old_size, _active.end());
+            }
+        };
+    } // namespace ode
+} // namespace ieompp
+
+#endif
@@ -0,0 +1,91 @@
+#ifndef IEOMPP_ODE_ADAPTIVE_RK4_HPP_
+#define IEOMPP_ODE_ADAPTIVE_RK4_HPP_
+
+#include "ieompp/types/matrix.hpp"
+
+#include <cassert>
+#include <complex>
+#include <vector>
+
+namespace ieompp
+{
+    namespace ode
+    {
+        // RK4 integrator for du/dt = i * m * u where m is the restriction of a larger matrix to a
+        // subspace that grows during the propagation, as models::hubbard_real_space::
+        // AdaptiveMatrix. Before every step m.grow(u, threshold) adds the elements whose flux
+        // exceeds the threshold to m and u and returns the norm of the flux out of the subspace
+        // before the growth, i.e. of the flux the propagation in the subspace has missed at the
+        // end of the last step. For a unitary propagation the integral of this norm bounds the
+        // distance to the propagation with the larger matrix, error_indicator() is the sum of the
+        // norms times the step size. The stage vectors are members that grow with m, the products
+        // are computed by m.multiply(x, y) into them, so the integrator allocates only when the
+        // subspace has grown beyond their capacity.
+        template <typename FloatT>
+        class AdaptiveRK4
+        {
+            using Float = FloatT;
+            using Value = std::complex<Float>;
+
+        private:
+            const Float _step_size;
+            const Float _threshold;
+            Float _error_indicator;
+            // argument and product of the current stage and the weighted sum of the products
+            std::vector<Value> _y, _k, _sum;
+
+        public:
+            AdaptiveRK4(const Float& step_size, const Float& threshold)
+                : _step_size(step_size), _threshold(threshold), _error_indicator(0.)
+            {
+            }
+
+            const Float& step_size() const { return _step_size; }
+            const Float& threshold() const { return _threshold; }
+            const Float& error_indicator() const { return _error_indicator; }
+
+            template <typename Matrix, typename Vector>
+            void step_imaginary(Matrix& m, Vector& u)
+            {
+                _error_indicator += _step_size * m.grow(u, _threshold);
+
+                const std::size_t dimension = m.rows();
+                assert(types::MatrixDimensionInfo<Vector>::rows(u) == dimension);
+                _y.resize(dimension);
+                _k.resize(dimension);
+                _sum.resize(dimension);
+
+                const Value half_step(0, _step_size / 2), full_step(0, _step_size),
+                    sixth_step(0, _step_size / 6);
+
+                // add the product k of a stage to the sum with weight and set the argument
+                // y = u + coefficient * k of the next stage
+                const auto stage = [&](Float weight, const Value& coefficient) {
+#pragma omp parallel for schedule(static)
+                    for(std::size_t i = 0; i < dimension; ++i) {
+                        _sum[i] += weight * _k[i];
+                        _y[i] = u[i] + coefficient * _k[i];
+                    }
+                };
+
+                m.multiply(u, _k);
+#pragma omp parallel for schedule(static)
+                for(std::size_t i = 0; i < dimension; ++i) {
+                    _sum[i] = _k[i];
+                    _y[i]   = u[i] + half_step * _k[i];
+                }
+                m.multiply(_y, _k);
+                stage(2., half_step);
+                m.multiply(_y, _k);
+                stage(2., full_step);
+                m.multiply(_y, _k);
+#pragma omp parallel for schedule(static)
+                for(std::size_t i = 0; i < dimension; ++i) {
+                    u[i] += sixth_step * (_sum[i] + _k[i]);
+                }
+            }
+        };
+    } // namespace ode
+} // namespace ieompp
+
+#endif
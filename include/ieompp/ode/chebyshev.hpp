@@ -0,0 +1,283 @@
+#ifndef IEOMPP_ODE_CHEBYSHEV_HPP_
+#define IEOMPP_ODE_CHEBYSHEV_HPP_
+
+#include "ieompp/types/compressed_row_matrix.hpp"
+#include "ieompp/types/matrix.hpp"
+#include "ieompp/types/matrix_check.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <complex>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace ieompp
+{
+    namespace ode
+    {
+        // Bessel functions J_0(x), ..., J_{count-1}(x) of the first kind for x >= 0 by Miller's
+        // backward recurrence, normalized with J_0 + 2 * sum_k J_{2k} = 1
+        template <typename Float>
+        std::vector<Float> bessel_functions(const Float& x, std::size_t count)
+        {
+            assert(x >= 0.);
+            std::vector<Float> J(count, Float(0.));
+            if(count == 0) {
+                return J;
+            }
+            if(x == 0.) {
+                J[0] = 1.;
+                return J;
+            }
+
+            const auto largest = std::max(Float(count), x);
+            auto start         = static_cast<std::size_t>(largest + 20 + std::sqrt(40 * largest));
+            start += start % 2;
+
+            Float next = 0., current = 1., norm = 0.;
+            for(std::size_t k = start; k > 0; --k) {
+                // current is J_k, the recurrence gives J_{k-1}
+                const Float previous = 2 * k / x * current - next;
+                next                 = current;
+                current              = previous;
+                if(k - 1 < count) {
+                    J[k - 1] = current;
+                }
+                if((k - 1) % 2 == 0 && k > 1) {
+                    norm += 2 * current;
+                }
+                if(std::abs(current) > 1e250) {
+                    current *= 1e-250;
+                    next *= 1e-250;
+                    norm *= 1e-250;
+                    for(auto& value : J) {
+                        value *= 1e-250;
+                    }
+                }
+            }
+            norm += current;
+            for(auto& value : J) {
+                value /= norm;
+            }
+            return J;
+        }
+
+        // Propagator u -> exp(i t m) u for a time independent real symmetric CompressedRowMatrix
+        // m by the Chebyshev expansion exp(i t m) = exp(i t c) * sum_k (2 - delta_k0) i^k
+        // J_k(t w) T_k((m - c) / w), where the spectrum of m lies in [c - w, c + w]. The bounds
+        // are estimated once per matrix by the Gershgorin circles, reset() has to be called after
+        // the matrix changed. Each order costs one fused sweep computing the next T_k u from the
+        // last two and adding it to the results, the order is increased until the coefficients
+        // fall below tolerance.
+        //
+        // The vectors T_k u do not depend on t, one expansion therefore yields the states after
+        // all of the next steps_per_expansion steps at once: the first call of step_imaginary
+        // computes them and returns the first one, the following calls return the others without
+        // a product. Between these calls u must not be modified, reset() discards the pending
+        // states. Longer expansions need slightly fewer products per time but
+        // steps_per_expansion vectors of memory.
+        template <typename FloatT>
+        class Chebyshev
+        {
+            using Float = FloatT;
+            using Value = std::complex<Float>;
+
+        private:
+            const std::size_t _dimension;
+            const Float _step_size;
+            const Float _tolerance;
+            const std::size_t _steps_per_expansion;
+
+            bool _has_bounds;
+            Float _center, _half_width;
+            std::size_t _pending;
+            std::uint64_t _expansions, _products;
+            std::vector<Value> _previous, _current;
+            std::vector<std::vector<Value>> _states;
+
+        public:
+            Chebyshev(std::size_t dimension, const Float& step_size, const Float& tolerance,
+                      std::size_t steps_per_expansion = 1)
+                : _dimension(dimension), _step_size(step_size), _tolerance(tolerance),
+                  _steps_per_expansion(steps_per_expansion), _has_bounds(false), _center(0.),
+                  _half_width(0.), _pending(0), _expansions(0), _products(0),
+                  _previous(dimension), _current(dimension),
+                  _states(steps_per_expansion, std::vector<Value>(dimension))
+            {
+                assert(steps_per_expansion > 0);
+                assert(tolerance > 0.);
+            }
+
+            const Float& step_size() const { return _step_size; }
+            std::size_t dimension() const { return _dimension; }
+            const Float& tolerance() const { return _tolerance; }
+            std::size_t steps_per_expansion() const { return _steps_per_expansion; }
+
+            // spectrum [center - half_width, center + half_width] of the last matrix
+            const Float& center() const { return _center; }
+            const Float& half_width() const { return _half_width; }
+            std::uint64_t expansions() const { return _expansions; }
+            std::uint64_t products() const { return _products; }
+
+            void reset()
+            {
+                _has_bounds = false;
+                _pending    = 0;
+            }
+
+            template <typename Scalar, typename Index, typename Offset, typename Vector>
+            void step_imaginary(const types::CompressedRowMatrix<Scalar, Index, Offset>& m,
+                                Vector& u)
+            {
+                assert(types::is_quadratic(m));
+                assert(m.rows() == _dimension);
+                assert(types::MatrixDimensionInfo<Vector>::rows(u) == _dimension);
+
+                if(!_has_bounds) {
+                    estimate_bounds(m);
+                }
+                if(_pending == 0) {
+                    expand(m, u);
+                }
+
+                const auto& state = _states[_steps_per_expansion - _pending];
+                const Index rows  = m.rows();
+#pragma omp parallel for schedule(static)
+                for(Index row = 0; row < rows; ++row) {
+                    u[row] = state[row];
+                }
+                --_pending;
+            }
+
+        private:
+            template <typename Scalar, typename Index, typename Offset>
+            void estimate_bounds(const types::CompressedRowMatrix<Scalar, Index, Offset>& m)
+            {
+                const auto& row_pointers = m.row_pointers();
+                const auto& columns      = m.column_indices();
+                const auto& values       = m.values();
+                const Index rows         = m.rows();
+
+                Float lower = std::numeric_limits<Float>::max(),
+                      upper = std::numeric_limits<Float>::lowest();
+#pragma omp parallel for schedule(static) reduction(min : lower) reduction(max : upper)
+                for(Index row = 0; row < rows; ++row) {
+                    Float diagonal = 0., radius = 0.;
+                    for(Offset i = row_pointers[row]; i < row_pointers[row + 1]; ++i) {
+                        if(columns[i] == row) {
+                            diagonal += values[i];
+                        } else {
+                            radius += std::abs(values[i]);
+                        }
+                    }
+                    lower = std::min(lower, diagonal - radius);
+                    upper = std::max(upper, diagonal + radius);
+                }
+
+                _center     = (upper + lower) / 2;
+                _half_width = std::max((upper - lower) / 2, std::numeric_limits<Float>::min());
+                _has_bounds = true;
+            }
+
+            // coefficients of T_k for the states after 1, ..., steps_per_expansion steps, the
+            // outer index is the order
+            std::vector<std::vector<Value>> coefficients() const
+            {
+                const Float largest = _steps_per_expansion * _step_size * _half_width;
+                std::size_t count   = static_cast<std::size_t>(largest) + 16;
+                std::vector<std::vector<Float>> J;
+                std::size_t order = 0;
+                while(order == 0) {
+                    J.clear();
+                    for(std::size_t s = 1; s <= _steps_per_expansion; ++s) {
+                        J.push_back(bessel_functions(s * _step_size * _half_width, count));
+                    }
+                    // J_k(x) decays faster than exponentially in k beyond x
+                    for(std::size_t k = static_cast<std::size_t>(largest) + 1; k < count; ++k) {
+                        bool converged = true;
+                        for(const auto& values : J) {
+                            converged = converged && (2 * std::abs(values[k]) < _tolerance);
+                        }
+                        if(converged) {
+                            order = k;
+                            break;
+                        }
+                    }
+                    count *= 2;
+                }
+
+                std::vector<std::vector<Value>> c(order, std::vector<Value>(_steps_per_expansion));
+                for(std::size_t s = 0; s < _steps_per_expansion; ++s) {
+                    const Float t     = (s + 1) * _step_size;
+                    const Value phase = std::polar(Float(1.), t * _center);
+                    Value power(1., 0.);
+                    for(std::size_t k = 0; k < order; ++k) {
+                        c[k][s] = phase * power * ((k == 0) ? Float(1.) : Float(2.)) * J[s][k];
+                        power *= Value(0., 1.);
+                    }
+                }
+                return c;
+            }
+
+            template <typename Scalar, typename Index, typename Offset, typename Vector>
+            void expand(const types::CompressedRowMatrix<Scalar, Index, Offset>& m,
+                        const Vector& u)
+            {
+                const auto& row_pointers = m.row_pointers();
+                const auto& columns      = m.column_indices();
+                const auto& values       = m.values();
+                const Index rows         = m.rows();
+                const std::size_t steps  = _steps_per_expansion;
+                const auto c             = coefficients();
+                const Float scale        = 1 / _half_width;
+                const Float shift        = _center / _half_width;
+
+                // T_0 u = u and T_1 u = (m - c) / w * u
+#pragma omp parallel for schedule(static)
+                for(Index row = 0; row < rows; ++row) {
+                    Value product = 0.;
+                    for(Offset i = row_pointers[row]; i < row_pointers[row + 1]; ++i) {
+                        product += values[i] * u[columns[i]];
+                    }
+                    const Value t_0 = u[row];
+                    const Value t_1 = scale * product - shift * t_0;
+                    _previous[row]  = t_0;
+                    _current[row]   = t_1;
+                    for(std::size_t s = 0; s < steps; ++s) {
+                        _states[s][row] =
+                            c[0][s] * t_0 + ((c.size() > 1) ? c[1][s] * t_1 : Value(0.));
+                    }
+                }
+                ++_products;
+
+                // T_{k+1} u = 2 (m - c) / w * T_k u - T_{k-1} u overwrites T_{k-1} u
+                for(std::size_t k = 2; k < c.size(); ++k) {
+                    const auto& coefficient = c[k];
+#pragma omp parallel for schedule(static)
+                    for(Index row = 0; row < rows; ++row) {
+                        Value product = 0.;
+                        for(Offset i = row_pointers[row]; i < row_pointers[row + 1]; ++i) {
+                            product += values[i] * _current[columns[i]];
+                        }
+                        const Value next =
+                            Float(2.) * (scale * product - shift * _current[row]) - _previous[row];
+                        _previous[row] = next;
+                        for(std::size_t s = 0; s < steps; ++s) {
+                            _states[s][row] += coefficient[s] * next;
+                        }
+                    }
+                    _previous.swap(_current);
+                    ++_products;
+                }
+
+                ++_expansions;
+                _pending = steps;
+            }
+        };
+    } // namespace ode
+} // namespace ieompp
+
+#endif
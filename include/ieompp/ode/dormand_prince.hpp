@@ -0,0 +1,217 @@
+#ifndef IEOMPP_ODE_DORMAND_PRINCE_HPP_
+#define IEOMPP_ODE_DORMAND_PRINCE_HPP_
+
+#include "ieompp/types/compressed_row_matrix.hpp"
+#include "ieompp/types/matrix.hpp"
+#include "ieompp/types/matrix_check.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cmath>
+#include <complex>
+#include <cstdint>
+#include <vector>
+
+namespace ieompp
+{
+    namespace ode
+    {
+        // Embedded Runge-Kutta 5(4) integrator of Dormand and Prince for du/dt = i * m * u with a
+        // CompressedRowMatrix m. A call of step_imaginary advances u by step_size(), the interval
+        // between two measurements, with as many internal steps as the error control requires.
+        // The last internal step is shortened to end exactly at the end of the interval, the
+        // step size proposed by the error control is kept for the next call.
+        //
+        // The error of a step is the largest deviation between the fifth and the embedded fourth
+        // order solution relative to absolute_tolerance + relative_tolerance * |u_i|. A step is
+        // accepted if it is at most 1, the next step size is 0.9 * error^(-1/5) times the last
+        // one, limited to the factors 0.2 to 5. The last stage of an accepted step is m times the
+        // new u and is reused as first stage of the next step (first same as last), so a step
+        // costs six matrix vector products. reset() has to be called before integrating another
+        // vector or after u was modified between two calls.
+        template <typename FloatT>
+        class DormandPrince
+        {
+            using Float = FloatT;
+            using Value = std::complex<Float>;
+
+        private:
+            static constexpr std::size_t stages = 7;
+
+            const std::size_t _dimension;
+            const Float _step_size;
+            const Float _absolute_tolerance;
+            const Float _relative_tolerance;
+
+            Float _internal_step_size;
+            bool _first_same_as_last;
+            std::uint64_t _accepted, _rejected, _products;
+            std::array<std::vector<Value>, stages> _k;
+            std::vector<Value> _y;
+
+        public:
+            DormandPrince(std::size_t dimension, const Float& step_size,
+                          const Float& absolute_tolerance, const Float& relative_tolerance)
+                : _dimension(dimension), _step_size(step_size),
+                  _absolute_tolerance(absolute_tolerance), _relative_tolerance(relative_tolerance),
+                  _internal_step_size(step_size), _first_same_as_last(false), _accepted(0),
+                  _rejected(0), _products(0), _y(dimension)
+            {
+                assert(absolute_tolerance > 0. || relative_tolerance > 0.);
+                for(auto& k : _k) {
+                    k.resize(dimension);
+                }
+            }
+
+            const Float& step_size() const { return _step_size; }
+            std::size_t dimension() const { return _dimension; }
+            const Float& absolute_tolerance() const { return _absolute_tolerance; }
+            const Float& relative_tolerance() const { return _relative_tolerance; }
+
+            // step size the next internal step starts with
+            const Float& internal_step_size() const { return _internal_step_size; }
+            std::uint64_t accepted_steps() const { return _accepted; }
+            std::uint64_t rejected_steps() const { return _rejected; }
+            std::uint64_t products() const { return _products; }
+
+            void reset() { _first_same_as_last = false; }
+
+            template <typename Scalar, typename Index, typename Offset, typename Vector>
+            void step_imaginary(const types::CompressedRowMatrix<Scalar, Index, Offset>& m,
+                                Vector& u)
+            {
+                assert(types::is_quadratic(m));
+                assert(m.rows() == _dimension);
+                assert(types::MatrixDimensionInfo<Vector>::rows(u) == _dimension);
+
+                if(!_first_same_as_last) {
+                    multiply(m, u, _k[0]);
+                    _first_same_as_last = true;
+                }
+
+                Float remaining = _step_size;
+                while(remaining > 0.) {
+                    // do not leave a sliver of the interval for an extra step
+                    const bool last = _internal_step_size >= remaining * (1 - 1e-10);
+                    const Float h   = last ? remaining : _internal_step_size;
+                    const Float error = attempt(m, u, h);
+                    const Float factor =
+                        std::min(Float(5.), std::max(Float(0.2), Float(0.9) * std::pow(
+                                                                     error, Float(-0.2))));
+
+                    if(error > 1.) {
+                        ++_rejected;
+                        _internal_step_size = h * std::min(factor, Float(1.));
+                        continue;
+                    }
+
+                    ++_accepted;
+                    const Index rows = m.rows();
+#pragma omp parallel for schedule(static)
+                    for(Index row = 0; row < rows; ++row) {
+                        u[row] = _y[row];
+                    }
+                    std::swap(_k[0], _k[stages - 1]);
+
+                    // a step shortened to the end of the interval does not limit the next one
+                    _internal_step_size =
+                        last ? std::max(_internal_step_size, h * factor) : h * factor;
+                    remaining = last ? 0. : remaining - h;
+                }
+            }
+
+        private:
+            template <typename Scalar, typename Index, typename Offset, typename Vector>
+            void multiply(const types::CompressedRowMatrix<Scalar, Index, Offset>& m,
+                          const Vector& x, std::vector<Value>& result)
+            {
+                const auto& row_pointers = m.row_pointers();
+                const auto& columns      = m.column_indices();
+                const auto& values       = m.values();
+                const Index rows         = m.rows();
+#pragma omp parallel for schedule(static)
+                for(Index row = 0; row < rows; ++row) {
+                    Value sum = 0.;
+                    for(Offset i = row_pointers[row]; i < row_pointers[row + 1]; ++i) {
+                        sum += values[i] * x[columns[i]];
+                    }
+                    result[row] = sum;
+                }
+                ++_products;
+            }
+
+            // Computes the stages of a step of size h starting from u with the first stage in
+            // _k[0], leaves the fifth order solution in _y and m times it in _k[6] and returns the
+            // scaled error.
+            template <typename Scalar, typename Index, typename Offset, typename Vector>
+            Float attempt(const types::CompressedRowMatrix<Scalar, Index, Offset>& m,
+                          const Vector& u, const Float& h)
+            {
+                // rows of the Butcher tableau, the last one holds the fifth order weights
+                static const Float a[stages][stages - 1] = {
+                    {0., 0., 0., 0., 0., 0.},
+                    {1. / 5, 0., 0., 0., 0., 0.},
+                    {3. / 40, 9. / 40, 0., 0., 0., 0.},
+                    {44. / 45, -56. / 15, 32. / 9, 0., 0., 0.},
+                    {19372. / 6561, -25360. / 2187, 64448. / 6561, -212. / 729, 0., 0.},
+                    {9017. / 3168, -355. / 33, 46732. / 5247, 49. / 176, -5103. / 18656, 0.},
+                    {35. / 384, 0., 500. / 1113, 125. / 192, -2187. / 6784, 11. / 84}};
+                // differences between the fifth and the fourth order weights
+                static const Float e[stages] = {71. / 57600,      0.,         -71. / 16695,
+                                                71. / 1920,       -17253. / 339200,
+                                                22. / 525,        -1. / 40};
+
+                const auto& row_pointers = m.row_pointers();
+                const auto& columns      = m.column_indices();
+                const auto& values       = m.values();
+                const Index rows         = m.rows();
+
+                for(std::size_t s = 1; s < stages; ++s) {
+                    std::array<Value, stages - 1> c;
+                    for(std::size_t j = 0; j < s; ++j) {
+                        c[j] = Value(0, h * a[s][j]);
+                    }
+#pragma omp parallel for schedule(static)
+                    for(Index row = 0; row < rows; ++row) {
+                        Value y = u[row];
+                        for(std::size_t j = 0; j < s; ++j) {
+                            y += c[j] * _k[j][row];
+                        }
+                        _y[row] = y;
+                    }
+
+                    if(s + 1 < stages) {
+                        multiply(m, _y, _k[s]);
+                        continue;
+                    }
+
+                    // the last stage is computed together with the error of its row
+                    Float error = 0.;
+#pragma omp parallel for schedule(static) reduction(max : error)
+                    for(Index row = 0; row < rows; ++row) {
+                        Value k = 0.;
+                        for(Offset i = row_pointers[row]; i < row_pointers[row + 1]; ++i) {
+                            k += values[i] * _y[columns[i]];
+                        }
+                        _k[s][row] = k;
+
+                        Value deviation = 0.;
+                        for(std::size_t j = 0; j < stages; ++j) {
+                            deviation += e[j] * _k[j][row];
+                        }
+                        const Float scale =
+                            _absolute_tolerance
+                            + _relative_tolerance * std::max(std::abs(u[row]), std::abs(_y[row]));
+                        error = std::max(error, h * std::abs(deviation) / scale);
+                    }
+                    ++_products;
+                    return error;
+                }
+                return 0.;
+            }
+        };
+    } // namespace ode
+} // namespace ieompp
+
+#endif
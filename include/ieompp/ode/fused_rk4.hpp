@@ -0,0 +1,121 @@
+#ifndef IEOMPP_ODE_FUSED_RK4_HPP_
+#define IEOMPP_ODE_FUSED_RK4_HPP_
+
+#include "ieompp/types/compressed_row_matrix.hpp"
+#include "ieompp/types/matrix.hpp"
+#include "ieompp/types/matrix_check.hpp"
+
+#include <cassert>
+#include <complex>
+#include <vector>
+
+namespace ieompp
+{
+    namespace ode
+    {
+        // stage vectors of FusedRK4 for vectors of the given dimension, a workspace can be shared
+        // by integrators that do not step at the same time
+        template <typename FloatT>
+        struct RK4Workspace {
+            using Float = FloatT;
+            using Value = std::complex<Float>;
+
+            std::vector<Value> k_1, k_2, k_3;
+
+            explicit RK4Workspace(std::size_t dimension)
+                : k_1(dimension), k_2(dimension), k_3(dimension)
+            {
+            }
+
+            std::size_t dimension() const { return k_1.size(); }
+        };
+
+        // RK4 integrator for du/dt = i * m * u with a CompressedRowMatrix m. It allocates nothing
+        // after its construction and keeps no static state, so independent integrators can step
+        // at the same time. Stage s computes k_s = m * (u + c_s k_{s-1}) in one sweep over m as
+        // k_1 + c_s * m * k_{s-1} without forming the argument as a vector, k_1 = m * u is read
+        // contiguously from the first stage. Since the later stages do not read u, each of them
+        // adds its contribution h/6 * w_s * k_s with the weights 1, 2, 2, 1 to u in the same
+        // sweep, k_4 is not stored.
+        template <typename FloatT>
+        class FusedRK4
+        {
+            using Float = FloatT;
+
+        public:
+            using Workspace = RK4Workspace<Float>;
+
+        private:
+            const Float _step_size;
+            Workspace _workspace;
+
+        public:
+            FusedRK4(std::size_t dimension, const Float& step_size)
+                : _step_size(step_size), _workspace(dimension)
+            {
+            }
+
+            const Float& step_size() const { return _step_size; }
+            std::size_t dimension() const { return _workspace.dimension(); }
+
+            template <typename Scalar, typename Index, typename Offset, typename Vector>
+            void step_imaginary(const types::CompressedRowMatrix<Scalar, Index, Offset>& m,
+                                Vector& u)
+            {
+                step_imaginary(m, u, _workspace);
+            }
+
+            // step with the stage vectors of workspace instead of the own ones
+            template <typename Scalar, typename Index, typename Offset, typename Vector>
+            void step_imaginary(const types::CompressedRowMatrix<Scalar, Index, Offset>& m,
+                                Vector& u, Workspace& workspace) const
+            {
+                assert(types::is_quadratic(m));
+                assert(m.rows() == workspace.dimension());
+                assert(types::MatrixDimensionInfo<Vector>::rows(u) == workspace.dimension());
+
+                using Value = std::complex<Float>;
+                const Value half_step(0, _step_size / 2), full_step(0, _step_size),
+                    sixth_step(0, _step_size / 6);
+
+                const auto& row_pointers = m.row_pointers();
+                const auto& columns      = m.column_indices();
+                const auto& values       = m.values();
+                const Index rows         = m.rows();
+                const auto& k_1          = workspace.k_1;
+
+#pragma omp parallel for schedule(static)
+                for(Index row = 0; row < rows; ++row) {
+                    Value k = 0.;
+                    for(Offset i = row_pointers[row]; i < row_pointers[row + 1]; ++i) {
+                        k += values[i] * u[columns[i]];
+                    }
+                    workspace.k_1[row] = k;
+                }
+
+                // k = k_1 + coefficient * m * previous is stored in current unless it is null,
+                // u is increased by h/6 * (weight * k + k_1 if first)
+                const auto stage = [&](const std::vector<Value>& previous, const Value& coefficient,
+                                       std::vector<Value>* current, Float weight, bool first) {
+#pragma omp parallel for schedule(static)
+                    for(Index row = 0; row < rows; ++row) {
+                        Value mk = 0.;
+                        for(Offset i = row_pointers[row]; i < row_pointers[row + 1]; ++i) {
+                            mk += values[i] * previous[columns[i]];
+                        }
+                        const Value k = k_1[row] + coefficient * mk;
+                        if(current != nullptr) {
+                            (*current)[row] = k;
+                        }
+                        u[row] += sixth_step * (first ? weight * k + k_1[row] : weight * k);
+                    }
+                };
+                stage(workspace.k_1, half_step, &workspace.k_2, 2., true);
+                stage(workspace.k_2, half_step, &workspace.k_3, 2., false);
+                stage(workspace.k_3, full_step, nullptr, 1., false);
+            }
+        };
+    } // namespace ode
+} // namespace ieompp
+
+#endif
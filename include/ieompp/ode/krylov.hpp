@@ -0,0 +1,295 @@
+#ifndef IEOMPP_ODE_KRYLOV_HPP_
+#define IEOMPP_ODE_KRYLOV_HPP_
+
+#include "ieompp/types/compressed_row_matrix.hpp"
+#include "ieompp/types/matrix.hpp"
+#include "ieompp/types/matrix_check.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <complex>
+#include <cstdint>
+#include <vector>
+
+namespace ieompp
+{
+    namespace ode
+    {
+        // Propagator u -> exp(c t m) u for a time independent CompressedRowMatrix m (c = 1 for
+        // step, c = i for step_imaginary) in a Krylov subspace. A call advances u by step_size()
+        // in substeps: each substep spans the Krylov space of u with krylov_dimension products,
+        // u(tau) = |u| V exp(c tau H) e_1 with the orthonormal basis V and the projection H of m.
+        //
+        // The error of a substep is estimated a posteriori by |u| * tau * h_{k+1,k} *
+        // |e_k^T phi_1(c tau H) e_1|, which is read off the exponential of H augmented by the row
+        // h_{k+1,k} e_k^T. A substep is accepted if the estimate is at most tolerance * tau /
+        // step_size(), so the error of a whole step stays below tolerance. Otherwise tau is
+        // reduced and only the small exponential is recomputed, the Krylov space does not depend
+        // on tau. The next substep starts with 0.9 * (allowed / estimate)^(1/k) times the last
+        // tau, limited to the factors 0.2 to 5.
+        //
+        // For a Hermitian m (as the real symmetric Liouvillian matrices) the basis is built by the
+        // Lanczos recurrence, each new vector is only orthogonalized against the last two.
+        // Otherwise the full Arnoldi orthogonalization is used. The krylov_dimension + 1 basis
+        // vectors are allocated once.
+        template <typename FloatT>
+        class Krylov
+        {
+            using Float = FloatT;
+            using Value = std::complex<Float>;
+
+        private:
+            const std::size_t _dimension;
+            const Float _step_size;
+            const std::size_t _krylov_dimension;
+            const Float _tolerance;
+            const bool _hermitian;
+
+            Float _substep_size;
+            std::uint64_t _substeps, _rejected, _products;
+            std::vector<std::vector<Value>> _basis;
+            // Hessenberg matrix, (krylov_dimension + 1) x krylov_dimension in row major order
+            std::vector<Value> _hessenberg;
+            std::vector<Value> _exponential, _power, _temp, _product;
+
+        public:
+            Krylov(std::size_t dimension, const Float& step_size, std::size_t krylov_dimension,
+                   const Float& tolerance, bool hermitian = true)
+                : _dimension(dimension), _step_size(step_size),
+                  _krylov_dimension(krylov_dimension), _tolerance(tolerance),
+                  _hermitian(hermitian), _substep_size(step_size), _substeps(0), _rejected(0),
+                  _products(0), _basis(krylov_dimension + 1, std::vector<Value>(dimension)),
+                  _hessenberg((krylov_dimension + 1) * krylov_dimension)
+            {
+                assert(krylov_dimension > 0);
+                assert(tolerance > 0.);
+            }
+
+            const Float& step_size() const { return _step_size; }
+            std::size_t dimension() const { return _dimension; }
+            std::size_t krylov_dimension() const { return _krylov_dimension; }
+            const Float& tolerance() const { return _tolerance; }
+
+            // size the next substep starts with
+            const Float& substep_size() const { return _substep_size; }
+            std::uint64_t substeps() const { return _substeps; }
+            std::uint64_t rejected_substeps() const { return _rejected; }
+            std::uint64_t products() const { return _products; }
+
+            template <typename Scalar, typename Index, typename Offset, typename Vector>
+            void step(const types::CompressedRowMatrix<Scalar, Index, Offset>& m, Vector& u)
+            {
+                propagate(m, u, Value(1, 0));
+            }
+
+            template <typename Scalar, typename Index, typename Offset, typename Vector>
+            void step_imaginary(const types::CompressedRowMatrix<Scalar, Index, Offset>& m,
+                                Vector& u)
+            {
+                propagate(m, u, Value(0, 1));
+            }
+
+        private:
+            template <typename Scalar, typename Index, typename Offset, typename Vector>
+            void propagate(const types::CompressedRowMatrix<Scalar, Index, Offset>& m, Vector& u,
+                           const Value& c)
+            {
+                assert(types::is_quadratic(m));
+                assert(m.rows() == _dimension);
+                assert(types::MatrixDimensionInfo<Vector>::rows(u) == _dimension);
+
+                const Index rows = m.rows();
+                Float remaining  = _step_size;
+                while(remaining > 0.) {
+                    const Float norm = std::sqrt(norm_squared(u, rows));
+                    if(norm == 0.) {
+                        return;
+                    }
+#pragma omp parallel for schedule(static)
+                    for(Index row = 0; row < rows; ++row) {
+                        _basis[0][row] = u[row] / norm;
+                    }
+                    const auto size = span(m);
+
+                    // after a breakdown the Krylov space is invariant and the substep exact
+                    const bool invariant = (size < _krylov_dimension);
+                    bool last            = invariant || (_substep_size >= remaining * (1 - 1e-10));
+                    Float tau            = last ? remaining : _substep_size;
+                    while(true) {
+                        const Float error   = norm * exponential(size, c * tau, invariant);
+                        const Float allowed = _tolerance * tau / _step_size;
+                        const Float factor  = std::min(
+                            Float(5.),
+                            std::max(Float(0.2), Float(0.9) * std::pow(allowed / error,
+                                                                       Float(1.) / size)));
+                        if(error <= allowed) {
+                            _substep_size =
+                                last ? std::max(_substep_size, tau * factor) : tau * factor;
+                            break;
+                        }
+                        ++_rejected;
+                        tau  = tau * std::min(factor, Float(0.9));
+                        last = false;
+                    }
+                    ++_substeps;
+
+                    // u = |u| V y with the first column y of the exponential
+#pragma omp parallel for schedule(static)
+                    for(Index row = 0; row < rows; ++row) {
+                        Value sum = 0.;
+                        for(std::size_t j = 0; j < size; ++j) {
+                            sum += _exponential[j * (size + 1)] * _basis[j][row];
+                        }
+                        u[row] = norm * sum;
+                    }
+                    remaining = last ? 0. : remaining - tau;
+                }
+            }
+
+            template <typename Vector, typename Index>
+            static Float norm_squared(const Vector& x, Index rows)
+            {
+                Float sum = 0.;
+#pragma omp parallel for schedule(static) reduction(+ : sum)
+                for(Index row = 0; row < rows; ++row) {
+                    sum += std::norm(x[row]);
+                }
+                return sum;
+            }
+
+            // Builds the basis from _basis[0] and the Hessenberg matrix, returns the dimension of
+            // the Krylov space which is smaller than krylov_dimension after a breakdown.
+            template <typename Scalar, typename Index, typename Offset>
+            std::size_t span(const types::CompressedRowMatrix<Scalar, Index, Offset>& m)
+            {
+                const auto& row_pointers = m.row_pointers();
+                const auto& columns      = m.column_indices();
+                const auto& values       = m.values();
+                const Index rows         = m.rows();
+                const std::size_t k      = _krylov_dimension;
+
+                std::fill(_hessenberg.begin(), _hessenberg.end(), Value(0.));
+                for(std::size_t j = 0; j < k; ++j) {
+                    const auto& v = _basis[j];
+                    auto& w       = _basis[j + 1];
+#pragma omp parallel for schedule(static)
+                    for(Index row = 0; row < rows; ++row) {
+                        Value sum = 0.;
+                        for(Offset i = row_pointers[row]; i < row_pointers[row + 1]; ++i) {
+                            sum += values[i] * v[columns[i]];
+                        }
+                        w[row] = sum;
+                    }
+                    ++_products;
+
+                    // modified Gram-Schmidt
+                    Float column = 0.;
+                    for(std::size_t i = (_hermitian && j > 0) ? j - 1 : 0; i <= j; ++i) {
+                        const auto& b = _basis[i];
+                        Float re = 0., im = 0.;
+#pragma omp parallel for schedule(static) reduction(+ : re, im)
+                        for(Index row = 0; row < rows; ++row) {
+                            const Value product = std::conj(b[row]) * w[row];
+                            re += product.real();
+                            im += product.imag();
+                        }
+                        const Value h(re, im);
+                        _hessenberg[i * k + j] = h;
+                        column += std::abs(h);
+#pragma omp parallel for schedule(static)
+                        for(Index row = 0; row < rows; ++row) {
+                            w[row] -= h * b[row];
+                        }
+                    }
+
+                    const Float h = std::sqrt(norm_squared(w, rows));
+                    _hessenberg[(j + 1) * k + j] = h;
+                    // happy breakdown, the Krylov space is invariant under m
+                    if(h <= 1e-12 * column) {
+                        return j + 1;
+                    }
+#pragma omp parallel for schedule(static)
+                    for(Index row = 0; row < rows; ++row) {
+                        w[row] /= h;
+                    }
+                }
+                return k;
+            }
+
+            // Computes exp(A) of A = factor * [[H, 0], [h_{size+1,size} e_size^T, 0]] into
+            // _exponential by scaling and squaring of the Taylor series and returns the error
+            // estimate |exp(A)_{size,0}| of the substep for a unit vector. The augmented row is
+            // left out for an invariant Krylov space.
+            Float exponential(std::size_t size, const Value& factor, bool invariant)
+            {
+                const std::size_t n = size + 1, k = _krylov_dimension;
+                _exponential.assign(n * n, Value(0.));
+                _power.assign(n * n, Value(0.));
+                _temp.assign(n * n, Value(0.));
+                _product.resize(n * n);
+
+                for(std::size_t i = 0; i < size; ++i) {
+                    for(std::size_t j = 0; j < size; ++j) {
+                        _temp[i * n + j] = factor * _hessenberg[i * k + j];
+                    }
+                }
+                if(!invariant) {
+                    _temp[size * n + size - 1] = factor * _hessenberg[size * k + size - 1];
+                }
+
+                // scale to a 1-norm of at most 1/2, then 18 terms are exact to machine precision
+                Float one_norm = 0.;
+                for(std::size_t j = 0; j < n; ++j) {
+                    Float column = 0.;
+                    for(std::size_t i = 0; i < n; ++i) {
+                        column += std::abs(_temp[i * n + j]);
+                    }
+                    one_norm = std::max(one_norm, column);
+                }
+                int squarings = 0;
+                if(one_norm > 0.5) {
+                    squarings = static_cast<int>(std::ceil(std::log2(one_norm / 0.5)));
+                }
+                const Float scale = std::ldexp(Float(1.), -squarings);
+                for(auto& x : _temp) {
+                    x *= scale;
+                }
+
+                for(std::size_t i = 0; i < n; ++i) {
+                    _exponential[i * n + i] = 1.;
+                    _power[i * n + i]       = 1.;
+                }
+                for(int term = 1; term <= 18; ++term) {
+                    multiply(_power, _temp, _product, n);
+                    for(std::size_t i = 0; i < n * n; ++i) {
+                        _power[i] = _product[i] / Float(term);
+                        _exponential[i] += _power[i];
+                    }
+                }
+                for(int i = 0; i < squarings; ++i) {
+                    multiply(_exponential, _exponential, _product, n);
+                    _exponential.swap(_product);
+                }
+
+                return invariant ? Float(0.) : std::abs(_exponential[size * n]);
+            }
+
+            static void multiply(const std::vector<Value>& a, const std::vector<Value>& b,
+                                 std::vector<Value>& c, std::size_t n)
+            {
+                for(std::size_t i = 0; i < n; ++i) {
+                    for(std::size_t j = 0; j < n; ++j) {
+                        Value sum = 0.;
+                        for(std::size_t l = 0; l < n; ++l) {
+                            sum += a[i * n + l] * b[l * n + j];
+                        }
+                        c[i * n + j] = sum;
+                    }
+                }
+            }
+        };
+    } // namespace ode
+} // namespace ieompp
+
+#endif
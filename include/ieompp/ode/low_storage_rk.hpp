@@ -0,0 +1,109 @@
+#ifndef IEOMPP_ODE_LOW_STORAGE_RK_HPP_
+#define IEOMPP_ODE_LOW_STORAGE_RK_HPP_
+
+#include "ieompp/types/compressed_row_matrix.hpp"
+#include "ieompp/types/matrix.hpp"
+#include "ieompp/types/matrix_check.hpp"
+
+#include <cassert>
+#include <complex>
+#include <vector>
+
+namespace ieompp
+{
+    namespace ode
+    {
+        // Coefficients of a Williamson 2N-storage Runge-Kutta scheme, stage s computes
+        // du = A_s du + h f(u) and u += B_s du with A_1 = 0
+        template <typename Float>
+        struct LowStorageTableau {
+            std::vector<Float> A, B;
+
+            std::size_t stages() const { return A.size(); }
+
+            // third order, three stages (Williamson 1980)
+            static LowStorageTableau williamson_3()
+            {
+                return LowStorageTableau{{0., -5. / 9, -153. / 128}, {1. / 3, 15. / 16, 8. / 15}};
+            }
+
+            // fourth order, five stages (Carpenter and Kennedy 1994, solution 3)
+            static LowStorageTableau carpenter_kennedy_4()
+            {
+                return LowStorageTableau{
+                    {0., -567301805773. / 1357537059087, -2404267990393. / 2016746695238,
+                     -3550918686646. / 2091501179385, -1275806237668. / 842570457699},
+                    {1432997174477. / 9575080441755, 5161836677717. / 13612068292357,
+                     1720146321549. / 2090206949498, 3134564353537. / 4481467310338,
+                     2277821191437. / 14882151754819}};
+            }
+        };
+
+        // Runge-Kutta integrator for du/dt = i * m * u with a CompressedRowMatrix m that keeps
+        // only u and one register du of the dimension of u. The product of a stage is added to
+        // the scaled register in the same sweep over m, u is updated in a second pass since the
+        // product of the next stage reads all of it.
+        template <typename FloatT>
+        class LowStorageRK
+        {
+            using Float = FloatT;
+            using Value = std::complex<Float>;
+
+        public:
+            using Tableau = LowStorageTableau<Float>;
+
+        private:
+            const Float _step_size;
+            const Tableau _tableau;
+            std::vector<Value> _du;
+
+        public:
+            LowStorageRK(std::size_t dimension, const Float& step_size,
+                         const Tableau& tableau = Tableau::carpenter_kennedy_4())
+                : _step_size(step_size), _tableau(tableau), _du(dimension)
+            {
+                assert(!tableau.A.empty() && tableau.A.size() == tableau.B.size());
+                assert(tableau.A[0] == 0.);
+            }
+
+            const Float& step_size() const { return _step_size; }
+            std::size_t dimension() const { return _du.size(); }
+            const Tableau& tableau() const { return _tableau; }
+
+            template <typename Scalar, typename Index, typename Offset, typename Vector>
+            void step_imaginary(const types::CompressedRowMatrix<Scalar, Index, Offset>& m,
+                                Vector& u)
+            {
+                assert(types::is_quadratic(m));
+                assert(m.rows() == _du.size());
+                assert(types::MatrixDimensionInfo<Vector>::rows(u) == _du.size());
+
+                const auto& row_pointers = m.row_pointers();
+                const auto& columns      = m.column_indices();
+                const auto& values       = m.values();
+                const Index rows         = m.rows();
+                const Value step(0, _step_size);
+
+                for(std::size_t s = 0; s < _tableau.stages(); ++s) {
+                    // A_1 = 0, the register of the last step is not read
+                    const Float a    = _tableau.A[s], b = _tableau.B[s];
+                    const bool first = (s == 0);
+#pragma omp parallel for schedule(static)
+                    for(Index row = 0; row < rows; ++row) {
+                        Value product = 0.;
+                        for(Offset i = row_pointers[row]; i < row_pointers[row + 1]; ++i) {
+                            product += values[i] * u[columns[i]];
+                        }
+                        _du[row] = (first ? Value(0.) : a * _du[row]) + step * product;
+                    }
+#pragma omp parallel for schedule(static)
+                    for(Index row = 0; row < rows; ++row) {
+                        u[row] += b * _du[row];
+                    }
+                }
+            }
+        };
+    } // namespace ode
+} // namespace ieompp
+
+#endif
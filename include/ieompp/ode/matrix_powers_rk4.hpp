@@ -0,0 +1,68 @@
+#ifndef IEOMPP_ODE_MATRIX_POWERS_RK4_HPP_
+#define IEOMPP_ODE_MATRIX_POWERS_RK4_HPP_
+
+#include "ieompp/types/matrix.hpp"
+#include "ieompp/types/matrix_check.hpp"
+#include "ieompp/types/matrix_powers.hpp"
+
+#include <array>
+#include <cassert>
+#include <complex>
+#include <vector>
+
+namespace ieompp
+{
+    namespace ode
+    {
+        // RK4 integrator for du/dt = i * m * u with a MatrixPowers m. For a constant matrix the
+        // RK4 step is the Taylor polynomial u + sum_{k=1}^{4} (i h)^k / k! * m^k * u, whose four
+        // products are computed by the matrix-powers kernel in a single sweep over m. The powers
+        // are kept by the integrator, which allocates nothing after its construction.
+        template <typename FloatT>
+        class MatrixPowersRK4
+        {
+            using Float = FloatT;
+            using Value = std::complex<Float>;
+
+        private:
+            const Float _step_size;
+            std::array<std::vector<Value>, 4> _powers;
+
+        public:
+            MatrixPowersRK4(std::size_t dimension, const Float& step_size)
+                : _step_size(step_size)
+            {
+                for(auto& power : _powers) {
+                    power.resize(dimension);
+                }
+            }
+
+            const Float& step_size() const { return _step_size; }
+            std::size_t dimension() const { return _powers[0].size(); }
+
+            template <typename Scalar, typename Index, typename Offset, typename Vector>
+            void step_imaginary(const types::MatrixPowers<Scalar, Index, Offset>& m, Vector& u)
+            {
+                assert(types::is_quadratic(m));
+                assert(m.rows() == dimension());
+                assert(types::MatrixDimensionInfo<Vector>::columns(u) == 1);
+                assert(types::MatrixDimensionInfo<Vector>::rows(u) == dimension());
+
+                const Float h = _step_size;
+                const Value c_1(0, h), c_2(-h * h / 2, 0), c_3(0, -h * h * h / 6),
+                    c_4(h * h * h * h / 24, 0);
+
+                m.powers(u, _powers);
+
+                const std::size_t size = dimension();
+#pragma omp parallel for schedule(static)
+                for(std::size_t i = 0; i < size; ++i) {
+                    u[i] += c_1 * _powers[0][i] + c_2 * _powers[1][i] + c_3 * _powers[2][i]
+                            + c_4 * _powers[3][i];
+                }
+            }
+        };
+    } // namespace ode
+} // namespace ieompp
+
+#endif
@@ -72,6 +72,61 @@ namespace ieompp
 
                 u += (_step_size / 6) * (k_1 + 2. * k_2 + 2. * k_3 + k_4);
             }
+
+            // Integrate du/dt = i * m * u for a real matrix m and a complex vector u. The stages
+            // store m * y only, the imaginary unit is folded into the step size coefficients so m
+            // never has to be stored as a complex matrix.
+            template <typename Matrix, typename Vector>
+            typename std::enable_if<!types::is_function_matrix<Matrix>::value, void>::type
+            step_imaginary(const Matrix& m, Vector& u) const
+            {
+                assert(types::is_quadratic(m));
+                assert(types::MatrixDimensionInfo<Matrix>::rows(m) == _dimension);
+                assert(types::MatrixDimensionInfo<Vector>::columns(u) == 1);
+                assert(types::MatrixDimensionInfo<Vector>::rows(u) == _dimension);
+
+                using Scalar = typename types::ScalarType<Vector>::Type;
+                const Scalar half_step(0, _step_size / 2), full_step(0, _step_size),
+                    sixth_step(0, _step_size / 6);
+
+                static Vector k_1, k_2, k_3, k_4;
+
+                k_1 = m * u;
+                k_2 = m * (u + half_step * k_1);
+                k_3 = m * (u + half_step * k_2);
+                k_4 = m * (u + full_step * k_3);
+                u += sixth_step * (k_1 + 2. * k_2 + 2. * k_3 + k_4);
+            }
+
+            template <typename Matrix, typename Vector>
+            typename std::enable_if<types::is_function_matrix<Matrix>::value, void>::type
+            step_imaginary(const Matrix& m, Vector& u) const
+            {
+                assert(types::is_quadratic(m));
+                assert(types::MatrixDimensionInfo<Matrix>::rows(m) == _dimension);
+                assert(types::MatrixDimensionInfo<Vector>::columns(u) == 1);
+                assert(types::MatrixDimensionInfo<Vector>::rows(u) == _dimension);
+
+                using Scalar = typename types::ScalarType<Vector>::Type;
+                const Scalar half_step(0, _step_size / 2), full_step(0, _step_size),
+                    sixth_step(0, _step_size / 6);
+
+                static Vector k_1, k_2, k_3, k_4;
+
+                k_1 = u;
+                types::multiply_assign(m, k_1);
+
+                k_2 = u + half_step * k_1;
+                types::multiply_assign(m, k_2);
+
+                k_3 = u + half_step * k_2;
+                types::multiply_assign(m, k_3);
+
+                k_4 = u + full_step * k_3;
+                types::multiply_assign(m, k_4);
+
+                u += sixth_step * (k_1 + 2. * k_2 + 2. * k_3 + k_4);
+            }
         };
     } // namespace ode
 } // namespace ieompp
@@ -0,0 +1,269 @@
+#ifndef IEOMPP_TYPES_COMPRESSED_ROW_MATRIX_HPP_
+#define IEOMPP_TYPES_COMPRESSED_ROW_MATRIX_HPP_
+
+#include "ieompp/exception.hpp"
+#include "ieompp/types/function_matrix.hpp"
+#include "ieompp/types/matrix.hpp"
+#include "ieompp/types/multiply_assign.hpp"
+#include "ieompp/types/row_assembly.hpp"
+
+#include <cassert>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace ieompp
+{
+    namespace types
+    {
+        // iterator over the non-zero elements of one row of a CompressedRowMatrix, mimics the
+        // element access of blaze::CompressedMatrix (it->index(), it->value())
+        template <typename ScalarPointer, typename Index>
+        class CompressedRowIterator
+        {
+        private:
+            const Index* _column;
+            ScalarPointer _value;
+
+        public:
+            CompressedRowIterator(const Index* column, ScalarPointer value)
+                : _column(column), _value(value)
+            {
+            }
+
+            Index index() const { return *_column; }
+            decltype(*ScalarPointer()) value() const { return *_value; }
+
+            const CompressedRowIterator* operator->() const { return this; }
+            const CompressedRowIterator& operator*() const { return *this; }
+
+            CompressedRowIterator& operator++()
+            {
+                ++_column;
+                ++_value;
+                return *this;
+            }
+
+            bool operator==(const CompressedRowIterator& rhs) const
+            {
+                return _column == rhs._column;
+            }
+            bool operator!=(const CompressedRowIterator& rhs) const
+            {
+                return _column != rhs._column;
+            }
+        };
+
+        // Row-major sparse matrix with compact column indices. Index has to be able to hold the
+        // number of columns, Offset the number of non-zero elements. The matrix is filled like a
+        // blaze::CompressedMatrix via resize/reset/reserve/append/finalize, rows have to be
+        // finalized in order and the elements of a row appended with increasing column index.
+        // Alternatively it takes over the arrays of rows assembled by assemble_rows_parallel.
+        template <typename ScalarT, typename IndexT = std::uint32_t, typename OffsetT = std::size_t>
+        class CompressedRowMatrix
+        {
+        public:
+            using Scalar = ScalarT;
+            using Index  = IndexT;
+            using Offset = OffsetT;
+
+            using Iterator      = CompressedRowIterator<Scalar*, Index>;
+            using ConstIterator = CompressedRowIterator<const Scalar*, Index>;
+
+        private:
+            Index _rows, _columns;
+            std::vector<Offset> _row_pointers;
+            std::vector<Index> _column_indices;
+            std::vector<Scalar> _values;
+
+            void assign_row_pointers(std::vector<std::size_t>&& row_pointers, std::true_type)
+            {
+                _row_pointers = std::move(row_pointers);
+            }
+            void assign_row_pointers(std::vector<std::size_t>&& row_pointers, std::false_type)
+            {
+                _row_pointers.assign(row_pointers.begin(), row_pointers.end());
+            }
+
+        public:
+            CompressedRowMatrix() : _rows(0), _columns(0), _row_pointers(1, 0) {}
+
+            CompressedRowMatrix(std::size_t rows, std::size_t columns) : CompressedRowMatrix()
+            {
+                resize(rows, columns);
+            }
+
+            // the row pointers are only copied if Offset is not std::size_t
+            CompressedRowMatrix(std::size_t rows, std::size_t columns,
+                                CompressedRows<Scalar, Index>&& assembled)
+                : CompressedRowMatrix(rows, columns)
+            {
+                assert(assembled.row_pointers.size() == rows + 1);
+                if(assembled.non_zeros() > std::numeric_limits<Offset>::max()) {
+                    THROW(Exception, "Number of non-zeros exceeds the range of the offset type");
+                }
+                assign_row_pointers(std::move(assembled.row_pointers),
+                                    std::is_same<Offset, std::size_t>());
+                _column_indices = std::move(assembled.columns);
+                _values         = std::move(assembled.values);
+            }
+
+            Index rows() const { return _rows; }
+            Index columns() const { return _columns; }
+            Offset non_zeros() const { return _values.size(); }
+
+            const std::vector<Offset>& row_pointers() const { return _row_pointers; }
+            const std::vector<Index>& column_indices() const { return _column_indices; }
+            const std::vector<Scalar>& values() const { return _values; }
+
+            // the content is always discarded, the flag only exists for compatibility with the
+            // blaze interface
+            void resize(std::size_t rows, std::size_t columns, bool preserve = true)
+            {
+                static_cast<void>(preserve);
+                if((rows > std::numeric_limits<Index>::max())
+                   || (columns > std::numeric_limits<Index>::max())) {
+                    THROW(Exception, "Matrix dimensions exceed the range of the index type");
+                }
+                _rows    = rows;
+                _columns = columns;
+                reset();
+            }
+
+            void reset()
+            {
+                _row_pointers.assign(1, 0);
+                _column_indices.clear();
+                _values.clear();
+            }
+
+            void reserve(std::size_t non_zeros)
+            {
+                if(non_zeros > std::numeric_limits<Offset>::max()) {
+                    THROW(Exception, "Number of non-zeros exceeds the range of the offset type");
+                }
+                _row_pointers.reserve(_rows + 1);
+                _column_indices.reserve(non_zeros);
+                _values.reserve(non_zeros);
+            }
+
+            void append(std::size_t row, std::size_t column, const Scalar& value)
+            {
+                static_cast<void>(row);
+                assert(row + 1 == _row_pointers.size());
+                assert(column < _columns);
+                assert((_column_indices.size() == _row_pointers.back())
+                       || (_column_indices.back() < column));
+                _column_indices.push_back(column);
+                _values.push_back(value);
+            }
+
+            void finalize(std::size_t row)
+            {
+                static_cast<void>(row);
+                assert(row + 1 == _row_pointers.size());
+                assert(row < _rows);
+                _row_pointers.push_back(_values.size());
+            }
+
+            Iterator begin(std::size_t row)
+            {
+                const auto offset = _row_pointers[row];
+                return Iterator(_column_indices.data() + offset, _values.data() + offset);
+            }
+            Iterator end(std::size_t row)
+            {
+                const auto offset = _row_pointers[row + 1];
+                return Iterator(_column_indices.data() + offset, _values.data() + offset);
+            }
+            ConstIterator begin(std::size_t row) const
+            {
+                const auto offset = _row_pointers[row];
+                return ConstIterator(_column_indices.data() + offset, _values.data() + offset);
+            }
+            ConstIterator end(std::size_t row) const
+            {
+                const auto offset = _row_pointers[row + 1];
+                return ConstIterator(_column_indices.data() + offset, _values.data() + offset);
+            }
+
+            // y = matrix * x, the element type of the vectors may differ from Scalar (e.g. a real
+            // matrix applied to a complex vector)
+            template <typename Vector>
+            void multiply(const Vector& x, Vector& y) const
+            {
+                assert(_row_pointers.size() == std::size_t(_rows) + 1);
+                assert(x.size() == _columns);
+                assert(y.size() == _rows);
+
+                using Value = typename ScalarType<Vector>::Type;
+
+                const Index rows = _rows;
+#pragma omp parallel for schedule(static)
+                for(Index row = 0; row < rows; ++row) {
+                    Value sum = 0.;
+                    for(Offset pos = _row_pointers[row]; pos < _row_pointers[row + 1]; ++pos) {
+                        sum += _values[pos] * x[_column_indices[pos]];
+                    }
+                    y[row] = sum;
+                }
+            }
+        };
+
+        template <typename Scalar, typename Index, typename Offset>
+        struct IsMatrix<CompressedRowMatrix<Scalar, Index, Offset>> {
+            static constexpr bool value = true;
+        };
+
+        template <typename Scalar, typename Index, typename Offset>
+        struct is_function_matrix<CompressedRowMatrix<Scalar, Index, Offset>> {
+            static constexpr bool value = true;
+        };
+
+        template <typename Scalar, typename Index, typename Offset>
+        struct ScalarType<CompressedRowMatrix<Scalar, Index, Offset>> {
+            using Type = Scalar;
+        };
+
+        template <typename Scalar, typename Index, typename Offset>
+        struct IndexType<CompressedRowMatrix<Scalar, Index, Offset>> {
+            using Type = Index;
+        };
+
+        template <typename Scalar, typename Index, typename Offset>
+        struct MatrixDimensionInfo<CompressedRowMatrix<Scalar, Index, Offset>> {
+            using Matrix = CompressedRowMatrix<Scalar, Index, Offset>;
+
+            static Index rows(const Matrix& m) { return m.rows(); }
+            static Index columns(const Matrix& m) { return m.columns(); }
+        };
+
+        template <typename Scalar, typename Index, typename Offset>
+        struct AssignRows<CompressedRowMatrix<Scalar, Index, Offset>> {
+            static void apply(CompressedRowMatrix<Scalar, Index, Offset>& matrix,
+                              std::size_t columns, CompressedRows<Scalar, Index>&& rows)
+            {
+                const auto number_of_rows = rows.rows();
+                matrix = CompressedRowMatrix<Scalar, Index, Offset>(number_of_rows, columns,
+                                                                    std::move(rows));
+            }
+        };
+
+        template <typename Scalar, typename Index, typename Offset>
+        struct MultiplyAssign<CompressedRowMatrix<Scalar, Index, Offset>> {
+            template <typename Vector>
+            static void apply(const CompressedRowMatrix<Scalar, Index, Offset>& matrix,
+                              Vector& vector)
+            {
+                Vector temp(matrix.rows());
+                matrix.multiply(vector, temp);
+                using std::swap;
+                swap(vector, temp);
+            }
+        };
+    } // namespace types
+} // namespace ieompp
+
+#endif
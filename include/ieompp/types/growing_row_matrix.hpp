@@ -0,0 +1,158 @@
+#ifndef IEOMPP_TYPES_GROWING_ROW_MATRIX_HPP_
+#define IEOMPP_TYPES_GROWING_ROW_MATRIX_HPP_
+
+#include "ieompp/exception.hpp"
+#include "ieompp/types/function_matrix.hpp"
+#include "ieompp/types/matrix.hpp"
+#include "ieompp/types/multiply_assign.hpp"
+
+#include <cassert>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace ieompp
+{
+    namespace types
+    {
+        // Row-major sparse matrix whose rows are stored separately, so that rows can be appended
+        // and elements can be appended to any row without moving the rest of the matrix. The
+        // elements of a row have to be appended with increasing column index. Appending the new
+        // columns to the existing rows keeps them sorted if the new columns are the last ones, as
+        // for a basis that grows at its end. The multiplication is slower than for a
+        // CompressedRowMatrix since the rows are not contiguous.
+        template <typename ScalarT, typename IndexT = std::uint32_t>
+        class GrowingRowMatrix
+        {
+        public:
+            using Scalar = ScalarT;
+            using Index  = IndexT;
+
+        private:
+            Index _rows, _columns;
+            std::size_t _non_zeros;
+            std::vector<std::vector<Index>> _column_indices;
+            std::vector<std::vector<Scalar>> _values;
+
+        public:
+            GrowingRowMatrix() : _rows(0), _columns(0), _non_zeros(0) {}
+
+            GrowingRowMatrix(std::size_t rows, std::size_t columns) : GrowingRowMatrix()
+            {
+                resize(rows, columns);
+            }
+
+            Index rows() const { return _rows; }
+            Index columns() const { return _columns; }
+            std::size_t non_zeros() const { return _non_zeros; }
+
+            const std::vector<Index>& column_indices(std::size_t row) const
+            {
+                return _column_indices[row];
+            }
+            const std::vector<Scalar>& values(std::size_t row) const { return _values[row]; }
+
+            // the existing rows are kept, the dimensions can only grow
+            void resize(std::size_t rows, std::size_t columns)
+            {
+                assert(rows >= _rows);
+                assert(columns >= _columns);
+                if((rows > std::numeric_limits<Index>::max())
+                   || (columns > std::numeric_limits<Index>::max())) {
+                    THROW(Exception, "Matrix dimensions exceed the range of the index type");
+                }
+                _rows    = rows;
+                _columns = columns;
+                _column_indices.resize(rows);
+                _values.resize(rows);
+            }
+
+            void reset()
+            {
+                for(Index row = 0; row < _rows; ++row) {
+                    _column_indices[row].clear();
+                    _values[row].clear();
+                }
+                _non_zeros = 0;
+            }
+
+            void append(std::size_t row, std::size_t column, const Scalar& value)
+            {
+                assert(row < _rows);
+                assert(column < _columns);
+                assert(_column_indices[row].empty() || (_column_indices[row].back() < column));
+                _column_indices[row].push_back(column);
+                _values[row].push_back(value);
+                ++_non_zeros;
+            }
+
+            // y = matrix * x, the element type of the vectors may differ from Scalar and the
+            // vectors may be of different types, e.g. the stage vectors of an integrator
+            template <typename InputVector, typename OutputVector>
+            void multiply(const InputVector& x, OutputVector& y) const
+            {
+                assert(x.size() == _columns);
+                assert(y.size() == _rows);
+
+                using Value = typename std::decay<decltype(y[0])>::type;
+
+                const Index rows = _rows;
+#pragma omp parallel for schedule(static)
+                for(Index row = 0; row < rows; ++row) {
+                    const auto& columns = _column_indices[row];
+                    const auto& values  = _values[row];
+
+                    Value sum = 0.;
+                    for(std::size_t pos = 0; pos < columns.size(); ++pos) {
+                        sum += values[pos] * x[columns[pos]];
+                    }
+                    y[row] = sum;
+                }
+            }
+        };
+
+        template <typename Scalar, typename Index>
+        struct IsMatrix<GrowingRowMatrix<Scalar, Index>> {
+            static constexpr bool value = true;
+        };
+
+        template <typename Scalar, typename Index>
+        struct is_function_matrix<GrowingRowMatrix<Scalar, Index>> {
+            static constexpr bool value = true;
+        };
+
+        template <typename Scalar, typename Index>
+        struct ScalarType<GrowingRowMatrix<Scalar, Index>> {
+            using Type = Scalar;
+        };
+
+        template <typename Scalar, typename Index>
+        struct IndexType<GrowingRowMatrix<Scalar, Index>> {
+            using Type = Index;
+        };
+
+        template <typename Scalar, typename Index>
+        struct MatrixDimensionInfo<GrowingRowMatrix<Scalar, Index>> {
+            using Matrix = GrowingRowMatrix<Scalar, Index>;
+
+            static Index rows(const Matrix& m) { return m.rows(); }
+            static Index columns(const Matrix& m) { return m.columns(); }
+        };
+
+        template <typename Scalar, typename Index>
+        struct MultiplyAssign<GrowingRowMatrix<Scalar, Index>> {
+            template <typename Vector>
+            static void apply(const GrowingRowMatrix<Scalar, Index>& matrix, Vector& vector)
+            {
+                Vector temp(matrix.rows());
+                matrix.multiply(vector, temp);
+                using std::swap;
+                swap(vector, temp);
+            }
+        };
+    } // namespace types
+} // namespace ieompp
+
+#endif
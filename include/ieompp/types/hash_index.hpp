@@ -0,0 +1,207 @@
+#ifndef IEOMPP_TYPES_HASH_INDEX_HPP_
+#define IEOMPP_TYPES_HASH_INDEX_HPP_
+
+#include "ieompp/openmp.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace ieompp
+{
+    namespace types
+    {
+        // Open addressing hash table from packed monomials (e.g. real-space basis indices) to
+        // basis indices. The table is split into 64 partitions by the upper bits of the hash, each
+        // partition is a linear probing table of its own with a load factor of at most 3/4. The
+        // partitions are filled in parallel without any synchronization, afterwards find only
+        // reads the table and can be called concurrently from the matrix builders. insert is
+        // not thread-safe, if a partition becomes too full only this partition is rehashed.
+        template <typename KeyT, typename ValueT = KeyT>
+        class HashIndex
+        {
+        public:
+            using Key   = KeyT;
+            using Value = ValueT;
+
+            static constexpr Value not_found = std::numeric_limits<Value>::max();
+
+        private:
+            static constexpr Key empty                = std::numeric_limits<Key>::max();
+            static constexpr unsigned partition_bits  = 6;
+            static constexpr std::size_t partitions   = std::size_t(1) << partition_bits;
+            static constexpr std::size_t min_capacity = 4;
+
+            struct Slot {
+                Key key;
+                Value value;
+            };
+
+            std::size_t _size;
+            // each partition is a table of a power of two slots with _counts[p] used slots
+            std::vector<std::vector<Slot>> _tables;
+            std::vector<std::size_t> _counts;
+
+            static std::uint64_t hash(Key key)
+            {
+                // finalizer of splitmix64
+                std::uint64_t x = key;
+                x               = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ull;
+                x               = (x ^ (x >> 27)) * 0x94d049bb133111ebull;
+                return x ^ (x >> 31);
+            }
+
+            static std::size_t partition(std::uint64_t h) { return h >> (64 - partition_bits); }
+
+            static std::size_t capacity_for(std::size_t count)
+            {
+                std::size_t capacity = min_capacity;
+                while(capacity < 2 * count) {
+                    capacity *= 2;
+                }
+                return capacity;
+            }
+
+            // linear probing in table, returns the slot of key or the empty slot where key would
+            // be inserted
+            static std::size_t probe(const std::vector<Slot>& table, std::uint64_t h, Key key)
+            {
+                const auto mask = table.size() - 1;
+                auto pos        = h & mask;
+                while((table[pos].key != key) && (table[pos].key != empty)) {
+                    pos = (pos + 1) & mask;
+                }
+                return pos;
+            }
+
+            // rehash partition p into a table with room for count entries
+            void grow(std::size_t p, std::size_t count)
+            {
+                std::vector<Slot> table(capacity_for(count), Slot{empty, 0});
+                for(const auto& s : _tables[p]) {
+                    if(s.key != empty) {
+                        table[probe(table, hash(s.key), s.key)] = s;
+                    }
+                }
+                _tables[p] = std::move(table);
+            }
+
+            // fill the table with the count entries entry(i), the keys have to be unique
+            template <typename EntryFunction>
+            void build(std::size_t count, const EntryFunction& entry)
+            {
+                // count the entries of each partition per chunk of entries, the chunks are sorted
+                // into the partitions in parallel
+                const std::size_t chunks     = omp_get_max_threads();
+                const std::size_t chunk_size = (count + chunks - 1) / chunks;
+                std::vector<std::size_t> positions(chunks * partitions, 0);
+                std::vector<std::uint8_t> partition_of(count);
+
+#pragma omp parallel for schedule(static)
+                for(std::size_t chunk = 0; chunk < chunks; ++chunk) {
+                    const auto last = std::min(count, (chunk + 1) * chunk_size);
+                    for(auto i = chunk * chunk_size; i < last; ++i) {
+                        partition_of[i] = partition(hash(entry(i).first));
+                        ++positions[chunk * partitions + partition_of[i]];
+                    }
+                }
+
+                _size = count;
+                _counts.assign(partitions, 0);
+                std::vector<std::size_t> starts(partitions + 1, 0);
+                for(std::size_t p = 0; p < partitions; ++p) {
+                    for(std::size_t chunk = 0; chunk < chunks; ++chunk) {
+                        const auto number                 = positions[chunk * partitions + p];
+                        positions[chunk * partitions + p] = starts[p] + _counts[p];
+                        _counts[p] += number;
+                    }
+                    starts[p + 1] = starts[p] + _counts[p];
+                }
+
+                std::vector<std::size_t> order(count);
+#pragma omp parallel for schedule(static)
+                for(std::size_t chunk = 0; chunk < chunks; ++chunk) {
+                    const auto last = std::min(count, (chunk + 1) * chunk_size);
+                    for(auto i = chunk * chunk_size; i < last; ++i) {
+                        order[positions[chunk * partitions + partition_of[i]]++] = i;
+                    }
+                }
+
+                _tables.clear();
+                _tables.resize(partitions);
+#pragma omp parallel for schedule(dynamic)
+                for(std::size_t p = 0; p < partitions; ++p) {
+                    auto& table = _tables[p];
+                    table.assign(capacity_for(_counts[p]), Slot{empty, 0});
+                    for(auto pos = starts[p]; pos < starts[p + 1]; ++pos) {
+                        const auto e    = entry(order[pos]);
+                        const auto slot = probe(table, hash(e.first), e.first);
+                        assert(table[slot].key == empty);
+                        table[slot] = Slot{e.first, e.second};
+                    }
+                }
+            }
+
+        public:
+            HashIndex() { build(0, [](std::size_t) { return std::make_pair(Key(0), Value(0)); }); }
+
+            // maps keys[i] to i, the keys have to be unique
+            explicit HashIndex(const std::vector<Key>& keys)
+            {
+                build(keys.size(),
+                      [&keys](std::size_t i) { return std::make_pair(keys[i], Value(i)); });
+            }
+
+            std::size_t size() const { return _size; }
+
+            // value of key or not_found
+            Value find(Key key) const
+            {
+                assert(key != empty);
+                const auto h      = hash(key);
+                const auto& table = _tables[partition(h)];
+                const auto slot   = probe(table, h, key);
+                return (table[slot].key == key) ? table[slot].value : not_found;
+            }
+
+            // insert key unless it is already contained, returns its value and whether it was
+            // inserted
+            std::pair<Value, bool> insert(Key key, Value value)
+            {
+                assert(key != empty);
+                const auto h = hash(key);
+                const auto p = partition(h);
+                auto slot    = probe(_tables[p], h, key);
+                if(_tables[p][slot].key == key) {
+                    return std::make_pair(_tables[p][slot].value, false);
+                }
+
+                if(4 * (_counts[p] + 1) > 3 * _tables[p].size()) {
+                    grow(p, _counts[p] + 1);
+                    slot = probe(_tables[p], h, key);
+                }
+
+                _tables[p][slot] = Slot{key, value};
+                ++_counts[p];
+                ++_size;
+                return std::make_pair(value, true);
+            }
+        };
+
+        template <typename Key, typename Value>
+        constexpr Value HashIndex<Key, Value>::not_found;
+        template <typename Key, typename Value>
+        constexpr Key HashIndex<Key, Value>::empty;
+        template <typename Key, typename Value>
+        constexpr unsigned HashIndex<Key, Value>::partition_bits;
+        template <typename Key, typename Value>
+        constexpr std::size_t HashIndex<Key, Value>::partitions;
+        template <typename Key, typename Value>
+        constexpr std::size_t HashIndex<Key, Value>::min_capacity;
+    } // namespace types
+} // namespace ieompp
+
+#endif
@@ -0,0 +1,186 @@
+#ifndef IEOMPP_TYPES_MATRIX_POWERS_HPP_
+#define IEOMPP_TYPES_MATRIX_POWERS_HPP_
+
+#include "ieompp/types/compressed_row_matrix.hpp"
+#include "ieompp/types/function_matrix.hpp"
+#include "ieompp/types/matrix.hpp"
+#include "ieompp/types/multiply_assign.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cassert>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+namespace ieompp
+{
+    namespace types
+    {
+        // Matrix-powers kernel for a banded CompressedRowMatrix A: computes A x, A^2 x, ..., A^S x
+        // in a single sweep over the matrix. The rows are split into blocks of block_rows rows
+        // which are processed along a skewed wavefront, in step s the k-th power is computed for
+        // block s - (k - 1) * lag, where lag blocks cover the upper bandwidth of A. A block is
+        // therefore reused by all powers within a window of (S - 1) * lag + 1 blocks. If that
+        // window fits into the cache, which requires an ordering with a small bandwidth (e.g.
+        // reverse_cuthill_mckee), the matrix is streamed from memory about once instead of S
+        // times.
+        template <typename ScalarT, typename IndexT = std::uint32_t,
+                  typename OffsetT = std::size_t>
+        class MatrixPowers
+        {
+        public:
+            using Scalar = ScalarT;
+            using Index  = IndexT;
+            using Offset = OffsetT;
+            using Matrix = CompressedRowMatrix<Scalar, Index, Offset>;
+
+        private:
+            Matrix _matrix;
+            Index _block_rows, _lag;
+
+        public:
+            explicit MatrixPowers(Matrix matrix, Index block_rows = 1024)
+                : _matrix(std::move(matrix)), _block_rows(block_rows), _lag(0)
+            {
+                assert(_block_rows > 0);
+
+                const auto& row_pointers = _matrix.row_pointers();
+                const auto& columns      = _matrix.column_indices();
+
+                // the columns of a row are sorted, so the last one is the farthest to the right
+                Index upper_bandwidth = 0;
+                for(Index row = 0; row < _matrix.rows(); ++row) {
+                    if((row_pointers[row + 1] > row_pointers[row])
+                       && (columns[row_pointers[row + 1] - 1] > row)) {
+                        upper_bandwidth = std::max<Index>(
+                            upper_bandwidth, columns[row_pointers[row + 1] - 1] - row);
+                    }
+                }
+                _lag = (upper_bandwidth + _block_rows - 1) / _block_rows;
+            }
+
+            Index rows() const { return _matrix.rows(); }
+            Index columns() const { return _matrix.columns(); }
+            Index block_rows() const { return _block_rows; }
+            Index lag() const { return _lag; }
+            std::size_t blocks() const
+            {
+                return (std::size_t(rows()) + _block_rows - 1) / _block_rows;
+            }
+            const Matrix& matrix() const { return _matrix; }
+
+            // number of row blocks that have to stay cached while computing S powers
+            std::size_t window(std::size_t S) const
+            {
+                return std::min(blocks(), (S - 1) * std::size_t(_lag) + 1);
+            }
+
+            template <typename Vector>
+            void multiply(const Vector& x, Vector& y) const
+            {
+                _matrix.multiply(x, y);
+            }
+
+            // result[k] = A^(k + 1) * x, the vectors are resized if necessary
+            template <std::size_t S, typename InputVector, typename Vector>
+            void powers(const InputVector& x, std::array<Vector, S>& result) const
+            {
+                static_assert(S > 0, "number of powers must not be zero");
+                assert(x.size() == columns());
+                assert(rows() == columns());
+
+                for(auto& power : result) {
+                    power.resize(rows());
+                }
+
+                const std::size_t blocks = this->blocks();
+                const std::size_t steps  = blocks + (S - 1) * std::size_t(_lag);
+                const std::size_t n      = rows();
+
+#pragma omp parallel
+                for(std::size_t step = 0; step < steps; ++step) {
+                    // block j of power k depends on blocks up to j + lag of power k - 1, which are
+                    // done in the same step before power k or in one of the previous steps
+                    for(std::size_t k = 0; (k < S) && (k * _lag <= step); ++k) {
+                        const std::size_t block = step - k * _lag;
+                        if(block >= blocks) {
+                            continue;
+                        }
+
+                        const Index first = block * _block_rows;
+                        const Index last  = std::min(n, (block + 1) * _block_rows);
+                        if(k == 0) {
+                            multiply_rows(x, result[0], first, last);
+                        } else {
+                            multiply_rows(result[k - 1], result[k], first, last);
+                        }
+                    }
+                }
+            }
+
+        private:
+            // out = A * in for the rows [first, last), the rows are shared by the threads of the
+            // enclosing parallel region
+            template <typename InputVector, typename Vector>
+            void multiply_rows(const InputVector& in, Vector& out, Index first, Index last) const
+            {
+                using Value = typename std::decay<decltype(out[first])>::type;
+
+                const auto& row_pointers = _matrix.row_pointers();
+                const auto& columns      = _matrix.column_indices();
+                const auto& values       = _matrix.values();
+#pragma omp for schedule(static)
+                for(Index row = first; row < last; ++row) {
+                    Value sum = 0.;
+                    for(Offset pos = row_pointers[row]; pos < row_pointers[row + 1]; ++pos) {
+                        sum += values[pos] * in[columns[pos]];
+                    }
+                    out[row] = sum;
+                }
+            }
+        };
+
+        template <typename Scalar, typename Index, typename Offset>
+        struct IsMatrix<MatrixPowers<Scalar, Index, Offset>> {
+            static constexpr bool value = true;
+        };
+
+        template <typename Scalar, typename Index, typename Offset>
+        struct is_function_matrix<MatrixPowers<Scalar, Index, Offset>> {
+            static constexpr bool value = true;
+        };
+
+        template <typename Scalar, typename Index, typename Offset>
+        struct ScalarType<MatrixPowers<Scalar, Index, Offset>> {
+            using Type = Scalar;
+        };
+
+        template <typename Scalar, typename Index, typename Offset>
+        struct IndexType<MatrixPowers<Scalar, Index, Offset>> {
+            using Type = Index;
+        };
+
+        template <typename Scalar, typename Index, typename Offset>
+        struct MatrixDimensionInfo<MatrixPowers<Scalar, Index, Offset>> {
+            using Matrix = MatrixPowers<Scalar, Index, Offset>;
+
+            static Index rows(const Matrix& m) { return m.rows(); }
+            static Index columns(const Matrix& m) { return m.columns(); }
+        };
+
+        template <typename Scalar, typename Index, typename Offset>
+        struct MultiplyAssign<MatrixPowers<Scalar, Index, Offset>> {
+            template <typename Vector>
+            static void apply(const MatrixPowers<Scalar, Index, Offset>& matrix, Vector& vector)
+            {
+                Vector temp(matrix.rows());
+                matrix.multiply(vector, temp);
+                using std::swap;
+                swap(vector, temp);
+            }
+        };
+    } // namespace types
+} // namespace ieompp
+
+#endif
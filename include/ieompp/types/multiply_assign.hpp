@@ -5,10 +5,21 @@ namespace ieompp
 {
     namespace types
     {
+        // specialize this struct for matrix types that cannot be used in an expression m * v, the
+        // specialization is picked up at the point of instantiation regardless of include order
+        template <typename Matrix>
+        struct MultiplyAssign {
+            template <typename Vector>
+            static void apply(const Matrix& matrix, Vector& vector)
+            {
+                vector = matrix * vector;
+            }
+        };
+
         template <typename Matrix, typename Vector>
         void multiply_assign(const Matrix& matrix, Vector& vector)
         {
-            vector = matrix * vector;
+            MultiplyAssign<Matrix>::apply(matrix, vector);
         }
     } // namespace types
 } // namespace ieompp
@@ -0,0 +1,200 @@
+#ifndef IEOMPP_TYPES_PERMUTATION_HPP_
+#define IEOMPP_TYPES_PERMUTATION_HPP_
+
+#include "ieompp/types/compressed_row_matrix.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <numeric>
+#include <queue>
+#include <utility>
+#include <vector>
+
+namespace ieompp
+{
+    namespace types
+    {
+        // Relabeling of the rows and columns of a matrix and the entries of a vector. Row new of
+        // a permuted matrix is row old_index(new) of the original one, restore maps a permuted
+        // vector back to the original order, e.g. for measurements and output.
+        template <typename IndexT>
+        class Permutation
+        {
+        public:
+            using Index = IndexT;
+
+        private:
+            std::vector<Index> _new_to_old, _old_to_new;
+
+        public:
+            Permutation() = default;
+
+            explicit Permutation(std::vector<Index> new_to_old)
+                : _new_to_old(std::move(new_to_old)), _old_to_new(_new_to_old.size())
+            {
+                const auto size = _new_to_old.size();
+                for(std::size_t i = 0; i < size; ++i) {
+                    assert(_new_to_old[i] < size);
+                    _old_to_new[_new_to_old[i]] = i;
+                }
+            }
+
+            static Permutation identity(std::size_t size)
+            {
+                std::vector<Index> new_to_old(size);
+                std::iota(new_to_old.begin(), new_to_old.end(), Index(0));
+                return Permutation(std::move(new_to_old));
+            }
+
+            std::size_t size() const { return _new_to_old.size(); }
+
+            Index new_index(Index old_index) const { return _old_to_new[old_index]; }
+            Index old_index(Index new_index) const { return _new_to_old[new_index]; }
+
+            Permutation inverse() const { return Permutation(_old_to_new); }
+
+            template <typename Vector>
+            Vector apply(const Vector& vector) const
+            {
+                assert(vector.size() == size());
+                Vector result(vector.size());
+                const auto n = size();
+#pragma omp parallel for schedule(static)
+                for(std::size_t i = 0; i < n; ++i) {
+                    result[i] = vector[_new_to_old[i]];
+                }
+                return result;
+            }
+
+            template <typename Vector>
+            Vector restore(const Vector& vector) const
+            {
+                assert(vector.size() == size());
+                Vector result(vector.size());
+                const auto n = size();
+#pragma omp parallel for schedule(static)
+                for(std::size_t i = 0; i < n; ++i) {
+                    result[_new_to_old[i]] = vector[i];
+                }
+                return result;
+            }
+        };
+
+        // P * matrix * P^T, the column indices of each row stay sorted
+        template <typename Scalar, typename Index, typename Offset, typename PermutationIndex>
+        CompressedRowMatrix<Scalar, Index, Offset>
+        permute(const CompressedRowMatrix<Scalar, Index, Offset>& matrix,
+                const Permutation<PermutationIndex>& permutation)
+        {
+            assert(matrix.rows() == matrix.columns());
+            assert(permutation.size() == matrix.rows());
+
+            const auto rows          = matrix.rows();
+            const auto& row_pointers = matrix.row_pointers();
+            const auto& columns      = matrix.column_indices();
+            const auto& values       = matrix.values();
+
+            CompressedRowMatrix<Scalar, Index, Offset> result(rows, rows);
+            result.reserve(matrix.non_zeros());
+
+            std::vector<std::pair<Index, Scalar>> row_elements;
+            for(Index row = 0; row < rows; ++row) {
+                const auto old_row = permutation.old_index(row);
+
+                row_elements.clear();
+                for(auto pos = row_pointers[old_row]; pos < row_pointers[old_row + 1]; ++pos) {
+                    row_elements.emplace_back(permutation.new_index(columns[pos]), values[pos]);
+                }
+                std::sort(row_elements.begin(), row_elements.end(),
+                          [](const std::pair<Index, Scalar>& a, const std::pair<Index, Scalar>& b) {
+                              return a.first < b.first;
+                          });
+
+                for(const auto& element : row_elements) {
+                    result.append(row, element.first, element.second);
+                }
+                result.finalize(row);
+            }
+
+            return result;
+        }
+
+        // Reverse Cuthill-McKee ordering of the graph given by the row pattern of matrix, which
+        // clusters the non-zeros around the diagonal for structurally symmetric matrices. Every
+        // connected component is started from one of its vertices with minimal degree.
+        template <typename Scalar, typename Index, typename Offset>
+        Permutation<Index>
+        reverse_cuthill_mckee(const CompressedRowMatrix<Scalar, Index, Offset>& matrix)
+        {
+            assert(matrix.rows() == matrix.columns());
+
+            const auto rows          = matrix.rows();
+            const auto& row_pointers = matrix.row_pointers();
+            const auto& columns      = matrix.column_indices();
+            const auto degree        = [&row_pointers](Index row) {
+                return row_pointers[row + 1] - row_pointers[row];
+            };
+
+            std::vector<Index> by_degree(rows);
+            std::iota(by_degree.begin(), by_degree.end(), Index(0));
+            std::stable_sort(by_degree.begin(), by_degree.end(),
+                             [&degree](Index a, Index b) { return degree(a) < degree(b); });
+
+            std::vector<Index> order;
+            order.reserve(rows);
+            std::vector<bool> visited(rows, false);
+            std::vector<Index> neighbors;
+
+            for(const auto start : by_degree) {
+                if(visited[start]) {
+                    continue;
+                }
+
+                std::queue<Index> queue;
+                queue.push(start);
+                visited[start] = true;
+
+                while(!queue.empty()) {
+                    const auto row = queue.front();
+                    queue.pop();
+                    order.push_back(row);
+
+                    neighbors.clear();
+                    for(auto pos = row_pointers[row]; pos < row_pointers[row + 1]; ++pos) {
+                        if(!visited[columns[pos]]) {
+                            visited[columns[pos]] = true;
+                            neighbors.push_back(columns[pos]);
+                        }
+                    }
+                    std::stable_sort(neighbors.begin(), neighbors.end(),
+                                     [&degree](Index a, Index b) { return degree(a) < degree(b); });
+                    for(const auto neighbor : neighbors) {
+                        queue.push(neighbor);
+                    }
+                }
+            }
+
+            std::reverse(order.begin(), order.end());
+            return Permutation<Index>(std::move(order));
+        }
+
+        // largest distance of a non-zero element from the diagonal
+        template <typename Scalar, typename Index, typename Offset>
+        Index bandwidth(const CompressedRowMatrix<Scalar, Index, Offset>& matrix)
+        {
+            const auto& row_pointers = matrix.row_pointers();
+            const auto& columns      = matrix.column_indices();
+
+            Index result = 0;
+            for(Index row = 0; row < matrix.rows(); ++row) {
+                for(auto pos = row_pointers[row]; pos < row_pointers[row + 1]; ++pos) {
+                    result = std::max<Index>(
+                        result, (columns[pos] > row) ? (columns[pos] - row) : (row - columns[pos]));
+                }
+            }
+            return result;
+        }
+    } // namespace types
+} // namespace ieompp
+
+#endif
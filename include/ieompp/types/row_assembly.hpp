@@ -0,0 +1,123 @@
+#ifndef IEOMPP_TYPES_ROW_ASSEMBLY_HPP_
+#define IEOMPP_TYPES_ROW_ASSEMBLY_HPP_
+
+#include "ieompp/openmp.hpp"
+#include "ieompp/types/triplet.hpp"
+
+#include <cassert>
+#include <utility>
+#include <vector>
+
+namespace ieompp
+{
+    namespace types
+    {
+        // row pointers, column indices and values of a row-major sparse matrix as produced by
+        // assemble_rows_parallel, row i occupies [row_pointers[i], row_pointers[i + 1]). The
+        // row pointers are std::size_t since the number of elements may exceed the range of Index.
+        template <typename ScalarT, typename IndexT>
+        struct CompressedRows {
+            using Scalar = ScalarT;
+            using Index  = IndexT;
+
+            std::vector<std::size_t> row_pointers;
+            std::vector<Index> columns;
+            std::vector<Scalar> values;
+
+            Index rows() const { return row_pointers.empty() ? 0 : row_pointers.size() - 1; }
+            std::size_t non_zeros() const { return values.size(); }
+        };
+
+        // Assemble a row-major sparse matrix in two parallel passes. row_function(row, triplets)
+        // has to fill triplets with the sorted entries of row, the first pass only counts them,
+        // after a prefix sum the second pass writes columns and values to their final location.
+        // Each thread uses its own triplet list as scratch space.
+        template <typename Scalar, typename Index, typename RowFunction>
+        CompressedRows<Scalar, Index> assemble_rows_parallel(Index rows,
+                                                             const RowFunction& row_function,
+                                                             std::size_t row_size_hint = 0)
+        {
+            CompressedRows<Scalar, Index> result;
+            result.row_pointers.assign(rows + 1, 0);
+
+#pragma omp parallel
+            {
+                TripletList<Scalar, Index> triplets;
+                triplets.reserve(row_size_hint);
+
+#pragma omp for schedule(static)
+                for(Index row = 0; row < rows; ++row) {
+                    row_function(row, triplets);
+                    result.row_pointers[row + 1] = triplets.size();
+                }
+            }
+
+            for(Index row = 0; row < rows; ++row) {
+                result.row_pointers[row + 1] += result.row_pointers[row];
+            }
+
+            result.columns.resize(result.row_pointers[rows]);
+            result.values.resize(result.row_pointers[rows]);
+
+#pragma omp parallel
+            {
+                TripletList<Scalar, Index> triplets;
+                triplets.reserve(row_size_hint);
+
+#pragma omp for schedule(static)
+                for(Index row = 0; row < rows; ++row) {
+                    row_function(row, triplets);
+                    assert(result.row_pointers[row] + triplets.size()
+                           == result.row_pointers[row + 1]);
+
+                    auto pos = result.row_pointers[row];
+                    for(const auto& triplet : triplets) {
+                        result.columns[pos] = triplet.column;
+                        result.values[pos]  = triplet.value;
+                        ++pos;
+                    }
+                }
+            }
+
+            return result;
+        }
+
+        // copy assembled rows into a matrix that supports the append/finalize interface, matrix
+        // has to be resized and empty
+        template <typename Matrix, typename Scalar, typename Index>
+        void append_rows(Matrix& matrix, const CompressedRows<Scalar, Index>& rows)
+        {
+            const auto number_of_rows = rows.rows();
+            for(Index row = 0; row < number_of_rows; ++row) {
+                for(auto pos = rows.row_pointers[row]; pos < rows.row_pointers[row + 1]; ++pos) {
+                    matrix.append(row, rows.columns[pos], rows.values[pos]);
+                }
+                matrix.finalize(row);
+            }
+        }
+
+        // Fill matrix with the assembled rows of a rows.rows() x columns matrix. By default the
+        // rows are copied via resize/reset/reserve/append_rows, matrix types that can take over
+        // the arrays specialize AssignRows to avoid the copy.
+        template <typename Matrix>
+        struct AssignRows {
+            template <typename Scalar, typename Index>
+            static void apply(Matrix& matrix, std::size_t columns,
+                              CompressedRows<Scalar, Index>&& rows)
+            {
+                matrix.resize(rows.rows(), columns, false);
+                matrix.reset();
+                matrix.reserve(rows.non_zeros());
+                append_rows(matrix, rows);
+            }
+        };
+
+        template <typename Matrix, typename Scalar, typename Index>
+        void assign_rows(Matrix& matrix, std::size_t columns, CompressedRows<Scalar, Index>&& rows)
+        {
+            AssignRows<Matrix>::apply(matrix, columns, std::move(rows));
+        }
+    } // namespace types
+} // namespace ieompp
+
+#endif
@@ -0,0 +1,315 @@
+#ifndef IEOMPP_TYPES_SLICED_ELLPACK_MATRIX_HPP_
+#define IEOMPP_TYPES_SLICED_ELLPACK_MATRIX_HPP_
+
+#include "ieompp/types/compressed_row_matrix.hpp"
+#include "ieompp/types/function_matrix.hpp"
+#include "ieompp/types/matrix.hpp"
+#include "ieompp/types/multiply_assign.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <complex>
+#include <cstdint>
+#include <numeric>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if defined(__AVX2__) || defined(__AVX512F__)
+#include <immintrin.h>
+#endif
+
+namespace ieompp
+{
+    namespace types
+    {
+        namespace detail
+        {
+            // sums[r] = Σ_j values[j * C + r] * x[columns[j * C + r]] for the C rows of one chunk
+            template <typename Scalar, typename Value, typename Index, std::size_t C>
+            struct SlicedEllpackScalarChunk {
+                static void apply(std::size_t length, const Scalar* values, const Index* columns,
+                                  const Value* x, Value* sums)
+                {
+                    for(std::size_t r = 0; r < C; ++r) {
+                        sums[r] = 0.;
+                    }
+                    for(std::size_t j = 0; j < length; ++j) {
+                        for(std::size_t r = 0; r < C; ++r) {
+                            sums[r] += values[j * C + r] * x[columns[j * C + r]];
+                        }
+                    }
+                }
+            };
+
+            template <typename Scalar, typename Value, typename Index, std::size_t C,
+                      typename Enable = void>
+            struct SlicedEllpackChunk : SlicedEllpackScalarChunk<Scalar, Value, Index, C> {
+            };
+
+#if defined(__AVX512F__)
+            // real matrix times complex vector, eight rows per instruction: the real and imaginary
+            // parts of x are gathered separately with the doubled column index, which has to fit
+            // into a signed 32-bit integer
+            template <std::size_t C>
+            struct SlicedEllpackChunk<double, std::complex<double>, std::uint32_t, C,
+                                      typename std::enable_if<C % 8 == 0>::type> {
+                static void apply(std::size_t length, const double* values,
+                                  const std::uint32_t* columns, const std::complex<double>* x,
+                                  std::complex<double>* sums)
+                {
+                    const auto base = reinterpret_cast<const double*>(x);
+                    alignas(64) double real[8], imag[8];
+
+                    for(std::size_t group = 0; group < C; group += 8) {
+                        __m512d sum_real = _mm512_setzero_pd(), sum_imag = _mm512_setzero_pd();
+                        for(std::size_t j = 0; j < length; ++j) {
+                            const auto offset = j * C + group;
+                            const __m512d value = _mm512_loadu_pd(values + offset);
+                            __m256i index = _mm256_loadu_si256(
+                                reinterpret_cast<const __m256i*>(columns + offset));
+                            index = _mm256_add_epi32(index, index);
+                            sum_real = _mm512_fmadd_pd(
+                                value, _mm512_i32gather_pd(index, base, 8), sum_real);
+                            sum_imag = _mm512_fmadd_pd(
+                                value, _mm512_i32gather_pd(index, base + 1, 8), sum_imag);
+                        }
+                        _mm512_store_pd(real, sum_real);
+                        _mm512_store_pd(imag, sum_imag);
+                        for(std::size_t r = 0; r < 8; ++r) {
+                            sums[group + r] = std::complex<double>(real[r], imag[r]);
+                        }
+                    }
+                }
+            };
+#elif defined(__AVX2__)
+            // real matrix times complex vector, four rows per instruction: the real and imaginary
+            // parts of x are gathered separately with the doubled column index
+            template <std::size_t C>
+            struct SlicedEllpackChunk<double, std::complex<double>, std::uint32_t, C,
+                                      typename std::enable_if<C % 4 == 0>::type> {
+                static void apply(std::size_t length, const double* values,
+                                  const std::uint32_t* columns, const std::complex<double>* x,
+                                  std::complex<double>* sums)
+                {
+                    const auto base = reinterpret_cast<const double*>(x);
+                    alignas(32) double real[4], imag[4];
+
+                    for(std::size_t group = 0; group < C; group += 4) {
+                        __m256d sum_real = _mm256_setzero_pd(), sum_imag = _mm256_setzero_pd();
+                        for(std::size_t j = 0; j < length; ++j) {
+                            const auto offset   = j * C + group;
+                            const __m256d value = _mm256_loadu_pd(values + offset);
+                            __m128i index = _mm_loadu_si128(
+                                reinterpret_cast<const __m128i*>(columns + offset));
+                            index = _mm_add_epi32(index, index);
+                            const __m256d x_real = _mm256_i32gather_pd(base, index, 8);
+                            const __m256d x_imag = _mm256_i32gather_pd(base + 1, index, 8);
+#if defined(__FMA__)
+                            sum_real = _mm256_fmadd_pd(value, x_real, sum_real);
+                            sum_imag = _mm256_fmadd_pd(value, x_imag, sum_imag);
+#else
+                            sum_real = _mm256_add_pd(sum_real, _mm256_mul_pd(value, x_real));
+                            sum_imag = _mm256_add_pd(sum_imag, _mm256_mul_pd(value, x_imag));
+#endif
+                        }
+                        _mm256_store_pd(real, sum_real);
+                        _mm256_store_pd(imag, sum_imag);
+                        for(std::size_t r = 0; r < 4; ++r) {
+                            sums[group + r] = std::complex<double>(real[r], imag[r]);
+                        }
+                    }
+                }
+            };
+#endif
+        } // namespace detail
+
+        // Sliced ELLPACK (SELL-C-σ) matrix: the rows are sorted by their number of non-zeros
+        // within windows of sigma rows and grouped into chunks of C consecutive rows. Each chunk
+        // is padded to its longest row and stored column by column so that the C rows of a chunk
+        // are processed in lockstep. Padding elements are zeros referring to a valid column.
+        template <typename ScalarT, typename IndexT = std::uint32_t, std::size_t C = 8>
+        class SlicedEllpackMatrix
+        {
+            static_assert(C > 0, "chunk size must not be zero");
+
+        public:
+            using Scalar = ScalarT;
+            using Index  = IndexT;
+
+            static constexpr std::size_t chunk_size = C;
+
+        private:
+            Index _rows, _columns;
+            std::vector<std::size_t> _chunk_offsets, _chunk_lengths;
+            std::vector<Index> _rows_of_slots;
+            std::vector<Index> _column_indices;
+            std::vector<Scalar> _values;
+
+        public:
+            SlicedEllpackMatrix() : _rows(0), _columns(0), _chunk_offsets(1, 0) {}
+
+            template <typename Offset>
+            SlicedEllpackMatrix(const CompressedRowMatrix<Scalar, Index, Offset>& matrix,
+                                std::size_t sigma = 32 * C)
+                : _rows(matrix.rows()), _columns(matrix.columns())
+            {
+                assert(sigma > 0);
+
+                const auto& row_pointers = matrix.row_pointers();
+                const auto row_length    = [&row_pointers](Index row) {
+                    return row_pointers[row + 1] - row_pointers[row];
+                };
+
+                const std::size_t chunks = (std::size_t(_rows) + C - 1) / C;
+
+                // slot i of the matrix holds row _rows_of_slots[i], slots past the last row
+                // repeat the last row and are never written back
+                _rows_of_slots.resize(chunks * C);
+                std::iota(_rows_of_slots.begin(), _rows_of_slots.begin() + _rows, Index(0));
+                for(std::size_t window = 0; window < _rows; window += sigma) {
+                    const auto first = _rows_of_slots.begin() + window;
+                    const auto last  = _rows_of_slots.begin() + std::min(window + sigma,
+                                                                        std::size_t(_rows));
+                    std::stable_sort(first, last, [&row_length](Index a, Index b) {
+                        return row_length(a) > row_length(b);
+                    });
+                }
+                std::fill(_rows_of_slots.begin() + _rows, _rows_of_slots.end(),
+                          _rows == 0 ? 0 : _rows_of_slots[_rows - 1]);
+
+                _chunk_offsets.resize(chunks + 1);
+                _chunk_lengths.resize(chunks);
+                _chunk_offsets[0] = 0;
+                for(std::size_t chunk = 0; chunk < chunks; ++chunk) {
+                    std::size_t length = 0;
+                    for(std::size_t r = 0; r < C; ++r) {
+                        const auto slot = chunk * C + r;
+                        if(slot < _rows) {
+                            length = std::max<std::size_t>(length,
+                                                           row_length(_rows_of_slots[slot]));
+                        }
+                    }
+                    _chunk_lengths[chunk]     = length;
+                    _chunk_offsets[chunk + 1] = _chunk_offsets[chunk] + length * C;
+                }
+
+                _column_indices.resize(_chunk_offsets[chunks]);
+                _values.resize(_chunk_offsets[chunks]);
+
+                const auto& columns = matrix.column_indices();
+                const auto& values  = matrix.values();
+#pragma omp parallel for schedule(static)
+                for(std::size_t chunk = 0; chunk < chunks; ++chunk) {
+                    const auto offset = _chunk_offsets[chunk];
+                    for(std::size_t r = 0; r < C; ++r) {
+                        const auto slot   = chunk * C + r;
+                        const auto row    = _rows_of_slots[slot];
+                        const auto begin  = row_pointers[row];
+                        const auto length = (slot < _rows) ? row_length(row) : 0;
+                        for(std::size_t j = 0; j < _chunk_lengths[chunk]; ++j) {
+                            const auto pos = offset + j * C + r;
+                            if(j < length) {
+                                _column_indices[pos] = columns[begin + j];
+                                _values[pos]         = values[begin + j];
+                            } else {
+                                _column_indices[pos] = (j == 0) ? 0 : _column_indices[pos - C];
+                                _values[pos]         = 0.;
+                            }
+                        }
+                    }
+                }
+            }
+
+            Index rows() const { return _rows; }
+            Index columns() const { return _columns; }
+
+            // number of stored elements including the padding
+            std::size_t stored_elements() const { return _values.size(); }
+
+            // y = matrix * x, the element type of the vectors may differ from Scalar (e.g. a real
+            // matrix applied to a complex vector)
+            template <typename Vector>
+            void multiply(const Vector& x, Vector& y) const
+            {
+                assert(x.size() == _columns);
+                assert(y.size() == _rows);
+
+                using Value = typename ScalarType<Vector>::Type;
+
+                // the vectorized kernels gather with the doubled column index as a signed 32-bit
+                // integer, larger matrices are multiplied with the scalar kernel
+                if(2 * std::uint64_t(_columns) <= std::uint64_t(INT32_MAX)) {
+                    multiply_with<detail::SlicedEllpackChunk<Scalar, Value, Index, C>>(x, y);
+                } else {
+                    multiply_with<detail::SlicedEllpackScalarChunk<Scalar, Value, Index, C>>(x, y);
+                }
+            }
+
+        private:
+            template <typename Kernel, typename Vector>
+            void multiply_with(const Vector& x, Vector& y) const
+            {
+                using Value = typename ScalarType<Vector>::Type;
+
+                const std::size_t chunks = _chunk_lengths.size();
+                const Value* x_data      = &x[0];
+
+#pragma omp parallel for schedule(static)
+                for(std::size_t chunk = 0; chunk < chunks; ++chunk) {
+                    Value sums[C];
+                    const auto offset = _chunk_offsets[chunk];
+                    Kernel::apply(_chunk_lengths[chunk], _values.data() + offset,
+                                  _column_indices.data() + offset, x_data, sums);
+
+                    const auto slots = std::min(C, std::size_t(_rows) - chunk * C);
+                    for(std::size_t r = 0; r < slots; ++r) {
+                        y[_rows_of_slots[chunk * C + r]] = sums[r];
+                    }
+                }
+            }
+        };
+
+        template <typename Scalar, typename Index, std::size_t C>
+        struct IsMatrix<SlicedEllpackMatrix<Scalar, Index, C>> {
+            static constexpr bool value = true;
+        };
+
+        template <typename Scalar, typename Index, std::size_t C>
+        struct is_function_matrix<SlicedEllpackMatrix<Scalar, Index, C>> {
+            static constexpr bool value = true;
+        };
+
+        template <typename Scalar, typename Index, std::size_t C>
+        struct ScalarType<SlicedEllpackMatrix<Scalar, Index, C>> {
+            using Type = Scalar;
+        };
+
+        template <typename Scalar, typename Index, std::size_t C>
+        struct IndexType<SlicedEllpackMatrix<Scalar, Index, C>> {
+            using Type = Index;
+        };
+
+        template <typename Scalar, typename Index, std::size_t C>
+        struct MatrixDimensionInfo<SlicedEllpackMatrix<Scalar, Index, C>> {
+            using Matrix = SlicedEllpackMatrix<Scalar, Index, C>;
+
+            static Index rows(const Matrix& m) { return m.rows(); }
+            static Index columns(const Matrix& m) { return m.columns(); }
+        };
+
+        template <typename Scalar, typename Index, std::size_t C>
+        struct MultiplyAssign<SlicedEllpackMatrix<Scalar, Index, C>> {
+            template <typename Vector>
+            static void apply(const SlicedEllpackMatrix<Scalar, Index, C>& matrix, Vector& vector)
+            {
+                Vector temp(matrix.rows());
+                matrix.multiply(vector, temp);
+                using std::swap;
+                swap(vector, temp);
+            }
+        };
+    } // namespace types
+} // namespace ieompp
+
+#endif
@@ -51,6 +51,28 @@ namespace ieompp
                 return filtered;
             }
 
+            // in-place variant of make_columns_unique, merges the triplets of equal columns of a
+            // sorted list without allocating
+            void merge_columns()
+            {
+                if(this->empty()) {
+                    return;
+                }
+
+                auto last = this->begin();
+                for(auto it = this->begin() + 1; it != this->end(); ++it) {
+                    if(it->column == last->column) {
+                        last->value += it->value;
+                    } else {
+                        if(!types::IsZero(last->value)) {
+                            ++last;
+                        }
+                        *last = *it;
+                    }
+                }
+                this->erase(last + 1, this->end());
+            }
+
             bool has_unique_columns() const
             {
                 for(auto it = this->begin() + 1; it != this->end(); ++it) {
@@ -0,0 +1,161 @@
+#ifndef IEOMPP_TYPES_VALUE_DICTIONARY_MATRIX_HPP_
+#define IEOMPP_TYPES_VALUE_DICTIONARY_MATRIX_HPP_
+
+#include "ieompp/exception.hpp"
+#include "ieompp/types/compressed_row_matrix.hpp"
+#include "ieompp/types/function_matrix.hpp"
+#include "ieompp/types/matrix.hpp"
+#include "ieompp/types/multiply_assign.hpp"
+
+#include <algorithm>
+#include <cassert>
+#include <complex>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace ieompp
+{
+    namespace types
+    {
+        namespace detail
+        {
+            template <typename T>
+            bool dictionary_less(const T& a, const T& b)
+            {
+                return a < b;
+            }
+
+            template <typename T>
+            bool dictionary_less(const std::complex<T>& a, const std::complex<T>& b)
+            {
+                return (a.real() < b.real()) || ((a.real() == b.real()) && (a.imag() < b.imag()));
+            }
+        } // namespace detail
+
+        // Row-major sparse matrix that stores a Code into a table of the distinct values instead
+        // of the value of each non-zero element. Only pays off for matrices built from a small set
+        // of values, like the real-space Liouvillians (±J and U/2). The values are compared
+        // exactly, the constructor throws if there are more distinct values than Code can address.
+        template <typename ScalarT, typename CodeT = std::uint8_t, typename IndexT = std::uint32_t,
+                  typename OffsetT = std::size_t>
+        class ValueDictionaryMatrix
+        {
+        public:
+            using Scalar = ScalarT;
+            using Code   = CodeT;
+            using Index  = IndexT;
+            using Offset = OffsetT;
+
+        private:
+            Index _rows, _columns;
+            std::vector<Offset> _row_pointers;
+            std::vector<Index> _column_indices;
+            std::vector<Code> _codes;
+            std::vector<Scalar> _table;
+
+        public:
+            ValueDictionaryMatrix() : _rows(0), _columns(0), _row_pointers(1, 0) {}
+
+            explicit ValueDictionaryMatrix(const CompressedRowMatrix<Scalar, Index, Offset>& matrix)
+                : _rows(matrix.rows()), _columns(matrix.columns()),
+                  _row_pointers(matrix.row_pointers()), _column_indices(matrix.column_indices()),
+                  _codes(matrix.non_zeros())
+            {
+                const auto& values = matrix.values();
+                const auto less    = [](const Scalar& a, const Scalar& b) {
+                    return detail::dictionary_less(a, b);
+                };
+
+                _table = values;
+                std::sort(_table.begin(), _table.end(), less);
+                _table.erase(std::unique(_table.begin(), _table.end()), _table.end());
+                // the table starts as a copy of all values
+                _table.shrink_to_fit();
+                if(_table.size() > std::size_t(std::numeric_limits<Code>::max()) + 1) {
+                    THROW(Exception, "Too many distinct values for the range of the code type");
+                }
+
+                const std::size_t size = values.size();
+#pragma omp parallel for schedule(static)
+                for(std::size_t i = 0; i < size; ++i) {
+                    const auto it = std::lower_bound(_table.begin(), _table.end(), values[i], less);
+                    assert((it != _table.end()) && (*it == values[i]));
+                    _codes[i] = it - _table.begin();
+                }
+            }
+
+            Index rows() const { return _rows; }
+            Index columns() const { return _columns; }
+            Offset non_zeros() const { return _codes.size(); }
+
+            const std::vector<Scalar>& table() const { return _table; }
+
+            // y = matrix * x, the element type of the vectors may differ from Scalar (e.g. a real
+            // matrix applied to a complex vector)
+            template <typename Vector>
+            void multiply(const Vector& x, Vector& y) const
+            {
+                assert(x.size() == _columns);
+                assert(y.size() == _rows);
+
+                using Value = typename ScalarType<Vector>::Type;
+
+                const Index rows    = _rows;
+                const Scalar* table = _table.data();
+#pragma omp parallel for schedule(static)
+                for(Index row = 0; row < rows; ++row) {
+                    Value sum = 0.;
+                    for(Offset pos = _row_pointers[row]; pos < _row_pointers[row + 1]; ++pos) {
+                        sum += table[_codes[pos]] * x[_column_indices[pos]];
+                    }
+                    y[row] = sum;
+                }
+            }
+        };
+
+        template <typename Scalar, typename Code, typename Index, typename Offset>
+        struct IsMatrix<ValueDictionaryMatrix<Scalar, Code, Index, Offset>> {
+            static constexpr bool value = true;
+        };
+
+        template <typename Scalar, typename Code, typename Index, typename Offset>
+        struct is_function_matrix<ValueDictionaryMatrix<Scalar, Code, Index, Offset>> {
+            static constexpr bool value = true;
+        };
+
+        template <typename Scalar, typename Code, typename Index, typename Offset>
+        struct ScalarType<ValueDictionaryMatrix<Scalar, Code, Index, Offset>> {
+            using Type = Scalar;
+        };
+
+        template <typename Scalar, typename Code, typename Index, typename Offset>
+        struct IndexType<ValueDictionaryMatrix<Scalar, Code, Index, Offset>> {
+            using Type = Index;
+        };
+
+        template <typename Scalar, typename Code, typename Index, typename Offset>
+        struct MatrixDimensionInfo<ValueDictionaryMatrix<Scalar, Code, Index, Offset>> {
+            using Matrix = ValueDictionaryMatrix<Scalar, Code, Index, Offset>;
+
+            static Index rows(const Matrix& m) { return m.rows(); }
+            static Index columns(const Matrix& m) { return m.columns(); }
+        };
+
+        template <typename Scalar, typename Code, typename Index, typename Offset>
+        struct MultiplyAssign<ValueDictionaryMatrix<Scalar, Code, Index, Offset>> {
+            template <typename Vector>
+            static void apply(const ValueDictionaryMatrix<Scalar, Code, Index, Offset>& matrix,
+                              Vector& vector)
+            {
+                Vector temp(matrix.rows());
+                matrix.multiply(vector, temp);
+                using std::swap;
+                swap(vector, temp);
+            }
+        };
+    } // namespace types
+} // namespace ieompp
+
+#endif
@@ -1,5 +1,6 @@
 #include "include/application.hpp"
 #include "include/common.hpp"
+#include "include/dry_run.hpp"
 #include "include/rk4.hpp"
 #include "include/vector.hpp"
 #include "momentum_space/momentum_space_1d.hpp"
@@ -41,9 +42,59 @@ int main(int argc, char** argv)
     BrillouinZone brillouin_zone(N);
     Lattice lattice(N, 1.);
 
+    if(app.dry_run) {
+        // one operator and N^2 three operator monomials, the first row of the matrix is dense and
+        // every other row holds the element of column 0 and the diagonal
+        const uint64_t rows      = N * N + 1;
+        const uint64_t non_zeros = 3 * rows - 2;
+        const auto matrix_bytes =
+            blaze_compressed_matrix_bytes<std::complex<double>>(rows, non_zeros);
+
+        BrillouinZone calibration_zone(std::min<uint64_t>(N, 64));
+        Lattice calibration_lattice(calibration_zone.size(), 1.);
+        const auto calibration_basis = hubbard::Basis3Operator<Monomial>(
+            calibration_zone.size() / 2, calibration_zone);
+        const auto L_calibration =
+            hubbard::make_liouvillian(calibration_zone, calibration_lattice, J, U);
+
+        // the number of non-vanishing expectation values grows linearly with the basis, it is
+        // exact for N <= 64
+        using Contribution = hubbard::NonVanishingExpectationValue<Operator::Index1, double>;
+        using State        = hubbard::ExcitedFermiSea<Monomial>;
+        const hubbard::ParticleNumber<double, Basis3> calibration_particle_number(
+            calibration_basis, init_conjugate_basis(calibration_basis),
+            L_calibration.dispersion, 0.);
+        const auto contributions =
+            calibration_particle_number.non_vanishing_expectation_values.size() * rows
+            / calibration_basis.size();
+
+        DryRun plan;
+        plan.add("basis", rows * sizeof(Monomial) + (3 * N * N + 1) * sizeof(Operator));
+        plan.add("matrix", matrix_bytes);
+        plan.add("expectation values", contributions * sizeof(Contribution));
+        // b_i^† |FS> of every basis element, each with at most three created or annihilated
+        // particles in list nodes of two pointers
+        plan.add_temporary("excited Fermi seas",
+                           rows * (sizeof(State) + 1
+                                   + 3 * (2 * sizeof(void*) + sizeof(Operator::Indices))));
+        add_rk4_vectors(plan, rows);
+        // the eight steps below
+        plan.set_propagation(rk4_step_bytes(matrix_bytes, rows), 8);
+
+        const auto M = compute_matrix(L_calibration, calibration_basis, calibration_lattice);
+        auto h                = init_vector(calibration_basis);
+        const auto integrator = init_rk4(calibration_basis.size(), dt);
+        plan.calibrate(rk4_step_bytes(blaze_compressed_matrix_bytes<std::complex<double>>(
+                                          M.rows(), M.nonZeros()),
+                                      M.rows()),
+                       [&] { integrator.step(M, h); });
+        plan.print(cout);
+        return 0;
+    }
+
     // init operator basis
     const auto basis           = hubbard::Basis3Operator<Monomial>(k_idx, brillouin_zone);
-    const auto conjugate_basis = basis.get_conjugate();
+    const auto conjugate_basis = init_conjugate_basis(basis);
 
     // computing matrix
     const auto L = hubbard::make_liouvillian(brillouin_zone, lattice, J, U);
@@ -3,6 +3,7 @@
 #include "include/rk4.hpp"
 #include "include/vector.hpp"
 #include "real_space/basis1.hpp"
+#include "real_space/dry_run.hpp"
 #include "real_space/liouvillian.hpp"
 #include "real_space/matrix.hpp"
 #include "real_space/periodic_chain.hpp"
@@ -36,12 +37,23 @@ int main(int argc, char** argv)
 
     const auto lattice         = init_lattice(N, 1.);
     const auto basis           = init_basis(lattice);
-    const auto conjugate_basis = basis.get_conjugate();
     const auto L               = init_liouvillian(J, 0.);
+
+    if(app.dry_run) {
+        // the one operator basis is small, the calibration runs on the actual matrix
+        DryRun plan;
+        plan.add("basis", basis.size() * (sizeof(basis[0]) + sizeof(basis[0][0])));
+        plan_compressed_rk4(plan, basis.size(), predict_kinetic_non_zeros(basis, lattice),
+                            number_of_steps(t_end, dt));
+        calibrate_rk4(plan, compute_kinetic_matrix(L, basis, lattice));
+        plan.print(cout);
+        return 0;
+    }
+
     const auto M               = compute_kinetic_matrix(L, basis, lattice);
 
     auto h                     = init_vector(basis);
-    const auto integrator      = init_rk4(basis.size(), dt);
+    auto integrator            = init_fused_rk4(basis.size(), dt);
 
     double t, last_measurement = 0.;
 
@@ -71,7 +83,7 @@ int main(int argc, char** argv)
         }
 
         get_loggers().ode->info("Integrate from t={}", t);
-        integrator.step(M, h);
+        integrator.step_imaginary(M, h);
         get_loggers().ode->info("Finished integration t={} -> t={}", t, t + integrator.step_size());
         t += integrator.step_size();
     }
@@ -3,6 +3,7 @@
 #include "include/rk4.hpp"
 #include "include/vector.hpp"
 #include "real_space/basis3.hpp"
+#include "real_space/dry_run.hpp"
 #include "real_space/expectation_value_1d.hpp"
 #include "real_space/liouvillian.hpp"
 #include "real_space/matrix.hpp"
@@ -27,6 +28,19 @@ int main(int argc, char** argv)
         ("t_end", make_value<double>(10), "stop time for simulation")
         ("measurement_interval", make_value<uint64_t>()->default_value(100), "interval between measurements in units of dt")
         ("filling_factor", make_value<double>(0.5), "filling factor of the initial Fermi sea")
+        ("matrix_free", make_value<bool>(false), "apply the Liouvillian on the fly instead of storing a sparse matrix")
+        ("sliced_ellpack", make_value<bool>(false), "store the Liouvillian in the vectorized SELL-C-sigma format")
+        ("value_dictionary", make_value<bool>(false), "store the Liouvillian as 8-bit codes into a table of its distinct values")
+        ("matrix_powers", make_value<bool>(false), "compute the four products of each RK4 step in one blocked sweep over the matrix, needs a banded ordering like rcm")
+        ("matrix_powers_block_rows", make_value<uint64_t>(1024), "number of rows per block of the matrix-powers kernel")
+        ("ordering", make_value<std::string>("lexicographic"), "order of the basis in the matrix and the state vector: lexicographic, rcm or blocked")
+        ("block_size", make_value<uint64_t>(8), "edge length of the site triple tiles for the blocked ordering")
+        ("point_group_symmetry", make_value<bool>(false), "propagate only the inversion symmetric sector of the basis, stores the Liouvillian as a sparse matrix")
+        ("krylov_dimension", make_value<uint64_t>(), "propagate with the exponential in Krylov spaces of this dimension instead of RK4 steps, dt * measurement_interval is the time between measurements, requires the default matrix format")
+        ("krylov_tolerance", make_value<double>(1e-10), "tolerance of the estimated error of the Krylov propagation per measurement interval")
+        ("chebyshev_tolerance", make_value<double>(), "propagate with the Chebyshev expansion of the exponential up to coefficients below this tolerance instead of RK4 steps, dt * measurement_interval is the time between measurements, requires the default matrix format")
+        ("chebyshev_intervals", make_value<uint64_t>(1), "number of measurement intervals covered by one Chebyshev expansion, each needs the memory of a state vector")
+        ("low_storage_rk", make_value<std::string>(), "propagate with a Runge-Kutta scheme that stores only one vector besides the state instead of RK4: ck4 (fourth order, five stages) or williamson3 (third order, three stages), requires the default matrix format")
         ;
     // clang-format on
 
@@ -39,55 +53,247 @@ int main(int argc, char** argv)
     const auto t_end                = app.variables["t_end"].as<double>();
     const auto measurement_interval = app.variables["measurement_interval"].as<uint64_t>();
     const auto filling_factor       = app.variables["filling_factor"].as<double>();
+    const auto matrix_free          = app.variables["matrix_free"].as<bool>();
+    const auto sliced_ellpack       = app.variables["sliced_ellpack"].as<bool>();
+    const auto value_dictionary     = app.variables["value_dictionary"].as<bool>();
+    const auto matrix_powers        = app.variables["matrix_powers"].as<bool>();
+    const auto powers_block_rows    = app.variables["matrix_powers_block_rows"].as<uint64_t>();
+    const auto ordering             = app.variables["ordering"].as<std::string>();
+    const auto block_size           = app.variables["block_size"].as<uint64_t>();
+    const auto point_group_symmetry = app.variables["point_group_symmetry"].as<bool>();
+    const auto krylov               = app.variables.count("krylov_dimension") != 0u;
+    const auto chebyshev            = app.variables.count("chebyshev_tolerance") != 0u;
+    const auto low_storage          = app.variables.count("low_storage_rk") != 0u;
 
-    const auto lattice         = init_lattice(N, 1.);
-    const auto basis           = init_basis(lattice);
-    const auto conjugate_basis = basis.get_conjugate();
-    const auto ev              = init_expectation_value(lattice, filling_factor);
-    const auto L               = init_liouvillian(J, U);
-    const auto M               = compute_matrix(L, basis, lattice);
+    const auto lattice = init_lattice(N, 1.);
+    const auto ev      = init_expectation_value(lattice, filling_factor);
+    const auto L       = init_liouvillian(J, U);
 
-    auto h                     = init_vector(basis);
-    const auto integrator      = init_rk4(basis.size(), dt);
-    const auto site_occupation = init_site_occupation(basis, conjugate_basis, ev);
+    if(int(krylov) + int(chebyshev) + int(low_storage) > 1) {
+        THROW(ieompp::Exception,
+              "Only one of the Krylov, the Chebyshev and the low-storage Runge-Kutta propagators "
+              "can be used");
+    }
+
+    if((krylov || chebyshev || low_storage) && !point_group_symmetry
+       && (matrix_free || sliced_ellpack || value_dictionary || matrix_powers)) {
+        get_loggers().main->warn("Ignoring the {} propagator for this matrix format",
+                                 krylov ? "Krylov" : (chebyshev ? "Chebyshev" : "low-storage"));
+    }
+
+    if(app.dry_run) {
+        if(point_group_symmetry) {
+            THROW(ieompp::Exception, "The matrix of the symmetric sector cannot be predicted, its "
+                                     "elements are merged during the assembly");
+        }
+
+        const auto basis     = init_basis(lattice);
+        const auto rows      = basis.size();
+        const auto non_zeros = predict_non_zeros(basis, lattice);
+        const auto steps     = number_of_steps(t_end, dt);
+        const auto intervals = number_of_steps(t_end, dt * measurement_interval);
+
+        // about 10^5 basis elements, larger than the caches but quickly assembled
+        const auto calibration_lattice = init_lattice(std::min<uint64_t>(N, 48), 1.);
+        const auto calibration_basis   = init_basis(calibration_lattice);
+
+        DryRun plan;
+        plan.add("basis", sizeof(basis));
+        if(matrix_free) {
+            const auto calibration_matrix =
+                compute_matrix_free(L, calibration_basis, calibration_lattice);
+            plan_rk4(plan, rows, plan_matrix_free(plan, basis, lattice), steps);
+            calibrate_rk4(plan, calibration_matrix,
+                          matrix_free_bytes(calibration_basis, calibration_lattice));
+            plan.print(cout);
+            return 0;
+        }
+
+        // the calibration matrix is ordered like the matrix of the full basis
+        auto calibration_matrix = compute_matrix(L, calibration_basis, calibration_lattice);
+        const auto matrix_bytes = plan_compressed_matrix(plan, rows, non_zeros);
+        if(ordering != "lexicographic") {
+            calibration_matrix = reorder_matrix(
+                calibration_matrix, compute_basis_ordering(ordering, block_size, calibration_basis,
+                                                           calibration_matrix));
+            if(ordering == "rcm") {
+                plan_basis_ordering<decltype(calibration_matrix)::Index>(plan, rows, non_zeros);
+            } else {
+                plan_basis_ordering<Basis::BasisIndex>(plan, rows, non_zeros);
+            }
+        }
+
+        if(sliced_ellpack) {
+            const auto calibration_sell = compute_sliced_ellpack_matrix(calibration_matrix);
+            plan_rk4(plan, rows,
+                     plan_sliced_ellpack_matrix(
+                         plan, rows,
+                         predict_sliced_ellpack_elements(basis, lattice, ordering, block_size)),
+                     steps);
+            calibrate_rk4(plan, calibration_sell,
+                          sliced_ellpack_matrix_bytes<double>(calibration_sell.rows(),
+                                                              calibration_sell.stored_elements()));
+        } else if(value_dictionary) {
+            // the distinct values do not depend on the size of the lattice
+            const auto calibration_vd = compute_value_dictionary_matrix(calibration_matrix);
+            plan_rk4(plan, rows,
+                     plan_value_dictionary_matrix(plan, rows, non_zeros,
+                                                  calibration_vd.table().size()),
+                     steps);
+            calibrate_rk4(plan, calibration_vd,
+                          value_dictionary_matrix_bytes<double>(calibration_vd.rows(),
+                                                                calibration_vd.non_zeros(),
+                                                                calibration_vd.table().size()));
+        } else if(matrix_powers) {
+            plan_matrix_powers_rk4(plan, rows, matrix_bytes, steps);
+            calibrate_matrix_powers_rk4(
+                plan, compute_matrix_powers(std::move(calibration_matrix), powers_block_rows));
+        } else if(low_storage) {
+            const auto tableau =
+                low_storage_tableau<double>(app.variables["low_storage_rk"].as<std::string>());
+            plan_low_storage_rk(plan, rows, matrix_bytes, steps, tableau.stages());
+            calibrate_low_storage_rk(plan, calibration_matrix, tableau);
+        } else if(chebyshev) {
+            plan_chebyshev(plan, rows, matrix_bytes, intervals, calibration_matrix,
+                           dt * measurement_interval,
+                           app.variables["chebyshev_tolerance"].as<double>(),
+                           app.variables["chebyshev_intervals"].as<uint64_t>());
+        } else if(krylov) {
+            plan_krylov(plan, rows, matrix_bytes, intervals, calibration_matrix,
+                        dt * measurement_interval, app.variables["krylov_dimension"].as<uint64_t>(),
+                        app.variables["krylov_tolerance"].as<double>());
+        } else {
+            plan_fused_rk4(plan, rows, matrix_bytes, steps);
+            calibrate_rk4(plan, calibration_matrix);
+        }
+        plan.print(cout);
+        return 0;
+    }
 
     double obs, t, last_measurement = 0.;
 
-    get_loggers().main->info("Measuring at t=0");
-    obs = site_occupation(h);
-    get_loggers().main->info(u8"  <n_{{0,↑}}>(0) = {}", obs);
-    app.output_file << 0 << '\t' << obs << '\n';
-    app.output_file.flush();
-    get_loggers().main->info("Finish measurement at t=0");
-    last_measurement = 0;
+    // propagate h with M and measure observable(h) at the measurement intervals
+    const auto run_with = [&](auto& h, const auto& observable, const auto& M, auto& integrator) {
+        get_loggers().main->info("Measuring at t=0");
+        obs = observable(h);
+        get_loggers().main->info(u8"  <n_{{0,↑}}>(0) = {}", obs);
+        app.output_file << 0 << '\t' << obs << '\n';
+        app.output_file.flush();
+        get_loggers().main->info("Finish measurement at t=0");
+        last_measurement = 0;
+
+        get_loggers().main->info("h[0] = {}", h[0]);
 
-    get_loggers().main->info("h[0] = {}", h[0]);
+        for(t = 0.; t < t_end;) {
+            if(has_time_interval_passed(t, last_measurement, dt, measurement_interval)) {
+                get_loggers().main->info("Measuring at t={}", t);
+                obs = observable(h);
+                get_loggers().main->info(u8"  <n_{{0,↑}}>({}) = {}", t, obs);
+                app.output_file << t << '\t' << obs << '\n';
+                app.output_file.flush();
+                get_loggers().main->info("Finish measurement at t={}", t);
+                last_measurement = t;
+            }
+
+            get_loggers().ode->info("Integrate from t={}", t);
+            integrator.step_imaginary(M, h);
+            get_loggers().ode->info("Finished integration t={} -> t={}", t,
+                                    t + integrator.step_size());
+            t += integrator.step_size();
+        }
 
-    for(t = 0.; t < t_end;) {
         if(has_time_interval_passed(t, last_measurement, dt, measurement_interval)) {
             get_loggers().main->info("Measuring at t={}", t);
-            obs = site_occupation(h);
+            obs = observable(h);
             get_loggers().main->info(u8"  <n_{{0,↑}}>({}) = {}", t, obs);
             app.output_file << t << '\t' << obs << '\n';
             app.output_file.flush();
             get_loggers().main->info("Finish measurement at t={}", t);
             last_measurement = t;
         }
+    };
+
+    const auto run = [&](auto& h, const auto& observable, const auto& M) {
+        auto integrator = init_rk4(M, h.size(), dt);
+        run_with(h, observable, M, integrator);
+    };
+
+    // the Krylov spaces, the Chebyshev expansion and the low-storage stages are computed along
+    // the rows of the CompressedRowMatrix
+    const auto run_compressed = [&](auto& h, const auto& observable, const auto& M) {
+        if(low_storage) {
+            auto integrator = init_low_storage_rk(
+                h.size(), dt, app.variables["low_storage_rk"].as<std::string>());
+            run_with(h, observable, M, integrator);
+            return;
+        }
+        if(chebyshev) {
+            auto integrator = init_chebyshev(h.size(), dt * measurement_interval,
+                                             app.variables["chebyshev_tolerance"].as<double>(),
+                                             app.variables["chebyshev_intervals"].as<uint64_t>());
+            run_with(h, observable, M, integrator);
+            get_loggers().ode->info("Finished with {} expansions and {} products",
+                                    integrator.expansions(), integrator.products());
+            return;
+        }
+        if(!krylov) {
+            run(h, observable, M);
+            return;
+        }
+        auto integrator = init_krylov(h.size(), dt * measurement_interval,
+                                      app.variables["krylov_dimension"].as<uint64_t>(),
+                                      app.variables["krylov_tolerance"].as<double>());
+        run_with(h, observable, M, integrator);
+        get_loggers().ode->info("Finished with {} substeps ({} rejected) and {} products",
+                                integrator.substeps(), integrator.rejected_substeps(),
+                                integrator.products());
+    };
+
+    if(point_group_symmetry) {
+        if(matrix_free || sliced_ellpack || value_dictionary || matrix_powers
+           || (ordering != "lexicographic")) {
+            get_loggers().main->warn(
+                "Ignoring matrix format and ordering options for the symmetric sector");
+        }
 
-        get_loggers().ode->info("Integrate from t={}", t);
-        integrator.step(M, h);
-        get_loggers().ode->info("Finished integration t={} -> t={}", t, t + integrator.step_size());
-        t += integrator.step_size();
+        const auto basis           = init_symmetric_basis(lattice);
+        const auto site_occupation = init_site_occupation(basis, ev);
+        auto h                     = init_vector(basis);
+        run_compressed(h, site_occupation, compute_matrix(L, basis, lattice));
+        return 0;
     }
 
-    if(has_time_interval_passed(t, last_measurement, dt, measurement_interval)) {
-        get_loggers().main->info("Measuring at t={}", t);
-        obs = site_occupation(h);
-        get_loggers().main->info(u8"  <n_{{0,↑}}>({}) = {}", t, obs);
-        app.output_file << t << '\t' << obs << '\n';
-        app.output_file.flush();
-        get_loggers().main->info("Finish measurement at t={}", t);
-        last_measurement = t;
+    const auto basis           = init_basis(lattice);
+    const auto conjugate_basis = init_conjugate_basis(basis);
+    auto site_occupation       = init_site_occupation(basis, conjugate_basis, ev);
+    auto h                     = init_vector(basis);
+
+    if(matrix_free) {
+        if(ordering != "lexicographic") {
+            get_loggers().main->warn("Ignoring {} ordering for the matrix-free Liouvillian",
+                                     ordering);
+        }
+        run(h, site_occupation, compute_matrix_free(L, basis, lattice));
+    } else {
+        auto M = compute_matrix(L, basis, lattice);
+        if(ordering != "lexicographic") {
+            // h is propagated in the order of the permutation, the observable reads its
+            // coefficients at the permuted positions
+            const auto permutation = compute_basis_ordering(ordering, block_size, basis, M);
+            M                      = reorder_matrix(M, permutation);
+            h = permutation.apply(h);
+            site_occupation.permute(permutation);
+        }
+
+        if(sliced_ellpack) {
+            run(h, site_occupation, compute_sliced_ellpack_matrix(M));
+        } else if(value_dictionary) {
+            run(h, site_occupation, compute_value_dictionary_matrix(M));
+        } else if(matrix_powers) {
+            run(h, site_occupation, compute_matrix_powers(std::move(M), powers_block_rows));
+        } else {
+            run_compressed(h, site_occupation, M);
+        }
     }
 
     return 0;
@@ -3,6 +3,7 @@
 #include "include/rk4.hpp"
 #include "include/vector.hpp"
 #include "real_space/basis3.hpp"
+#include "real_space/dry_run.hpp"
 #include "real_space/liouvillian.hpp"
 #include "real_space/matrix.hpp"
 #include "real_space/periodic_chain.hpp"
@@ -38,12 +39,26 @@ int main(int argc, char** argv)
 
     const auto lattice         = init_lattice(N, 1.);
     const auto basis           = init_basis(lattice);
-    const auto conjugate_basis = basis.get_conjugate();
     const auto L               = init_liouvillian(J, U);
+
+    if(app.dry_run) {
+        DryRun plan;
+        plan.add("basis", sizeof(basis));
+        plan_compressed_rk4(plan, basis.size(), predict_non_zeros(basis, lattice),
+                            number_of_steps(t_end, dt));
+
+        // about 10^5 basis elements, larger than the caches but quickly assembled
+        const auto calibration_lattice = init_lattice(std::min<uint64_t>(N, 48), 1.);
+        const auto calibration_basis = init_basis(calibration_lattice);
+        calibrate_rk4(plan, compute_matrix(L, calibration_basis, calibration_lattice));
+        plan.print(cout);
+        return 0;
+    }
+
     const auto M               = compute_matrix(L, basis, lattice);
 
     auto h                     = init_vector(basis);
-    const auto integrator      = init_rk4(basis.size(), dt);
+    auto integrator            = init_fused_rk4(basis.size(), dt);
 
     double t, last_measurement = 0.;
 
@@ -73,7 +88,7 @@ int main(int argc, char** argv)
         }
 
         get_loggers().ode->info("Integrate from t={}", t);
-        integrator.step(M, h);
+        integrator.step_imaginary(M, h);
         get_loggers().ode->info("Finished integration t={} -> t={}", t, t + integrator.step_size());
         t += integrator.step_size();
     }
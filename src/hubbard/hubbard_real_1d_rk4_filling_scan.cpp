@@ -0,0 +1,138 @@
+#include "include/application.hpp"
+#include "include/common.hpp"
+#include "include/rk4.hpp"
+#include "include/vector.hpp"
+#include "real_space/basis3.hpp"
+#include "real_space/dry_run.hpp"
+#include "real_space/expectation_value_1d.hpp"
+#include "real_space/fermi_jump_no.hpp"
+#include "real_space/liouvillian.hpp"
+#include "real_space/matrix_no.hpp"
+#include "real_space/periodic_chain.hpp"
+using namespace std;
+
+namespace hubbard = ieompp::models::hubbard_real_space;
+
+int main(int argc, char** argv)
+{
+    Application::name = "hubbard_real_1d_rk4_filling_scan";
+    Application::description =
+        "Calculate <Δn_{k_F,↑}>(t) for the normal ordered 1d Hubbard model for several filling "
+        "factors";
+    Application::add_default_options();
+
+    // clang-format off
+    Application::options_description.add_options()
+        ("N", make_value<uint64_t>(16), "number of lattice sites")
+        ("J", make_value<double>(1.), "hopping prefactor")
+        ("U", make_value<double>(1.), "interaction strength")
+        ("filling_min", make_value<double>(0.2), "smallest filling factor of the initial Fermi sea")
+        ("filling_max", make_value<double>(0.5), "largest filling factor of the initial Fermi sea")
+        ("filling_steps", make_value<uint64_t>(4), "number of filling factors")
+        ("dt", make_value<double>(0.01), "step width of RK4 integrator")
+        ("t_end", make_value<double>(10), "stop time for simulation")
+        ("measurement_interval", make_value<uint64_t>()->default_value(100), "interval between measurements in units of dt")
+        ;
+    // clang-format on
+
+    Application app(argc, argv);
+
+    const auto N                    = app.variables["N"].as<uint64_t>();
+    const auto J                    = app.variables["J"].as<double>();
+    const auto U                    = app.variables["U"].as<double>();
+    const auto filling_min          = app.variables["filling_min"].as<double>();
+    const auto filling_max          = app.variables["filling_max"].as<double>();
+    const auto filling_steps        = app.variables["filling_steps"].as<uint64_t>();
+    const auto dt                   = app.variables["dt"].as<double>();
+    const auto t_end                = app.variables["t_end"].as<double>();
+    const auto measurement_interval = app.variables["measurement_interval"].as<uint64_t>();
+
+    const auto L       = init_liouvillian(J, U);
+    const auto lattice = init_lattice(N, 1.);
+    const auto basis   = init_basis(lattice);
+
+    if(app.dry_run) {
+        // the number of elements and terms per row hardly depends on N, they are extrapolated
+        // from a small problem
+        const auto calibration_lattice = init_lattice(std::min<uint64_t>(N, 48), 1.);
+        const auto calibration_basis   = init_basis(calibration_lattice);
+        const auto calibration_ev      = init_expectation_value(calibration_lattice, filling_max);
+
+        const auto symbolic = compute_symbolic_matrix(calibration_basis, calibration_lattice);
+        const auto scale    = double(basis.size()) / double(calibration_basis.size());
+
+        DryRun plan;
+        plan.add("basis", sizeof(basis));
+        plan_symbolic_rk4<Basis::BasisIndex>(
+            plan, basis.size(), uint64_t(scale * symbolic.non_zeros()),
+            uint64_t(scale * symbolic.terms.size()), filling_steps * number_of_steps(t_end, dt));
+        calibrate_rk4(plan, compute_numeric_matrix(symbolic, L, calibration_ev));
+        plan.print(cout);
+        return 0;
+    }
+
+    // the sparsity pattern and the recipes of the elements do not depend on the expectation
+    // values, only the values are evaluated again for each filling factor
+    const auto symbolic   = compute_symbolic_matrix(basis, lattice);
+    const auto initial_ev = init_expectation_value(lattice, filling_min);
+    auto M                = compute_numeric_matrix(symbolic, L, initial_ev);
+    auto integrator       = init_fused_rk4(basis.size(), dt);
+
+    for(uint64_t step = 0; step < filling_steps; ++step) {
+        const auto filling_factor =
+            (filling_steps > 1)
+                ? filling_min + (filling_max - filling_min) * double(step) / (filling_steps - 1)
+                : filling_min;
+        const auto ev         = init_expectation_value(lattice, filling_factor);
+        const auto fermi_jump = init_fermi_jump(basis, lattice, ev, filling_factor);
+        if(step > 0) {
+            update_numeric_matrix(symbolic, L, ev, M);
+        }
+
+        auto h = init_vector(basis);
+
+        double obs, t, last_measurement = 0.;
+
+        app.output_file << "# filling_factor = " << filling_factor << '\n';
+
+        get_loggers().main->info("Measuring at t=0");
+        obs = fermi_jump(h);
+        get_loggers().main->info(u8"  <Δn_{{k_F,↑}}>(0) = {}", obs);
+        app.output_file << 0 << '\t' << obs << '\n';
+        app.output_file.flush();
+        get_loggers().main->info("Finish measurement at t=0");
+        last_measurement = 0;
+
+        for(t = 0.; t < t_end;) {
+            if(has_time_interval_passed(t, last_measurement, dt, measurement_interval)) {
+                get_loggers().main->info("Measuring at t={}", t);
+                obs = fermi_jump(h);
+                get_loggers().main->info(u8"  <Δn_{{k_F,↑}}>({}) = {}", t, obs);
+                app.output_file << t << '\t' << obs << '\n';
+                app.output_file.flush();
+                get_loggers().main->info("Finish measurement at t={}", t);
+                last_measurement = t;
+            }
+
+            get_loggers().ode->info("Integrate from t={}", t);
+            integrator.step_imaginary(M, h);
+            get_loggers().ode->info("Finished integration t={} -> t={}", t,
+                                    t + integrator.step_size());
+            t += integrator.step_size();
+        }
+
+        if(has_time_interval_passed(t, last_measurement, dt, measurement_interval)) {
+            get_loggers().main->info("Measuring at t={}", t);
+            obs = fermi_jump(h);
+            get_loggers().main->info(u8"  <Δn_{{k_F,↑}}>({}) = {}", t, obs);
+            app.output_file << t << '\t' << obs << '\n';
+            app.output_file.flush();
+            get_loggers().main->info("Finish measurement at t={}", t);
+            last_measurement = t;
+        }
+
+        app.output_file << "\n\n";
+    }
+
+    return 0;
+}
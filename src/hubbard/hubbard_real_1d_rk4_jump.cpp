@@ -3,6 +3,7 @@
 #include "include/rk4.hpp"
 #include "include/vector.hpp"
 #include "real_space/basis3.hpp"
+#include "real_space/dry_run.hpp"
 #include "real_space/expectation_value_1d.hpp"
 #include "real_space/fermi_jump.hpp"
 #include "real_space/liouvillian.hpp"
@@ -27,6 +28,14 @@ int main(int argc, char** argv)
         ("t_end", make_value<double>(10), "stop time for simulation")
         ("measurement_interval", make_value<uint64_t>()->default_value(100), "interval between measurements in units of dt")
         ("filling_factor", make_value<double>(0.5), "filling factor of the initial Fermi sea")
+        ("translation_symmetry", make_value<bool>(false), "propagate only the momentum sector k_F of the translation invariant basis, N * filling_factor / 2 has to be an integer")
+        ("point_group_symmetry", make_value<bool>(false), "propagate only the inversion symmetric sector of the basis")
+        ("distance_cutoff", make_value<uint64_t>(), "keep only the three operator terms whose sites are at most this lattice distance apart")
+        ("active_set_tolerance", make_value<double>(), "only update the coefficients within four hops of a coefficient above this tolerance until half of the basis is active")
+        ("adaptive_threshold", make_value<double>(), "start with the one operator terms and add the three operator terms whose coefficients grow faster than this threshold")
+        ("rk45_tolerance", make_value<double>(), "integrate with adaptive Dormand-Prince steps to this absolute tolerance, dt * measurement_interval is the time between measurements")
+        ("rk45_relative_tolerance", make_value<double>(0.), "relative tolerance of the Dormand-Prince steps")
+        ("low_storage_rk", make_value<std::string>(), "propagate with a Runge-Kutta scheme that stores only one vector besides the state instead of RK4: ck4 (fourth order, five stages) or williamson3 (third order, three stages)")
         ;
     // clang-format on
 
@@ -39,28 +48,50 @@ int main(int argc, char** argv)
     const auto t_end                = app.variables["t_end"].as<double>();
     const auto measurement_interval = app.variables["measurement_interval"].as<uint64_t>();
     const auto filling_factor       = app.variables["filling_factor"].as<double>();
+    const auto translation_symmetry = app.variables["translation_symmetry"].as<bool>();
+    const auto point_group_symmetry = app.variables["point_group_symmetry"].as<bool>();
+    const auto truncate             = app.variables.count("distance_cutoff") != 0u;
+    const auto active_set           = app.variables.count("active_set_tolerance") != 0u;
+    const auto adaptive             = app.variables.count("adaptive_threshold") != 0u;
+    const auto rk45                 = app.variables.count("rk45_tolerance") != 0u;
+    const auto low_storage          = app.variables.count("low_storage_rk") != 0u;
 
     const auto lattice = init_lattice(N, 1.);
-    const auto basis   = init_basis(lattice);
     const auto ev      = init_expectation_value(lattice, filling_factor);
     const auto L       = init_liouvillian(J, U);
-    const auto M       = compute_matrix(L, basis, lattice);
 
-    auto h                = init_vector(basis);
-    const auto integrator = init_rk4(basis.size(), dt);
-    const auto fermi_jump = init_fermi_jump(basis, lattice, ev, filling_factor);
+    const auto run = [&](const auto& basis, auto& M, auto& integrator) {
+        auto h                = init_vector(basis);
+        const auto fermi_jump = init_fermi_jump(basis, lattice, ev, filling_factor);
 
-    double obs, t, last_measurement = 0.;
+        double obs, t, last_measurement = 0.;
 
-    get_loggers().main->info("Measuring at t=0");
-    obs = fermi_jump(h);
-    get_loggers().main->info(u8"  <Δn_{{k_F,↑}}>(0) = {}", obs);
-    app.output_file << 0 << '\t' << obs << '\n';
-    app.output_file.flush();
-    get_loggers().main->info("Finish measurement at t=0");
-    last_measurement = 0;
+        get_loggers().main->info("Measuring at t=0");
+        obs = fermi_jump(h);
+        get_loggers().main->info(u8"  <Δn_{{k_F,↑}}>(0) = {}", obs);
+        app.output_file << 0 << '\t' << obs << '\n';
+        app.output_file.flush();
+        get_loggers().main->info("Finish measurement at t=0");
+        last_measurement = 0;
+
+        for(t = 0.; t < t_end;) {
+            if(has_time_interval_passed(t, last_measurement, dt, measurement_interval)) {
+                get_loggers().main->info("Measuring at t={}", t);
+                obs = fermi_jump(h);
+                get_loggers().main->info(u8"  <Δn_{{k_F,↑}}>({}) = {}", t, obs);
+                app.output_file << t << '\t' << obs << '\n';
+                app.output_file.flush();
+                get_loggers().main->info("Finish measurement at t={}", t);
+                last_measurement = t;
+            }
+
+            get_loggers().ode->info("Integrate from t={}", t);
+            integrator.step_imaginary(M, h);
+            get_loggers().ode->info("Finished integration t={} -> t={}", t,
+                                    t + integrator.step_size());
+            t += integrator.step_size();
+        }
 
-    for(t = 0.; t < t_end;) {
         if(has_time_interval_passed(t, last_measurement, dt, measurement_interval)) {
             get_loggers().main->info("Measuring at t={}", t);
             obs = fermi_jump(h);
@@ -70,21 +101,120 @@ int main(int argc, char** argv)
             get_loggers().main->info("Finish measurement at t={}", t);
             last_measurement = t;
         }
+    };
 
-        get_loggers().ode->info("Integrate from t={}", t);
-        integrator.step(M, h);
-        get_loggers().ode->info("Finished integration t={} -> t={}", t, t + integrator.step_size());
-        t += integrator.step_size();
+    const auto propagate = [&](const auto& basis, const auto& M) {
+        if(low_storage) {
+            auto integrator = init_low_storage_rk(
+                basis.size(), dt, app.variables["low_storage_rk"].as<std::string>());
+            run(basis, M, integrator);
+        } else if(active_set) {
+            auto integrator = init_active_set_rk4(
+                basis.size(), dt, app.variables["active_set_tolerance"].as<double>());
+            run(basis, M, integrator);
+        } else if(rk45) {
+            auto integrator =
+                init_dormand_prince(basis.size(), dt * measurement_interval,
+                                    app.variables["rk45_tolerance"].as<double>(),
+                                    app.variables["rk45_relative_tolerance"].as<double>());
+            run(basis, M, integrator);
+            get_loggers().ode->info("Finished with {} accepted and {} rejected steps",
+                                    integrator.accepted_steps(), integrator.rejected_steps());
+        } else {
+            auto integrator = init_fused_rk4(basis.size(), dt);
+            run(basis, M, integrator);
+        }
+    };
+
+    if(translation_symmetry && point_group_symmetry) {
+        THROW(ieompp::Exception,
+              "The translation and the point group symmetry cannot be combined, the sector k_F "
+              "is not inversion symmetric");
+    }
+    if(truncate && (translation_symmetry || point_group_symmetry)) {
+        THROW(ieompp::Exception, "The distance cutoff cannot be combined with a symmetric sector");
+    }
+    if(adaptive
+       && (translation_symmetry || point_group_symmetry || truncate || active_set || rk45
+           || low_storage)) {
+        THROW(ieompp::Exception,
+              "The adaptive basis cannot be combined with a symmetric sector, the distance "
+              "cutoff, the active set, the Dormand-Prince or the low-storage Runge-Kutta steps");
+    }
+    if(int(rk45) + int(active_set) + int(low_storage) > 1) {
+        THROW(ieompp::Exception,
+              "Only one of the Dormand-Prince steps, the active set and the low-storage "
+              "Runge-Kutta steps can be used");
     }
 
-    if(has_time_interval_passed(t, last_measurement, dt, measurement_interval)) {
-        get_loggers().main->info("Measuring at t={}", t);
-        obs = fermi_jump(h);
-        get_loggers().main->info(u8"  <Δn_{{k_F,↑}}>({}) = {}", t, obs);
-        app.output_file << t << '\t' << obs << '\n';
-        app.output_file.flush();
-        get_loggers().main->info("Finish measurement at t={}", t);
-        last_measurement = t;
+    if(app.dry_run) {
+        if(translation_symmetry || point_group_symmetry || truncate || adaptive) {
+            THROW(ieompp::Exception,
+                  "The matrix of a symmetric sector, the truncated or the adaptive basis cannot "
+                  "be predicted, its elements are only known after the assembly");
+        }
+
+        const auto basis     = init_basis(lattice);
+        const auto rows      = basis.size();
+        const auto non_zeros = predict_non_zeros(basis, lattice);
+        const auto steps     = number_of_steps(t_end, dt);
+
+        // about 10^5 basis elements, larger than the caches but quickly assembled
+        const auto calibration_lattice = init_lattice(std::min<uint64_t>(N, 48), 1.);
+        const auto calibration_basis   = init_basis(calibration_lattice);
+        const auto calibration_matrix  = compute_matrix(L, calibration_basis, calibration_lattice);
+
+        DryRun plan;
+        plan.add("basis", sizeof(basis));
+        plan.add("Fermi jump", vector_bytes(basis.N));
+        const auto matrix_bytes = plan_compressed_matrix(plan, rows, non_zeros);
+        if(low_storage) {
+            const auto tableau =
+                low_storage_tableau<double>(app.variables["low_storage_rk"].as<std::string>());
+            plan_low_storage_rk(plan, rows, matrix_bytes, steps, tableau.stages());
+            calibrate_low_storage_rk(plan, calibration_matrix, tableau);
+        } else if(active_set) {
+            plan_active_set_rk4(plan, rows, matrix_bytes, steps);
+            calibrate_active_set_rk4(plan, calibration_matrix);
+        } else if(rk45) {
+            plan_dormand_prince(plan, rows, matrix_bytes,
+                                number_of_steps(t_end, dt * measurement_interval),
+                                calibration_matrix, dt * measurement_interval,
+                                app.variables["rk45_tolerance"].as<double>(),
+                                app.variables["rk45_relative_tolerance"].as<double>());
+        } else {
+            plan_fused_rk4(plan, rows, matrix_bytes, steps);
+            calibrate_rk4(plan, calibration_matrix);
+        }
+        plan.print(cout);
+        return 0;
+    }
+
+    // the initial operator c_{0,↑}^† has the coefficient 1 in every momentum sector and is
+    // invariant under the point group
+    if(translation_symmetry) {
+        const auto basis = init_translation_basis(
+            lattice, ieompp::models::hubbard::calculate_fermi_momentum_1d(filling_factor));
+        propagate(basis, compute_matrix(L, basis, lattice));
+    } else if(point_group_symmetry) {
+        const auto basis = init_symmetric_basis(lattice);
+        propagate(basis, compute_matrix(L, basis, lattice));
+    } else if(adaptive) {
+        // the integrator inserts new elements into the basis and appends their rows to M
+        auto basis      = init_adaptive_basis(lattice);
+        auto M          = compute_adaptive_matrix(L, basis, lattice);
+        auto integrator = init_adaptive_rk4(dt, app.variables["adaptive_threshold"].as<double>());
+        run(basis, M, integrator);
+        get_loggers().main->info("Finished with {} out of {} elements, error indicator {}",
+                                 basis.size(), basis.real_space_basis.size(),
+                                 integrator.error_indicator());
+    } else if(truncate) {
+        const auto basis =
+            init_truncated_basis(lattice, app.variables["distance_cutoff"].as<uint64_t>());
+        propagate(basis, compute_matrix(L, basis, lattice));
+    } else {
+        const auto basis = init_basis(lattice);
+        propagate(basis, compute_matrix(L, basis, lattice));
     }
 
     return 0;
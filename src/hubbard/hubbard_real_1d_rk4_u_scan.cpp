@@ -0,0 +1,128 @@
+#include "include/application.hpp"
+#include "include/common.hpp"
+#include "include/rk4.hpp"
+#include "include/vector.hpp"
+#include "real_space/basis3.hpp"
+#include "real_space/dry_run.hpp"
+#include "real_space/expectation_value_1d.hpp"
+#include "real_space/liouvillian.hpp"
+#include "real_space/matrix.hpp"
+#include "real_space/periodic_chain.hpp"
+#include "real_space/site_occupation.hpp"
+using namespace std;
+
+namespace hubbard = ieompp::models::hubbard_real_space;
+
+int main(int argc, char** argv)
+{
+    Application::name        = "hubbard_real_1d_rk4_u_scan";
+    Application::description = "Calculate <n_{0,↑}>(t) for the 1d Hubbard model for several U";
+    Application::add_default_options();
+
+    // clang-format off
+    Application::options_description.add_options()
+        ("N", make_value<uint64_t>(16), "number of lattice sites")
+        ("J", make_value<double>(1.), "hopping prefactor")
+        ("U_min", make_value<double>(0.), "smallest interaction strength")
+        ("U_max", make_value<double>(2.), "largest interaction strength")
+        ("U_steps", make_value<uint64_t>(5), "number of interaction strengths")
+        ("dt", make_value<double>(0.01), "step width of RK4 integrator")
+        ("t_end", make_value<double>(10), "stop time for simulation")
+        ("measurement_interval", make_value<uint64_t>()->default_value(100), "interval between measurements in units of dt")
+        ("filling_factor", make_value<double>(0.5), "filling factor of the initial Fermi sea")
+        ;
+    // clang-format on
+
+    Application app(argc, argv);
+
+    const auto N                    = app.variables["N"].as<uint64_t>();
+    const auto J                    = app.variables["J"].as<double>();
+    const auto U_min                = app.variables["U_min"].as<double>();
+    const auto U_max                = app.variables["U_max"].as<double>();
+    const auto U_steps              = app.variables["U_steps"].as<uint64_t>();
+    const auto dt                   = app.variables["dt"].as<double>();
+    const auto t_end                = app.variables["t_end"].as<double>();
+    const auto measurement_interval = app.variables["measurement_interval"].as<uint64_t>();
+    const auto filling_factor       = app.variables["filling_factor"].as<double>();
+
+    const auto lattice = init_lattice(N, 1.);
+
+    if(app.dry_run) {
+        const auto basis = init_basis(lattice);
+        DryRun plan;
+        plan.add("basis", sizeof(basis));
+        plan_split_rk4<Basis::BasisIndex>(plan, basis.size(), predict_non_zeros(basis, lattice),
+                                          U_steps * number_of_steps(t_end, dt));
+
+        // about 10^5 basis elements, larger than the caches but quickly assembled
+        const auto calibration_lattice = init_lattice(std::min<uint64_t>(N, 48), 1.);
+        calibrate_rk4(plan, compute_matrix(init_liouvillian(J, U_min),
+                                           init_basis(calibration_lattice), calibration_lattice));
+        plan.print(cout);
+        return 0;
+    }
+
+    const auto basis           = init_basis(lattice);
+    const auto conjugate_basis = init_conjugate_basis(basis);
+    const auto ev              = init_expectation_value(lattice, filling_factor);
+    const auto site_occupation = init_site_occupation(basis, conjugate_basis, ev);
+
+    // the sparsity pattern does not depend on U, only the values are updated in the loop below
+    const auto split = compute_split_matrix(basis, lattice);
+    auto M           = compute_matrix(split, init_liouvillian(J, U_min));
+    auto integrator  = init_fused_rk4(basis.size(), dt);
+
+    for(uint64_t step = 0; step < U_steps; ++step) {
+        const auto U =
+            (U_steps > 1) ? U_min + (U_max - U_min) * double(step) / (U_steps - 1) : U_min;
+        if(step > 0) {
+            update_matrix(split, init_liouvillian(J, U), M);
+        }
+
+        auto h = init_vector(basis);
+
+        double obs, t, last_measurement = 0.;
+
+        app.output_file << "# U = " << U << '\n';
+
+        get_loggers().main->info("Measuring at t=0");
+        obs = site_occupation(h);
+        get_loggers().main->info(u8"  <n_{{0,↑}}>(0) = {}", obs);
+        app.output_file << 0 << '\t' << obs << '\n';
+        app.output_file.flush();
+        get_loggers().main->info("Finish measurement at t=0");
+        last_measurement = 0;
+
+        for(t = 0.; t < t_end;) {
+            if(has_time_interval_passed(t, last_measurement, dt, measurement_interval)) {
+                get_loggers().main->info("Measuring at t={}", t);
+                obs = site_occupation(h);
+                get_loggers().main->info(u8"  <n_{{0,↑}}>({}) = {}", t, obs);
+                app.output_file << t << '\t' << obs << '\n';
+                app.output_file.flush();
+                get_loggers().main->info("Finish measurement at t={}", t);
+                last_measurement = t;
+            }
+
+            get_loggers().ode->info("Integrate from t={}", t);
+            integrator.step_imaginary(M, h);
+            get_loggers().ode->info("Finished integration t={} -> t={}", t,
+                                    t + integrator.step_size());
+            t += integrator.step_size();
+        }
+
+        if(has_time_interval_passed(t, last_measurement, dt, measurement_interval)) {
+            get_loggers().main->info("Measuring at t={}", t);
+            obs = site_occupation(h);
+            get_loggers().main->info(u8"  <n_{{0,↑}}>({}) = {}", t, obs);
+            app.output_file << t << '\t' << obs << '\n';
+            app.output_file.flush();
+            get_loggers().main->info("Finish measurement at t={}", t);
+            last_measurement = t;
+        }
+
+        app.output_file << "\n\n";
+    }
+
+    return 0;
+}
@@ -3,6 +3,7 @@
 #include "include/rk4.hpp"
 #include "include/vector.hpp"
 #include "real_space/basis3.hpp"
+#include "real_space/dry_run.hpp"
 #include "real_space/expectation_value_2d.hpp"
 #include "real_space/liouvillian.hpp"
 #include "real_space/matrix.hpp"
@@ -29,6 +30,16 @@ int main(int argc, char** argv)
         ("measurement_interval", make_value<uint64_t>()->default_value(100), "interval between measurements in units of dt")
         ("kx", make_value<double>()->default_value(ieompp::HalfPi<double>::value), "x component of the fermi momentum")
         ("ky", make_value<double>()->default_value(ieompp::HalfPi<double>::value), "y component of the fermi momentum")
+        ("matrix_free", make_value<bool>(false), "apply the Liouvillian on the fly instead of storing a sparse matrix")
+        ("sliced_ellpack", make_value<bool>(false), "store the Liouvillian in the vectorized SELL-C-sigma format")
+        ("value_dictionary", make_value<bool>(false), "store the Liouvillian as 8-bit codes into a table of its distinct values")
+        ("point_group_symmetry", make_value<bool>(false), "propagate only the sector of the basis that is symmetric under the point group of the lattice")
+        ("distance_cutoff", make_value<uint64_t>(), "keep only the three operator terms whose sites are at most this lattice distance apart")
+        ("active_set_tolerance", make_value<double>(), "only update the coefficients within four hops of a coefficient above this tolerance until half of the basis is active, requires the default matrix format")
+        ("adaptive_threshold", make_value<double>(), "start with the one operator terms and add the three operator terms whose coefficients grow faster than this threshold")
+        ("rk45_tolerance", make_value<double>(), "integrate with adaptive Dormand-Prince steps to this absolute tolerance, dt * measurement_interval is the time between measurements, requires the default matrix format")
+        ("rk45_relative_tolerance", make_value<double>(0.), "relative tolerance of the Dormand-Prince steps")
+        ("low_storage_rk", make_value<std::string>(), "propagate with a Runge-Kutta scheme that stores only one vector besides the state instead of RK4: ck4 (fourth order, five stages) or williamson3 (third order, three stages), requires the default matrix format")
         ;
     // clang-format on
 
@@ -43,35 +54,61 @@ int main(int argc, char** argv)
     const auto measurement_interval = app.variables["measurement_interval"].as<uint64_t>();
     const auto kx                   = app.variables["kx"].as<double>();
     const auto ky                   = app.variables["ky"].as<double>();
+    const auto matrix_free          = app.variables["matrix_free"].as<bool>();
+    const auto sliced_ellpack       = app.variables["sliced_ellpack"].as<bool>();
+    const auto value_dictionary     = app.variables["value_dictionary"].as<bool>();
+    const auto point_group_symmetry = app.variables["point_group_symmetry"].as<bool>();
+    const auto truncate             = app.variables.count("distance_cutoff") != 0u;
+    const auto active_set           = app.variables.count("active_set_tolerance") != 0u;
+    const auto adaptive             = app.variables.count("adaptive_threshold") != 0u;
+    const auto rk45                 = app.variables.count("rk45_tolerance") != 0u;
+    const auto low_storage          = app.variables.count("low_storage_rk") != 0u;
 
-    const auto lattice         = init_lattice(Nx, Ny);
-    const auto basis           = init_basis(lattice);
-    const auto conjugate_basis = basis.get_conjugate();
-    const auto ev              = init_expectation_value(lattice);
-    const auto L               = init_liouvillian(J, U);
-    const auto M               = compute_matrix(L, basis, lattice);
-    const auto jump            = hubbard::FermiJump2D<double, Basis>(
-        basis, lattice,
-        [&ev](const typename Basis::Monomial::Operator& a,
-              const typename Basis::Monomial::Operator& b) { return ev(a.index1, b.index1); },
-        typename decltype(lattice)::Vector{kx, ky});
-
-    auto h                     = init_vector(basis);
-    const auto integrator      = init_rk4(basis.size(), dt);
+    const auto lattice = init_lattice(Nx, Ny);
+    const auto ev      = init_expectation_value(lattice);
+    const auto L       = init_liouvillian(J, U);
 
     double obs, t, last_measurement = 0.;
 
-    get_loggers().main->info("Measuring at t=0");
-    obs = jump(h);
-    get_loggers().main->info(u8"  Δn_{{k_F,↑}}(0) = {}", obs);
-    app.output_file << 0 << '\t' << obs << '\n';
-    app.output_file.flush();
-    get_loggers().main->info("Finish measurement at t=0");
-    last_measurement = 0;
+    const auto run = [&](const auto& basis, auto& M, auto& integrator) {
+        using Basis = typename std::decay<decltype(basis)>::type;
 
-    get_loggers().main->info("h[0] = {}", h[0]);
+        const auto jump = hubbard::FermiJump2D<double, Basis>(
+            basis, lattice,
+            [&ev](const typename Basis::Monomial::Operator& a,
+                  const typename Basis::Monomial::Operator& b) { return ev(a.index1, b.index1); },
+            typename decltype(lattice)::Vector{kx, ky});
+
+        auto h = init_vector(basis);
+
+        get_loggers().main->info("Measuring at t=0");
+        obs = jump(h);
+        get_loggers().main->info(u8"  Δn_{{k_F,↑}}(0) = {}", obs);
+        app.output_file << 0 << '\t' << obs << '\n';
+        app.output_file.flush();
+        get_loggers().main->info("Finish measurement at t=0");
+        last_measurement = 0;
+
+        get_loggers().main->info("h[0] = {}", h[0]);
+
+        for(t = 0.; t < t_end;) {
+            if(has_time_interval_passed(t, last_measurement, dt, measurement_interval)) {
+                get_loggers().main->info("Measuring at t={}", t);
+                obs = jump(h);
+                get_loggers().main->info(u8"  Δn_{{k_F,↑}}({}) = {}", t, obs);
+                app.output_file << t << '\t' << obs << '\n';
+                app.output_file.flush();
+                get_loggers().main->info("Finish measurement at t={}", t);
+                last_measurement = t;
+            }
+
+            get_loggers().ode->info("Integrate from t={}", t);
+            integrator.step_imaginary(M, h);
+            get_loggers().ode->info("Finished integration t={} -> t={}", t,
+                                    t + integrator.step_size());
+            t += integrator.step_size();
+        }
 
-    for(t = 0.; t < t_end;) {
         if(has_time_interval_passed(t, last_measurement, dt, measurement_interval)) {
             get_loggers().main->info("Measuring at t={}", t);
             obs = jump(h);
@@ -81,21 +118,193 @@ int main(int argc, char** argv)
             get_loggers().main->info("Finish measurement at t={}", t);
             last_measurement = t;
         }
+    };
+
+    const auto propagate = [&](const auto& basis, const auto& M) {
+        auto integrator = init_rk4(M, basis.size(), dt);
+        run(basis, M, integrator);
+    };
+
+    // the active set, the Dormand-Prince and the low-storage stages are computed along the rows
+    // of the CompressedRowMatrix
+    const auto propagate_compressed = [&](const auto& basis, const auto& M) {
+        if(low_storage) {
+            auto integrator = init_low_storage_rk(
+                basis.size(), dt, app.variables["low_storage_rk"].as<std::string>());
+            run(basis, M, integrator);
+            return;
+        }
+        if(rk45) {
+            auto integrator =
+                init_dormand_prince(basis.size(), dt * measurement_interval,
+                                    app.variables["rk45_tolerance"].as<double>(),
+                                    app.variables["rk45_relative_tolerance"].as<double>());
+            run(basis, M, integrator);
+            get_loggers().ode->info("Finished with {} accepted and {} rejected steps",
+                                    integrator.accepted_steps(), integrator.rejected_steps());
+            return;
+        }
+        if(!active_set) {
+            propagate(basis, M);
+            return;
+        }
+        auto integrator = init_active_set_rk4(basis.size(), dt,
+                                              app.variables["active_set_tolerance"].as<double>());
+        run(basis, M, integrator);
+    };
 
-        get_loggers().ode->info("Integrate from t={}", t);
-        integrator.step(M, h);
-        get_loggers().ode->info("Finished integration t={} -> t={}", t, t + integrator.step_size());
-        t += integrator.step_size();
+    if(active_set && (matrix_free || sliced_ellpack || value_dictionary)) {
+        get_loggers().main->warn("Ignoring active_set_tolerance for this matrix format");
+    }
+    if(rk45 && (matrix_free || sliced_ellpack || value_dictionary)) {
+        get_loggers().main->warn("Ignoring rk45_tolerance for this matrix format");
+    }
+    if(low_storage && (matrix_free || sliced_ellpack || value_dictionary)) {
+        get_loggers().main->warn("Ignoring low_storage_rk for this matrix format");
     }
 
-    if(has_time_interval_passed(t, last_measurement, dt, measurement_interval)) {
-        get_loggers().main->info("Measuring at t={}", t);
-        obs = jump(h);
-        get_loggers().main->info(u8"  Δn_{{k_F,↑}}({}) = {}", t, obs);
-        app.output_file << t << '\t' << obs << '\n';
-        app.output_file.flush();
-        get_loggers().main->info("Finish measurement at t={}", t);
-        last_measurement = t;
+    // the symmetric sector and the truncated basis only support stored matrices
+    const auto run_stored = [&](const auto& basis) {
+        if(matrix_free) {
+            get_loggers().main->warn("Storing the Liouvillian as a matrix");
+        }
+
+        if(sliced_ellpack) {
+            propagate(basis, compute_sliced_ellpack_matrix(L, basis, lattice));
+        } else if(value_dictionary) {
+            propagate(basis, compute_value_dictionary_matrix(L, basis, lattice));
+        } else {
+            propagate_compressed(basis, compute_matrix(L, basis, lattice));
+        }
+    };
+
+    if(point_group_symmetry && truncate) {
+        THROW(ieompp::Exception,
+              "The distance cutoff cannot be combined with the point group symmetry");
+    }
+    if(adaptive && (point_group_symmetry || truncate || active_set || rk45 || low_storage)) {
+        THROW(ieompp::Exception,
+              "The adaptive basis cannot be combined with the point group symmetry, the distance "
+              "cutoff, the active set, the Dormand-Prince or the low-storage Runge-Kutta steps");
+    }
+    if(int(rk45) + int(active_set) + int(low_storage) > 1) {
+        THROW(ieompp::Exception,
+              "Only one of the Dormand-Prince steps, the active set and the low-storage "
+              "Runge-Kutta steps can be used");
+    }
+    if(app.dry_run) {
+        if(point_group_symmetry || truncate || adaptive) {
+            THROW(ieompp::Exception,
+                  "The matrix of the symmetric sector, the truncated or the adaptive basis cannot "
+                  "be predicted, its elements are only known after the assembly");
+        }
+
+        const auto basis     = init_basis(lattice);
+        const auto rows      = basis.size();
+        const auto non_zeros = predict_non_zeros(basis, lattice);
+        const auto steps     = number_of_steps(t_end, dt);
+
+        // at most 7x7 sites, about 10^5 basis elements
+        const auto calibration_lattice =
+            init_lattice(std::min<uint64_t>(Nx, 7), std::min<uint64_t>(Ny, 7));
+        const auto calibration_basis = init_basis(calibration_lattice);
+
+        DryRun plan;
+        plan.add("basis", sizeof(basis));
+        plan.add("Fermi jump", vector_bytes(basis.N));
+        if(matrix_free) {
+            const auto calibration_matrix =
+                compute_matrix_free(L, calibration_basis, calibration_lattice);
+            plan_rk4(plan, rows, plan_matrix_free(plan, basis, lattice), steps);
+            calibrate_rk4(plan, calibration_matrix,
+                          matrix_free_bytes(calibration_basis, calibration_lattice));
+        } else if(sliced_ellpack) {
+            // the compressed row matrix is freed after the conversion
+            const auto calibration_matrix =
+                compute_sliced_ellpack_matrix(L, calibration_basis, calibration_lattice);
+            plan_compressed_matrix(plan, rows, non_zeros, true);
+            plan_rk4(plan, rows,
+                     plan_sliced_ellpack_matrix(
+                         plan, rows,
+                         predict_sliced_ellpack_elements(basis, lattice, "lexicographic", 0)),
+                     steps);
+            calibrate_rk4(plan, calibration_matrix,
+                          sliced_ellpack_matrix_bytes<double>(
+                              calibration_matrix.rows(), calibration_matrix.stored_elements()));
+        } else if(value_dictionary) {
+            // the distinct values do not depend on the size of the lattice
+            const auto calibration_matrix =
+                compute_value_dictionary_matrix(L, calibration_basis, calibration_lattice);
+            const auto table_size = calibration_matrix.table().size();
+            plan_compressed_matrix(plan, rows, non_zeros, true);
+            plan_rk4(plan, rows,
+                     plan_value_dictionary_matrix(
+                         plan, rows, non_zeros, table_size,
+                         compressed_row_matrix_bytes<double>(rows, non_zeros)),
+                     steps);
+            calibrate_rk4(plan, calibration_matrix,
+                          value_dictionary_matrix_bytes<double>(
+                              calibration_matrix.rows(), calibration_matrix.non_zeros(),
+                              table_size));
+        } else {
+            const auto calibration_matrix =
+                compute_matrix(L, calibration_basis, calibration_lattice);
+            const auto matrix_bytes = plan_compressed_matrix(plan, rows, non_zeros);
+            if(low_storage) {
+                const auto tableau = low_storage_tableau<double>(
+                    app.variables["low_storage_rk"].as<std::string>());
+                plan_low_storage_rk(plan, rows, matrix_bytes, steps, tableau.stages());
+                calibrate_low_storage_rk(plan, calibration_matrix, tableau);
+            } else if(rk45) {
+                plan_dormand_prince(plan, rows, matrix_bytes,
+                                    number_of_steps(t_end, dt * measurement_interval),
+                                    calibration_matrix, dt * measurement_interval,
+                                    app.variables["rk45_tolerance"].as<double>(),
+                                    app.variables["rk45_relative_tolerance"].as<double>());
+            } else if(active_set) {
+                plan_active_set_rk4(plan, rows, matrix_bytes, steps);
+                calibrate_active_set_rk4(plan, calibration_matrix);
+            } else {
+                plan_fused_rk4(plan, rows, matrix_bytes, steps);
+                calibrate_rk4(plan, calibration_matrix);
+            }
+        }
+        plan.print(cout);
+        return 0;
+    }
+    if(adaptive) {
+        if(matrix_free || sliced_ellpack || value_dictionary) {
+            get_loggers().main->warn("Storing the Liouvillian in the growing row format");
+        }
+
+        // the integrator inserts new elements into the basis and appends their rows to M
+        auto basis      = init_adaptive_basis(lattice);
+        auto M          = compute_adaptive_matrix(L, basis, lattice);
+        auto integrator = init_adaptive_rk4(dt, app.variables["adaptive_threshold"].as<double>());
+        run(basis, M, integrator);
+        get_loggers().main->info("Finished with {} out of {} elements, error indicator {}",
+                                 basis.size(), basis.real_space_basis.size(),
+                                 integrator.error_indicator());
+        return 0;
+    }
+    if(point_group_symmetry) {
+        run_stored(init_symmetric_basis(lattice));
+        return 0;
+    }
+    if(truncate) {
+        run_stored(init_truncated_basis(lattice, app.variables["distance_cutoff"].as<uint64_t>()));
+        return 0;
+    }
+
+    const auto basis = init_basis(lattice);
+    if(matrix_free) {
+        propagate(basis, compute_matrix_free(L, basis, lattice));
+    } else if(sliced_ellpack) {
+        propagate(basis, compute_sliced_ellpack_matrix(L, basis, lattice));
+    } else if(value_dictionary) {
+        propagate(basis, compute_value_dictionary_matrix(L, basis, lattice));
+    } else {
+        propagate_compressed(basis, compute_matrix(L, basis, lattice));
     }
 
     return 0;
@@ -24,6 +24,7 @@ struct Application {
     std::string matrix_path;
     std::string checkpoint_prefix;
     std::ofstream output_file;
+    bool dry_run;
 
     Application(int argc, char** argv)
     {
@@ -40,6 +41,10 @@ struct Application {
             std::exit(1);
         }
 
+        // a dry run only reports the predicted memory usage and run time, it neither writes a log
+        // nor a response or output file
+        dry_run = (variables.count("dry_run") != 0u);
+
         output_path   = variables["out"].as<std::string>();
         response_path = boost::filesystem::change_extension(output_path, ".rsp").string();
         log_path      = boost::filesystem::change_extension(output_path, ".log").string();
@@ -48,7 +53,7 @@ struct Application {
         checkpoint_prefix =
             boost::filesystem::change_extension(output_path, "").string() + "_checkpoint_";
 
-        get_loggers().init(log_path);
+        get_loggers().init(dry_run ? "" : log_path);
 
         get_loggers().main->info("CLI options:");
         for(const auto& option : all_options) {
@@ -59,7 +64,7 @@ struct Application {
             // read simulation parameters from response file
             read_response_file(variables["response_file"].as<std::string>(), variables,
                                Application::options_description);
-        } else {
+        } else if(!dry_run) {
             // write a response file with simulation parameters
             get_loggers().io->info("Write response file \"{}\"", response_path);
             std::ofstream file(response_path.c_str());
@@ -70,6 +75,10 @@ struct Application {
             get_loggers().io->info("Close response file \"{}\"", response_path);
         }
 
+        if(dry_run) {
+            return;
+        }
+
         get_loggers().io->info("Opening output file \"{}\"", output_path);
         output_file.open(output_path.c_str());
         get_loggers().io->info("File \"{}\" is now open", output_path);
@@ -97,9 +106,11 @@ struct Application {
 
     ~Application()
     {
-        get_loggers().io->info("Closing output file \"{}\"", output_path);
-        output_file.close();
-        get_loggers().io->info("File \"{}\" closed", output_path);
+        if(!dry_run) {
+            get_loggers().io->info("Closing output file \"{}\"", output_path);
+            output_file.close();
+            get_loggers().io->info("File \"{}\" closed", output_path);
+        }
 
         get_loggers().main->info("Execution time: {}", timer);
     }
@@ -110,6 +121,7 @@ struct Application {
         options_description.add_options()
             ("help", "print this help message")
             ("version", "print version information")
+            ("dry_run", "print the predicted memory usage and run time instead of running the simulation")
             ("response_file", make_value<std::string>(), "file to read program parameters from")
             /* ("checkpoint_interval", make_value<std::uint64_t>(1000), "steps between checkpoints") */
             /* ("checkpoint", make_value<std::string>(), "checkpoint to use for resume") */
@@ -10,6 +10,7 @@
 
 #include <ieompp/algebra/monomial.hpp>
 #include <ieompp/algebra/operator.hpp>
+#include <ieompp/models/hubbard/conjugate_basis.hpp>
 #include <ieompp/ode/rk4.hpp>
 
 #include "application.hpp"
@@ -54,6 +55,15 @@ blaze::DynamicVector<std::complex<double>> read_vector_from_checkpoint(Applicati
 }
 
 
+// lazy view of the conjugate basis, the basis has to outlive it
+template <typename Basis>
+auto init_conjugate_basis(const Basis& basis)
+{
+    get_loggers().main->info("Set up conjugate basis view");
+    return ieompp::models::hubbard::make_conjugate_basis(basis);
+}
+
+
 template <typename Float>
 bool has_time_interval_passed(const Float& t, const Float& last, const Float& dt, uint64_t interval)
 {
@@ -0,0 +1,393 @@
+#ifndef SRC_HUBBARD_DRY_RUN_HPP_
+#define SRC_HUBBARD_DRY_RUN_HPP_
+
+#include <algorithm>
+#include <chrono>
+#include <complex>
+#include <cstdint>
+#include <functional>
+#include <iomanip>
+#include <ostream>
+#include <string>
+#include <vector>
+
+// Memory and run time plan of a driver started with --dry_run. The drivers add the byte counts of
+// the structures they would allocate, computed from the basis dimension and the predicted number
+// of matrix elements without allocating any of them. The run time is projected from the bytes the
+// propagation moves per step and the bandwidth of a short calibration run on a small problem.
+class DryRun
+{
+private:
+    struct Structure {
+        std::string name;
+        uint64_t bytes;
+        bool temporary;
+    };
+
+    std::vector<Structure> _structures;
+    uint64_t _step_bytes = 0;
+    uint64_t _steps      = 0;
+    std::string _step    = "step";
+    double _bandwidth    = 0.;
+
+public:
+    // structure that lives until the end of the propagation
+    void add(const std::string& name, uint64_t bytes)
+    {
+        _structures.push_back(Structure{name, bytes, false});
+    }
+
+    // structure that is freed before the propagation starts, e.g. during the matrix assembly
+    void add_temporary(const std::string& name, uint64_t bytes)
+    {
+        _structures.push_back(Structure{name, bytes, true});
+    }
+
+    // bytes read and written by one step of the propagation and the number of steps, step names
+    // the unit of the propagation in the output, e.g. the measurement intervals of a propagator
+    // with adaptive substeps
+    void set_propagation(uint64_t step_bytes, uint64_t steps, const std::string& step = "step")
+    {
+        _step_bytes = step_bytes;
+        _steps      = steps;
+        _step       = step;
+    }
+
+    // time steps calls of step() which move step_bytes bytes each
+    template <typename StepFunction>
+    void calibrate(uint64_t step_bytes, const StepFunction& step, uint64_t steps = 10)
+    {
+        // the first step touches the stage vectors for the first time
+        step();
+
+        const auto start = std::chrono::steady_clock::now();
+        for(uint64_t i = 0; i < steps; ++i) {
+            step();
+        }
+        const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        _bandwidth = double(step_bytes) * steps / std::max(elapsed.count(), 1e-9);
+    }
+
+    // as calibrate for steps that move a varying number of bytes, moved_bytes() returns the bytes
+    // moved by all calls of step() so far, returns the number of calls of step()
+    template <typename StepFunction, typename MovedBytes>
+    uint64_t calibrate_adaptive(const StepFunction& step, const MovedBytes& moved_bytes,
+                                uint64_t steps = 10)
+    {
+        step();
+
+        const auto before = moved_bytes();
+        const auto start  = std::chrono::steady_clock::now();
+        for(uint64_t i = 0; i < steps; ++i) {
+            step();
+        }
+        const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        _bandwidth = double(moved_bytes() - before) / std::max(elapsed.count(), 1e-9);
+        return steps + 1;
+    }
+
+    uint64_t persistent_bytes() const
+    {
+        uint64_t bytes = 0;
+        for(const auto& structure : _structures) {
+            if(!structure.temporary) {
+                bytes += structure.bytes;
+            }
+        }
+        return bytes;
+    }
+
+    // the temporaries are not alive at the same time
+    uint64_t peak_bytes() const
+    {
+        uint64_t temporary = 0;
+        for(const auto& structure : _structures) {
+            if(structure.temporary) {
+                temporary = std::max(temporary, structure.bytes);
+            }
+        }
+        return persistent_bytes() + temporary;
+    }
+
+    double projected_seconds() const
+    {
+        return (_bandwidth > 0.) ? double(_step_bytes) * _steps / _bandwidth : 0.;
+    }
+
+    void print(std::ostream& strm) const
+    {
+        strm << "# structure\tbytes\n";
+        for(const auto& structure : _structures) {
+            strm << structure.name << (structure.temporary ? " (temporary)" : "") << '\t'
+                 << structure.bytes << '\n';
+        }
+        strm << "total\t" << persistent_bytes() << '\n';
+        strm << "peak\t" << peak_bytes() << '\n';
+        strm << "bytes per " << _step << '\t' << _step_bytes << '\n';
+        strm << _step << "s\t" << _steps << '\n';
+        strm << "calibrated bandwidth\t" << std::setprecision(4) << _bandwidth / 1e9 << " GB/s\n";
+        strm << "projected time\t" << projected_seconds() << "s\n";
+    }
+};
+
+// number of iterations of the propagation loops for(t = 0; t < t_end; t += dt) of the drivers
+uint64_t number_of_steps(double t_end, double dt)
+{
+    uint64_t steps = 0;
+    for(double t = 0.; t < t_end; t += dt) {
+        ++steps;
+    }
+    return steps;
+}
+
+template <typename Scalar = std::complex<double>>
+uint64_t vector_bytes(uint64_t size)
+{
+    return size * sizeof(Scalar);
+}
+
+// ieompp::types::CompressedRowMatrix
+template <typename Scalar, typename Index = std::uint32_t, typename Offset = std::size_t>
+uint64_t compressed_row_matrix_bytes(uint64_t rows, uint64_t non_zeros)
+{
+    return (rows + 1) * sizeof(Offset) + non_zeros * (sizeof(Index) + sizeof(Scalar));
+}
+
+// ieompp::types::CompressedRows produced by the parallel matrix assembly
+template <typename Scalar, typename Index = std::uint32_t>
+uint64_t compressed_rows_bytes(uint64_t rows, uint64_t non_zeros)
+{
+    return (rows + 1) * sizeof(std::size_t) + non_zeros * (sizeof(Index) + sizeof(Scalar));
+}
+
+// blaze::CompressedMatrix, one pointer per row and elements of a value and a std::size_t index
+template <typename Scalar>
+uint64_t blaze_compressed_matrix_bytes(uint64_t rows, uint64_t non_zeros)
+{
+    return (rows + 1) * sizeof(void*) + non_zeros * (sizeof(Scalar) + sizeof(std::size_t));
+}
+
+// ieompp::types::SlicedEllpackMatrix with stored_elements elements including the padding
+template <typename Scalar, typename Index = std::uint32_t, std::size_t C = 8>
+uint64_t sliced_ellpack_matrix_bytes(uint64_t rows, uint64_t stored_elements)
+{
+    const auto chunks = (rows + C - 1) / C;
+    return chunks * C * sizeof(Index) + (2 * chunks + 1) * sizeof(std::size_t)
+           + stored_elements * (sizeof(Index) + sizeof(Scalar));
+}
+
+// Counts the elements a SlicedEllpackMatrix stores for the rows whose lengths are added in the
+// order of the matrix. As in its constructor the rows are sorted by their length within windows
+// of sigma rows and each chunk of C rows is padded to its longest row.
+template <std::size_t C = 8>
+class SlicedEllpackElements
+{
+private:
+    const uint64_t _sigma;
+    uint64_t _rows = 0, _stored = 0, _length = 0;
+    std::vector<uint64_t> _window;
+
+    void flush()
+    {
+        std::sort(_window.begin(), _window.end(), std::greater<uint64_t>());
+        for(uint64_t i = 0; i < _window.size(); ++i) {
+            if((_rows + i) % C == 0) {
+                _stored += _length * C;
+                _length = 0;
+            }
+            _length = std::max(_length, _window[i]);
+        }
+        _rows += _window.size();
+        _window.clear();
+    }
+
+public:
+    explicit SlicedEllpackElements(uint64_t sigma = 32 * C) : _sigma(sigma) {}
+
+    void add(uint64_t row_length)
+    {
+        _window.push_back(row_length);
+        if(_window.size() == _sigma) {
+            flush();
+        }
+    }
+
+    uint64_t stored_elements()
+    {
+        flush();
+        return _stored + _length * C;
+    }
+};
+
+// ieompp::types::ValueDictionaryMatrix with a table of table_size distinct values
+template <typename Scalar, typename Code = std::uint8_t, typename Index = std::uint32_t,
+          typename Offset = std::size_t>
+uint64_t value_dictionary_matrix_bytes(uint64_t rows, uint64_t non_zeros, uint64_t table_size)
+{
+    return (rows + 1) * sizeof(Offset) + non_zeros * (sizeof(Index) + sizeof(Code))
+           + table_size * sizeof(Scalar);
+}
+
+// Bytes moved by one step of ieompp::ode::RK4 with a matrix of matrix_bytes: each of the four
+// products reads the matrix and one vector and writes one vector, the arguments u + c k of the
+// last three products are evaluated into a temporary (two reads, one write) and the final update
+// reads five vectors and writes one.
+template <typename Scalar = std::complex<double>>
+uint64_t rk4_step_bytes(uint64_t matrix_bytes, uint64_t size)
+{
+    return 4 * matrix_bytes + (4 * 2 + 3 * 3 + 6) * vector_bytes<Scalar>(size);
+}
+
+// state vector, the four static stage vectors and the temporary of the stage arguments of RK4
+template <typename Scalar = std::complex<double>>
+void add_rk4_vectors(DryRun& plan, uint64_t size)
+{
+    plan.add("state vector", vector_bytes<Scalar>(size));
+    plan.add("RK4 stages", 4 * vector_bytes<Scalar>(size));
+    plan.add("RK4 stage argument", vector_bytes<Scalar>(size));
+}
+
+// Bytes moved by one step of ieompp::ode::FusedRK4 with a compressed row matrix of matrix_bytes:
+// the first stage reads u and writes k_1, the second and third read the previous stage and k_1,
+// write their stage and update u, which the last stage only updates.
+template <typename Scalar = std::complex<double>>
+uint64_t fused_rk4_step_bytes(uint64_t matrix_bytes, uint64_t size)
+{
+    return 4 * matrix_bytes + (2 + 2 * 5 + 4) * vector_bytes<Scalar>(size);
+}
+
+// state vector and the workspace of FusedRK4
+template <typename Scalar = std::complex<double>>
+void add_fused_rk4_vectors(DryRun& plan, uint64_t size)
+{
+    plan.add("state vector", vector_bytes<Scalar>(size));
+    plan.add("RK4 workspace", 3 * vector_bytes<Scalar>(size));
+}
+
+// Bytes moved by one step of ieompp::ode::LowStorageRK with the given number of stages: the
+// product of each stage reads u and updates the register, which the first stage only writes, and
+// the update of u reads the register.
+template <typename Scalar = std::complex<double>>
+uint64_t low_storage_rk_step_bytes(uint64_t matrix_bytes, uint64_t size, uint64_t stages)
+{
+    return stages * (matrix_bytes + 6 * vector_bytes<Scalar>(size)) - vector_bytes<Scalar>(size);
+}
+
+// state vector and the register of LowStorageRK
+template <typename Scalar = std::complex<double>>
+void add_low_storage_rk_vectors(DryRun& plan, uint64_t size)
+{
+    plan.add("state vector", vector_bytes<Scalar>(size));
+    plan.add("Runge-Kutta register", vector_bytes<Scalar>(size));
+}
+
+// Bytes moved by one step of ieompp::ode::MatrixPowersRK4 with an ieompp::types::MatrixPowers of
+// matrix_bytes: the matrix is read once as long as the blocks reused by the four products stay in
+// the cache, each product reads one vector and writes one and the update reads the four powers and
+// u and writes u.
+template <typename Scalar = std::complex<double>>
+uint64_t matrix_powers_step_bytes(uint64_t matrix_bytes, uint64_t size)
+{
+    return matrix_bytes + (4 * 2 + 6) * vector_bytes<Scalar>(size);
+}
+
+// state vector and the four powers of ieompp::ode::MatrixPowersRK4
+template <typename Scalar = std::complex<double>>
+void add_matrix_powers_vectors(DryRun& plan, uint64_t size)
+{
+    plan.add("state vector", vector_bytes<Scalar>(size));
+    plan.add("matrix powers", 4 * vector_bytes<Scalar>(size));
+}
+
+// Bytes moved by ieompp::ode::Krylov with a Hermitian matrix of matrix_bytes in the given number
+// of products and substeps: each product reads a basis vector and writes the next one, which is
+// orthogonalized against the two previous basis vectors by a dot product and an update each (the
+// first vector only against one), normalized and scaled. A substep normalizes u into the first
+// basis vector and combines krylov_dimension basis vectors into u.
+template <typename Scalar = std::complex<double>>
+uint64_t krylov_bytes(uint64_t matrix_bytes, uint64_t size, uint64_t krylov_dimension,
+                      double products, double substeps)
+{
+    return products * (matrix_bytes + (2 + 2 * 5 + 1 + 2) * vector_bytes<Scalar>(size))
+           + substeps * (3 + krylov_dimension + 1 - 5) * vector_bytes<Scalar>(size);
+}
+
+// state vector, the krylov_dimension + 1 basis vectors of Krylov and its Hessenberg matrix and the
+// four dense matrices of the exponential
+template <typename Scalar = std::complex<double>>
+void add_krylov_vectors(DryRun& plan, uint64_t size, uint64_t krylov_dimension)
+{
+    plan.add("state vector", vector_bytes<Scalar>(size));
+    plan.add("Krylov basis", (krylov_dimension + 1) * vector_bytes<Scalar>(size));
+    plan.add("Krylov projection", ((krylov_dimension + 1) * krylov_dimension
+                                   + 4 * (krylov_dimension + 1) * (krylov_dimension + 1))
+                                      * sizeof(Scalar));
+}
+
+// Bytes moved by ieompp::ode::Chebyshev with a matrix of matrix_bytes in the given number of
+// products and steps: each product of the recurrence reads the current and the previous vector,
+// overwrites the previous one and adds it to the states of the steps_per_expansion intervals, each
+// step copies one of the states into u.
+template <typename Scalar = std::complex<double>>
+uint64_t chebyshev_bytes(uint64_t matrix_bytes, uint64_t size, uint64_t steps_per_expansion,
+                         double products, double steps)
+{
+    return products * (matrix_bytes + (3 + 2 * steps_per_expansion) * vector_bytes<Scalar>(size))
+           + steps * 2 * vector_bytes<Scalar>(size);
+}
+
+// state vector, the two vectors of the Chebyshev recurrence and the states of the
+// steps_per_expansion intervals
+template <typename Scalar = std::complex<double>>
+void add_chebyshev_vectors(DryRun& plan, uint64_t size, uint64_t steps_per_expansion)
+{
+    plan.add("state vector", vector_bytes<Scalar>(size));
+    plan.add("Chebyshev recurrence", 2 * vector_bytes<Scalar>(size));
+    plan.add("Chebyshev states", steps_per_expansion * vector_bytes<Scalar>(size));
+}
+
+// Bytes moved by ieompp::ode::DormandPrince with a matrix of matrix_bytes in the given number of
+// attempted and accepted steps: an attempt forms the arguments of six stages from u and the
+// previous stages (33 reads and writes), multiplies them (a read and a write each) and evaluates
+// the error from u, the solution and the seven stages, an accepted step copies the solution into
+// u.
+template <typename Scalar = std::complex<double>>
+uint64_t dormand_prince_bytes(uint64_t matrix_bytes, uint64_t size, double attempts,
+                              double accepted)
+{
+    return attempts * (6 * matrix_bytes + (33 + 6 * 2 + 9) * vector_bytes<Scalar>(size))
+           + accepted * 2 * vector_bytes<Scalar>(size);
+}
+
+// state vector, the seven stages and the solution of DormandPrince
+template <typename Scalar = std::complex<double>>
+void add_dormand_prince_vectors(DryRun& plan, uint64_t size)
+{
+    plan.add("state vector", vector_bytes<Scalar>(size));
+    plan.add("Dormand-Prince stages", 7 * vector_bytes<Scalar>(size));
+    plan.add("Dormand-Prince solution", vector_bytes<Scalar>(size));
+}
+
+// Bytes moved by one step of ieompp::ode::ActiveSetRK4 once the active set covers the whole basis,
+// which bounds the steps on a smaller active set: each stage reads the matrix and a vector, writes
+// the stage, updates the weighted sum and writes the next argument from u, the update of u reads
+// the sum.
+template <typename Scalar = std::complex<double>>
+uint64_t active_set_rk4_step_bytes(uint64_t matrix_bytes, uint64_t size)
+{
+    return 4 * (matrix_bytes + 7 * vector_bytes<Scalar>(size)) + 3 * vector_bytes<Scalar>(size);
+}
+
+// State vector and the three vectors of ActiveSetRK4 and its per row state. The indices of the
+// active rows and the two levels of the neighborhood search are bounded by one index per row,
+// they are freed once the active set covers half of the basis.
+template <typename Scalar = std::complex<double>>
+void add_active_set_rk4_vectors(DryRun& plan, uint64_t size)
+{
+    plan.add("state vector", vector_bytes<Scalar>(size));
+    plan.add("RK4 stages", 3 * vector_bytes<Scalar>(size));
+    plan.add("active set", size * (sizeof(std::uint8_t) + sizeof(std::uint32_t)));
+    plan.add_temporary("active rows (bound)", 3 * size * sizeof(std::size_t));
+}
+
+#endif
@@ -13,10 +13,13 @@ struct Loggers {
     std::vector<spdlog::sink_ptr> sinks;
     std::shared_ptr<spdlog::logger> main, io, ode;
 
+    // without a log_path only stderr is used
     void init(const std::string& log_path)
     {
         sinks.push_back(std::make_shared<spdlog::sinks::stderr_sink_mt>());
-        sinks.push_back(std::make_shared<spdlog::sinks::simple_file_sink_mt>(log_path, true));
+        if(!log_path.empty()) {
+            sinks.push_back(std::make_shared<spdlog::sinks::simple_file_sink_mt>(log_path, true));
+        }
         main = std::make_shared<spdlog::logger>("main", sinks.begin(), sinks.end());
         io   = std::make_shared<spdlog::logger>("io", sinks.begin(), sinks.end());
         ode  = std::make_shared<spdlog::logger>("ode", sinks.begin(), sinks.end());
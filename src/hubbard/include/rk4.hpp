@@ -3,8 +3,20 @@
 
 #include "../include/logging.hpp"
 
+#include <ieompp/exception.hpp>
+
+#include <ieompp/ode/active_set_rk4.hpp>
+#include <ieompp/ode/adaptive_rk4.hpp>
+#include <ieompp/ode/chebyshev.hpp>
+#include <ieompp/ode/dormand_prince.hpp>
+#include <ieompp/ode/fused_rk4.hpp>
+#include <ieompp/ode/krylov.hpp>
+#include <ieompp/ode/low_storage_rk.hpp>
+#include <ieompp/ode/matrix_powers_rk4.hpp>
 #include <ieompp/ode/rk4.hpp>
 
+#include <string>
+
 template <typename Float>
 ieompp::ode::RK4<Float> init_rk4(uint64_t basis_size, const Float& dt)
 {
@@ -14,4 +26,131 @@ ieompp::ode::RK4<Float> init_rk4(uint64_t basis_size, const Float& dt)
     return rk4;
 }
 
+template <typename Float>
+ieompp::ode::FusedRK4<Float> init_fused_rk4(uint64_t basis_size, const Float& dt)
+{
+    get_loggers().ode->info("Init fused RK4 integrator");
+    ieompp::ode::FusedRK4<Float> rk4(basis_size, dt);
+    get_loggers().ode->info("Finished RK4 initializing integrator");
+    return rk4;
+}
+
+template <typename Float>
+ieompp::ode::MatrixPowersRK4<Float> init_matrix_powers_rk4(uint64_t basis_size, const Float& dt)
+{
+    get_loggers().ode->info("Init matrix-powers RK4 integrator");
+    ieompp::ode::MatrixPowersRK4<Float> rk4(basis_size, dt);
+    get_loggers().ode->info("Finished RK4 initializing integrator");
+    return rk4;
+}
+
+// integrator for the matrix M, compressed row matrices are propagated by the fused RK4 and the
+// matrix-powers kernel by its own RK4
+template <typename Matrix, typename Float>
+ieompp::ode::RK4<Float> init_rk4(const Matrix& M, uint64_t basis_size, const Float& dt)
+{
+    static_cast<void>(M);
+    return init_rk4(basis_size, dt);
+}
+
+template <typename Scalar, typename Index, typename Offset, typename Float>
+ieompp::ode::FusedRK4<Float>
+init_rk4(const ieompp::types::CompressedRowMatrix<Scalar, Index, Offset>& M, uint64_t basis_size,
+         const Float& dt)
+{
+    static_cast<void>(M);
+    return init_fused_rk4(basis_size, dt);
+}
+
+template <typename Scalar, typename Index, typename Offset, typename Float>
+ieompp::ode::MatrixPowersRK4<Float>
+init_rk4(const ieompp::types::MatrixPowers<Scalar, Index, Offset>& M, uint64_t basis_size,
+         const Float& dt)
+{
+    static_cast<void>(M);
+    return init_matrix_powers_rk4(basis_size, dt);
+}
+
+template <typename Float>
+ieompp::ode::ActiveSetRK4<Float> init_active_set_rk4(uint64_t basis_size, const Float& dt,
+                                                     const Float& tolerance)
+{
+    get_loggers().ode->info("Init RK4 integrator on the active set with tolerance {}", tolerance);
+    ieompp::ode::ActiveSetRK4<Float> rk4(basis_size, dt, tolerance);
+    get_loggers().ode->info("Finished RK4 initializing integrator");
+    return rk4;
+}
+
+// each call of step_imaginary integrates over interval with adaptive steps
+template <typename Float>
+ieompp::ode::DormandPrince<Float> init_dormand_prince(uint64_t basis_size, const Float& interval,
+                                                      const Float& absolute_tolerance,
+                                                      const Float& relative_tolerance)
+{
+    get_loggers().ode->info("Init Dormand-Prince integrator with tolerances {} (absolute) and {} "
+                            "(relative)",
+                            absolute_tolerance, relative_tolerance);
+    ieompp::ode::DormandPrince<Float> integrator(basis_size, interval, absolute_tolerance,
+                                                 relative_tolerance);
+    get_loggers().ode->info("Finished initializing Dormand-Prince integrator");
+    return integrator;
+}
+
+// each call of step_imaginary propagates over interval in substeps of Krylov spaces
+template <typename Float>
+ieompp::ode::Krylov<Float> init_krylov(uint64_t basis_size, const Float& interval,
+                                       uint64_t krylov_dimension, const Float& tolerance)
+{
+    get_loggers().ode->info("Init Krylov propagator of dimension {} with tolerance {}",
+                            krylov_dimension, tolerance);
+    ieompp::ode::Krylov<Float> integrator(basis_size, interval, krylov_dimension, tolerance);
+    get_loggers().ode->info("Finished initializing Krylov propagator");
+    return integrator;
+}
+
+// each expansion yields the states after the next steps_per_expansion intervals
+template <typename Float>
+ieompp::ode::Chebyshev<Float> init_chebyshev(uint64_t basis_size, const Float& interval,
+                                             const Float& tolerance, uint64_t steps_per_expansion)
+{
+    get_loggers().ode->info("Init Chebyshev propagator over {} intervals with tolerance {}",
+                            steps_per_expansion, tolerance);
+    ieompp::ode::Chebyshev<Float> integrator(basis_size, interval, tolerance, steps_per_expansion);
+    get_loggers().ode->info("Finished initializing Chebyshev propagator");
+    return integrator;
+}
+
+// scheme is ck4 (Carpenter-Kennedy, fourth order) or williamson3 (third order)
+template <typename Float>
+ieompp::ode::LowStorageTableau<Float> low_storage_tableau(const std::string& scheme)
+{
+    using Tableau = ieompp::ode::LowStorageTableau<Float>;
+    if(scheme == "ck4") {
+        return Tableau::carpenter_kennedy_4();
+    }
+    if(scheme == "williamson3") {
+        return Tableau::williamson_3();
+    }
+    THROW(ieompp::Exception, "Unknown low-storage Runge-Kutta scheme \"" + scheme + "\"");
+}
+
+template <typename Float>
+ieompp::ode::LowStorageRK<Float> init_low_storage_rk(uint64_t basis_size, const Float& dt,
+                                                     const std::string& scheme)
+{
+    get_loggers().ode->info("Init low-storage Runge-Kutta integrator {}", scheme);
+    ieompp::ode::LowStorageRK<Float> integrator(basis_size, dt, low_storage_tableau<Float>(scheme));
+    get_loggers().ode->info("Finished initializing low-storage Runge-Kutta integrator");
+    return integrator;
+}
+
+template <typename Float>
+ieompp::ode::AdaptiveRK4<Float> init_adaptive_rk4(const Float& dt, const Float& threshold)
+{
+    get_loggers().ode->info("Init RK4 integrator growing the basis above a flux of {}", threshold);
+    ieompp::ode::AdaptiveRK4<Float> rk4(dt, threshold);
+    get_loggers().ode->info("Finished RK4 initializing integrator");
+    return rk4;
+}
+
 #endif
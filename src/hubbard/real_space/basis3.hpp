@@ -5,11 +5,20 @@
 
 #include <ieompp/algebra/monomial.hpp>
 #include <ieompp/algebra/operator.hpp>
+#include <ieompp/models/hubbard_real_space/adaptive_basis.hpp>
 #include <ieompp/models/hubbard_real_space/basis.hpp>
+#include <ieompp/models/hubbard_real_space/implicit_basis.hpp>
+#include <ieompp/models/hubbard_real_space/symmetric_basis.hpp>
+#include <ieompp/models/hubbard_real_space/translation_basis.hpp>
+#include <ieompp/models/hubbard_real_space/truncated_basis.hpp>
 
-using Operator = ieompp::algebra::Operator<uint64_t, bool>;
-using Monomial = ieompp::algebra::Monomial<Operator>;
-using Basis    = ieompp::models::hubbard_real_space::Basis3Operator<Monomial>;
+using Operator         = ieompp::algebra::Operator<uint64_t, bool>;
+using Monomial         = ieompp::algebra::Monomial<Operator>;
+using Basis            = ieompp::models::hubbard_real_space::ImplicitBasis3Operator<Operator>;
+using TranslationBasis = ieompp::models::hubbard_real_space::TranslationBasis3Operator<Operator>;
+using SymmetricBasis   = ieompp::models::hubbard_real_space::SymmetricBasis3Operator<Operator>;
+using TruncatedBasis   = ieompp::models::hubbard_real_space::TruncatedBasis3Operator<Operator>;
+using AdaptiveBasis    = ieompp::models::hubbard_real_space::AdaptiveBasis3Operator<Operator>;
 
 template <typename Lattice>
 auto init_basis(const Lattice& lattice)
@@ -20,4 +29,45 @@ auto init_basis(const Lattice& lattice)
     return basis;
 }
 
+template <typename Lattice, typename Float>
+auto init_translation_basis(const Lattice& lattice, const Float& momentum)
+{
+    get_loggers().main->info("Set up basis of momentum sector q={}", momentum);
+    auto basis = TranslationBasis(
+        ieompp::models::hubbard_real_space::translation_momentum_index(lattice, momentum),
+        lattice);
+    get_loggers().main->info("Finished setting up basis with {} elements", basis.size());
+    return basis;
+}
+
+template <typename Lattice>
+auto init_symmetric_basis(const Lattice& lattice)
+{
+    get_loggers().main->info("Set up basis of the point group symmetric sector");
+    auto basis = SymmetricBasis(lattice);
+    get_loggers().main->info("Finished setting up basis with {} elements ({} symmetry operations)",
+                             basis.size(), basis.group().size());
+    return basis;
+}
+
+template <typename Lattice>
+auto init_truncated_basis(const Lattice& lattice, uint64_t distance_cutoff)
+{
+    get_loggers().main->info("Set up basis truncated at lattice distance {}", distance_cutoff);
+    auto basis = TruncatedBasis(lattice, distance_cutoff);
+    get_loggers().main->info("Finished setting up basis with {} out of {} elements", basis.size(),
+                             basis.real_space_basis.size());
+    return basis;
+}
+
+template <typename Lattice>
+auto init_adaptive_basis(const Lattice& lattice)
+{
+    get_loggers().main->info("Set up adaptive basis");
+    auto basis = AdaptiveBasis(lattice);
+    get_loggers().main->info("Finished setting up basis with {} out of {} elements", basis.size(),
+                             basis.real_space_basis.size());
+    return basis;
+}
+
 #endif
@@ -0,0 +1,407 @@
+#ifndef REAL_SPACE_DRY_RUN_HPP_
+#define REAL_SPACE_DRY_RUN_HPP_
+
+#include "../include/dry_run.hpp"
+#include "../include/logging.hpp"
+
+#include <ieompp/exception.hpp>
+
+#include <ieompp/models/hubbard_real_space/basis_ordering.hpp>
+#include <ieompp/models/hubbard_real_space/blaze_sparse.hpp>
+#include <ieompp/models/hubbard_real_space/symbolic_matrix_no.hpp>
+#include <ieompp/ode/active_set_rk4.hpp>
+#include <ieompp/ode/chebyshev.hpp>
+#include <ieompp/ode/dormand_prince.hpp>
+#include <ieompp/ode/fused_rk4.hpp>
+#include <ieompp/ode/krylov.hpp>
+#include <ieompp/ode/low_storage_rk.hpp>
+#include <ieompp/ode/matrix_powers_rk4.hpp>
+#include <ieompp/ode/rk4.hpp>
+#include <ieompp/types/blaze.hpp>
+
+#include <complex>
+#include <cstdint>
+#include <string>
+
+// number of elements of the compressed row matrix compute_matrix would assemble for basis
+template <typename Basis, typename Lattice>
+uint64_t predict_non_zeros(const Basis& basis, const Lattice& lattice)
+{
+    static_cast<void>(lattice);
+    return ieompp::models::hubbard_real_space::number_of_kinetic_elements<Basis, Lattice>(basis)
+           + ieompp::models::hubbard_real_space::number_of_interaction_elements(basis);
+}
+
+// number of elements of the compressed row matrix compute_kinetic_matrix would assemble
+template <typename Monomial, typename Lattice>
+uint64_t predict_kinetic_non_zeros(
+    const ieompp::models::hubbard_real_space::Basis1Operator<Monomial>& basis,
+    const Lattice& lattice)
+{
+    static_cast<void>(lattice);
+    return ieompp::models::hubbard_real_space::number_of_kinetic_elements<Monomial, Lattice>(
+        basis);
+}
+
+// number of elements of row of the compressed row matrix compute_matrix would assemble for the
+// three operator basis, see predict_non_zeros
+template <typename Lattice, typename Basis>
+uint64_t predict_row_length(const Basis& basis, uint64_t row)
+{
+    const uint64_t z = Lattice::coordination_number;
+    if(row < basis.N) {
+        return z + 2;
+    }
+    const auto monomial = basis[row];
+    const bool local    = (monomial[0].index1 == monomial[1].index1)
+                       && (monomial[0].index1 == monomial[2].index1);
+    return 3 * z + (local ? 2 : 1);
+}
+
+// number of elements compute_sliced_ellpack_matrix would store for the matrix of basis in the
+// given ordering, the reverse Cuthill-McKee ordering is only known from the assembled matrix
+template <typename Basis, typename Lattice>
+uint64_t predict_sliced_ellpack_elements(const Basis& basis, const Lattice& lattice,
+                                         const std::string& ordering, uint64_t block_size)
+{
+    static_cast<void>(lattice);
+    SlicedEllpackElements<> elements;
+    const auto add = [&](uint64_t row) {
+        elements.add(predict_row_length<Lattice>(basis, row));
+    };
+    if(ordering == "lexicographic") {
+        for(uint64_t row = 0; row < basis.size(); ++row) {
+            add(row);
+        }
+    } else if(ordering == "blocked") {
+        ieompp::models::hubbard_real_space::for_each_blocked_index(basis, block_size, add);
+    } else {
+        THROW(ieompp::Exception, "The padding of the SELL-C-sigma format cannot be predicted for "
+                                 "the " + ordering + " ordering");
+    }
+    return elements.stored_elements();
+}
+
+// The plan_*_matrix functions add the structures of a matrix format and return the bytes of the
+// matrix read by one product.
+
+// compressed row matrix of rows x rows with non_zeros elements assembled by
+// init_matrix_parallel, which takes over the assembled arrays, the matrix is freed after its
+// conversion into another format if temporary
+uint64_t plan_compressed_matrix(DryRun& plan, uint64_t rows, uint64_t non_zeros,
+                                bool temporary = false)
+{
+    const auto matrix_bytes = compressed_row_matrix_bytes<double>(rows, non_zeros);
+    if(temporary) {
+        plan.add_temporary("matrix conversion", matrix_bytes);
+    } else {
+        plan.add("matrix", matrix_bytes);
+    }
+    return matrix_bytes;
+}
+
+// SELL-C-sigma matrix converted from the compressed row matrix
+uint64_t plan_sliced_ellpack_matrix(DryRun& plan, uint64_t rows, uint64_t stored_elements)
+{
+    const auto matrix_bytes = sliced_ellpack_matrix_bytes<double>(rows, stored_elements);
+    plan.add("SELL-C-sigma matrix", matrix_bytes);
+    return matrix_bytes;
+}
+
+// value dictionary matrix converted from the compressed row matrix, whose values are copied to
+// find the table_size distinct ones, conversion_bytes are the temporaries of plan_compressed_matrix
+// that are alive during the conversion
+uint64_t plan_value_dictionary_matrix(DryRun& plan, uint64_t rows, uint64_t non_zeros,
+                                      uint64_t table_size, uint64_t conversion_bytes = 0)
+{
+    const auto matrix_bytes = value_dictionary_matrix_bytes<double>(rows, non_zeros, table_size);
+    plan.add("value dictionary matrix", matrix_bytes);
+    plan.add_temporary("value table", conversion_bytes + non_zeros * sizeof(double));
+    return matrix_bytes;
+}
+
+// neighbor table of compute_matrix_free
+template <typename Basis, typename Lattice>
+uint64_t matrix_free_bytes(const Basis& basis, const Lattice& lattice)
+{
+    static_cast<void>(lattice);
+    return basis.N * Lattice::coordination_number * sizeof(typename Basis::BasisIndex);
+}
+
+template <typename Basis, typename Lattice>
+uint64_t plan_matrix_free(DryRun& plan, const Basis& basis, const Lattice& lattice)
+{
+    const auto matrix_bytes = matrix_free_bytes(basis, lattice);
+    plan.add("matrix-free Liouvillian", matrix_bytes);
+    return matrix_bytes;
+}
+
+// permutation of compute_basis_ordering, which is computed from an ordering of the given index
+// type and kept while the compressed row matrix and the state vector are reordered, and the
+// positions of the permuted coefficients in the observable
+template <typename OrderingIndex>
+void plan_basis_ordering(DryRun& plan, uint64_t rows, uint64_t non_zeros)
+{
+    const auto permutation_bytes = 2 * rows * sizeof(uint64_t);
+    plan.add_temporary("basis ordering", permutation_bytes + 2 * rows * sizeof(OrderingIndex));
+    plan.add_temporary("matrix reordering",
+                       permutation_bytes + compressed_row_matrix_bytes<double>(rows, non_zeros));
+    plan.add_temporary("state vector reordering", permutation_bytes + vector_bytes(rows));
+    plan.add("observable positions", rows * sizeof(std::size_t));
+}
+
+// The plan_* functions of the propagators add their vectors and the bytes moved by the propagation
+// with a matrix of matrix_bytes.
+
+// RK4 steps of dt with a matrix of another format, the compressed row matrix is propagated by the
+// FusedRK4 steps of plan_fused_rk4
+void plan_rk4(DryRun& plan, uint64_t rows, uint64_t matrix_bytes, uint64_t steps)
+{
+    add_rk4_vectors(plan, rows);
+    plan.set_propagation(rk4_step_bytes(matrix_bytes, rows), steps);
+}
+
+void plan_fused_rk4(DryRun& plan, uint64_t rows, uint64_t matrix_bytes, uint64_t steps)
+{
+    add_fused_rk4_vectors(plan, rows);
+    plan.set_propagation(fused_rk4_step_bytes(matrix_bytes, rows), steps);
+}
+
+void plan_matrix_powers_rk4(DryRun& plan, uint64_t rows, uint64_t matrix_bytes, uint64_t steps)
+{
+    add_matrix_powers_vectors(plan, rows);
+    plan.set_propagation(matrix_powers_step_bytes(matrix_bytes, rows), steps);
+}
+
+// LowStorageRK with the given number of stages
+void plan_low_storage_rk(DryRun& plan, uint64_t rows, uint64_t matrix_bytes, uint64_t steps,
+                         uint64_t stages)
+{
+    add_low_storage_rk_vectors(plan, rows);
+    plan.set_propagation(low_storage_rk_step_bytes(matrix_bytes, rows, stages), steps);
+}
+
+// the steps on an active set are bounded by the steps on the whole basis
+void plan_active_set_rk4(DryRun& plan, uint64_t rows, uint64_t matrix_bytes, uint64_t steps)
+{
+    add_active_set_rk4_vectors(plan, rows);
+    plan.set_propagation(active_set_rk4_step_bytes(matrix_bytes, rows), steps);
+}
+
+// compressed row matrix of rows x rows with non_zeros elements assembled by
+// init_matrix_parallel, propagated by steps FusedRK4 steps
+void plan_compressed_rk4(DryRun& plan, uint64_t rows, uint64_t non_zeros, uint64_t steps)
+{
+    plan_fused_rk4(plan, rows, plan_compressed_matrix(plan, rows, non_zeros), steps);
+}
+
+// kinetic and interaction parts of init_split_matrix and the matrix combined from them
+template <typename Index>
+void plan_split_rk4(DryRun& plan, uint64_t rows, uint64_t non_zeros, uint64_t steps)
+{
+    const auto matrix_bytes = compressed_row_matrix_bytes<double>(rows, non_zeros);
+    plan.add("split matrix", compressed_rows_bytes<double, Index>(rows, non_zeros)
+                                 + non_zeros * sizeof(double));
+    plan.add_temporary("split matrix assembly", non_zeros * sizeof(std::complex<double>));
+    plan.add("matrix", matrix_bytes);
+    add_fused_rk4_vectors(plan, rows);
+    plan.set_propagation(fused_rk4_step_bytes(matrix_bytes, rows), steps);
+}
+
+// pattern and recipes of init_symbolic_matrix_no with non_zeros elements made up of terms terms,
+// which are taken over from the assembled rows, and the matrix evaluated from them
+template <typename Index>
+void plan_symbolic_rk4(DryRun& plan, uint64_t rows, uint64_t non_zeros, uint64_t terms,
+                       uint64_t steps)
+{
+    using Term = ieompp::models::hubbard_real_space::MatrixRecipeTerm<double, Index>;
+
+    const auto matrix_bytes = compressed_row_matrix_bytes<double>(rows, non_zeros);
+    plan.add("symbolic matrix", (rows + 1 + non_zeros + 1) * sizeof(std::size_t)
+                                    + non_zeros * sizeof(Index) + terms * sizeof(Term));
+    plan.add_temporary("symbolic matrix assembly",
+                       (rows + 1) * sizeof(std::size_t) + terms * sizeof(Index));
+    plan.add("matrix", matrix_bytes);
+    add_fused_rk4_vectors(plan, rows);
+    plan.set_propagation(fused_rk4_step_bytes(matrix_bytes, rows), steps);
+}
+
+// the vector (1, 0, 0, …) of the calibration runs
+blaze::DynamicVector<std::complex<double>> calibration_vector(uint64_t size)
+{
+    blaze::DynamicVector<std::complex<double>> h(size);
+    h.reset();
+    h[0] = 1.;
+    return h;
+}
+
+// time FusedRK4 steps with the real compressed row matrix M of a small calibration problem
+template <typename Matrix>
+void calibrate_rk4(DryRun& plan, const Matrix& M)
+{
+    get_loggers().main->info("Calibrating run time with the {}x{} matrix", M.rows(), M.columns());
+    auto h = calibration_vector(M.rows());
+    ieompp::ode::FusedRK4<double> rk4(M.rows(), 0.01);
+    plan.calibrate(fused_rk4_step_bytes(
+                       compressed_row_matrix_bytes<double>(M.rows(), M.non_zeros()), M.rows()),
+                   [&] { rk4.step_imaginary(M, h); });
+    get_loggers().main->info("Finished calibration");
+}
+
+// time RK4 steps with a matrix M of another format whose products read matrix_bytes
+template <typename Matrix>
+void calibrate_rk4(DryRun& plan, const Matrix& M, uint64_t matrix_bytes)
+{
+    get_loggers().main->info("Calibrating run time with the {}x{} matrix", M.rows(), M.columns());
+    auto h = calibration_vector(M.rows());
+    const ieompp::ode::RK4<double> rk4(M.rows(), 0.01);
+    plan.calibrate(rk4_step_bytes(matrix_bytes, M.rows()), [&] { rk4.step_imaginary(M, h); });
+    get_loggers().main->info("Finished calibration");
+}
+
+// time RK4 steps with the matrix-powers kernel of a small calibration problem
+template <typename Matrix>
+void calibrate_matrix_powers_rk4(DryRun& plan, const Matrix& M)
+{
+    get_loggers().main->info("Calibrating run time with the {}x{} matrix", M.rows(), M.columns());
+    auto h = calibration_vector(M.rows());
+    ieompp::ode::MatrixPowersRK4<double> rk4(M.rows(), 0.01);
+    const auto& compressed = M.matrix();
+    plan.calibrate(
+        matrix_powers_step_bytes(
+            compressed_row_matrix_bytes<double>(compressed.rows(), compressed.non_zeros()),
+            M.rows()),
+        [&] { rk4.step_imaginary(M, h); });
+    get_loggers().main->info("Finished calibration");
+}
+
+// time the steps of integrator, which moves step_bytes per step with the compressed row matrix
+// M of a small calibration problem
+template <typename Matrix, typename Integrator>
+void calibrate_steps(DryRun& plan, const Matrix& M, Integrator& integrator, uint64_t step_bytes)
+{
+    get_loggers().main->info("Calibrating run time with the {}x{} matrix", M.rows(), M.columns());
+    auto h = calibration_vector(M.rows());
+    plan.calibrate(step_bytes, [&] { integrator.step_imaginary(M, h); });
+    get_loggers().main->info("Finished calibration");
+}
+
+// time LowStorageRK steps with the compressed row matrix M of a small calibration problem
+template <typename Matrix>
+void calibrate_low_storage_rk(DryRun& plan, const Matrix& M,
+                              const ieompp::ode::LowStorageTableau<double>& tableau)
+{
+    ieompp::ode::LowStorageRK<double> integrator(M.rows(), 0.01, tableau);
+    calibrate_steps(plan, M, integrator,
+                    low_storage_rk_step_bytes(
+                        compressed_row_matrix_bytes<double>(M.rows(), M.non_zeros()), M.rows(),
+                        tableau.stages()));
+}
+
+// time ActiveSetRK4 steps on the whole basis, which bound the steps on a smaller active set
+template <typename Matrix>
+void calibrate_active_set_rk4(DryRun& plan, const Matrix& M)
+{
+    ieompp::ode::ActiveSetRK4<double> integrator(M.rows(), 0.01, 0., 0.);
+    calibrate_steps(plan, M, integrator,
+                    active_set_rk4_step_bytes(
+                        compressed_row_matrix_bytes<double>(M.rows(), M.non_zeros()), M.rows()));
+}
+
+// The propagators with adaptive substeps are calibrated with a small problem, whose matrix has
+// the same spectral bounds, and the propagation of the full problem is planned with the average
+// work per measurement interval of the calibration.
+
+// Krylov propagation over intervals measurement intervals of length interval
+template <typename Matrix>
+void plan_krylov(DryRun& plan, uint64_t rows, uint64_t matrix_bytes, uint64_t intervals,
+                 const Matrix& calibration, double interval, uint64_t krylov_dimension,
+                 double tolerance)
+{
+    add_krylov_vectors(plan, rows, krylov_dimension);
+
+    get_loggers().main->info("Calibrating run time with the {}x{} matrix", calibration.rows(),
+                             calibration.columns());
+    auto h = calibration_vector(calibration.rows());
+    ieompp::ode::Krylov<double> krylov(calibration.rows(), interval, krylov_dimension, tolerance);
+    const auto calibration_bytes =
+        compressed_row_matrix_bytes<double>(calibration.rows(), calibration.non_zeros());
+    const auto calls = plan.calibrate_adaptive(
+        [&] { krylov.step_imaginary(calibration, h); },
+        [&] {
+            return krylov_bytes(calibration_bytes, calibration.rows(), krylov_dimension,
+                                krylov.products(), krylov.substeps());
+        });
+    get_loggers().main->info("Finished calibration");
+
+    plan.set_propagation(krylov_bytes(matrix_bytes, rows, krylov_dimension,
+                                      double(krylov.products()) / calls,
+                                      double(krylov.substeps()) / calls),
+                         intervals, "interval");
+}
+
+// Chebyshev propagation over intervals measurement intervals of length interval
+template <typename Matrix>
+void plan_chebyshev(DryRun& plan, uint64_t rows, uint64_t matrix_bytes, uint64_t intervals,
+                    const Matrix& calibration, double interval, double tolerance,
+                    uint64_t steps_per_expansion)
+{
+    add_chebyshev_vectors(plan, rows, steps_per_expansion);
+
+    get_loggers().main->info("Calibrating run time with the {}x{} matrix", calibration.rows(),
+                             calibration.columns());
+    auto h = calibration_vector(calibration.rows());
+    ieompp::ode::Chebyshev<double> chebyshev(calibration.rows(), interval, tolerance,
+                                             steps_per_expansion);
+    const auto calibration_bytes =
+        compressed_row_matrix_bytes<double>(calibration.rows(), calibration.non_zeros());
+    uint64_t steps = 0;
+    const auto calls = plan.calibrate_adaptive(
+        [&] {
+            chebyshev.step_imaginary(calibration, h);
+            ++steps;
+        },
+        [&] {
+            return chebyshev_bytes(calibration_bytes, calibration.rows(), steps_per_expansion,
+                                   chebyshev.products(), steps);
+        },
+        10 * steps_per_expansion);
+    get_loggers().main->info("Finished calibration");
+
+    plan.set_propagation(chebyshev_bytes(matrix_bytes, rows, steps_per_expansion,
+                                         double(chebyshev.products()) / calls, 1.),
+                         intervals, "interval");
+}
+
+// Dormand-Prince steps over intervals measurement intervals of length interval
+template <typename Matrix>
+void plan_dormand_prince(DryRun& plan, uint64_t rows, uint64_t matrix_bytes, uint64_t intervals,
+                         const Matrix& calibration, double interval, double absolute_tolerance,
+                         double relative_tolerance)
+{
+    add_dormand_prince_vectors(plan, rows);
+
+    get_loggers().main->info("Calibrating run time with the {}x{} matrix", calibration.rows(),
+                             calibration.columns());
+    auto h = calibration_vector(calibration.rows());
+    ieompp::ode::DormandPrince<double> dormand_prince(calibration.rows(), interval,
+                                                      absolute_tolerance, relative_tolerance);
+    const auto calibration_bytes =
+        compressed_row_matrix_bytes<double>(calibration.rows(), calibration.non_zeros());
+    const auto attempts = [&] {
+        return double(dormand_prince.accepted_steps() + dormand_prince.rejected_steps());
+    };
+    const auto calls = plan.calibrate_adaptive(
+        [&] { dormand_prince.step_imaginary(calibration, h); },
+        [&] {
+            return dormand_prince_bytes(calibration_bytes, calibration.rows(), attempts(),
+                                        dormand_prince.accepted_steps());
+        });
+    get_loggers().main->info("Finished calibration");
+
+    plan.set_propagation(dormand_prince_bytes(matrix_bytes, rows, attempts() / calls,
+                                              double(dormand_prince.accepted_steps()) / calls),
+                         intervals, "interval");
+}
+
+#endif
@@ -1,21 +1,25 @@
-#ifndef FERMI_JUMP_HPP_
-#define FERMI_JUMP_HPP_
+#ifndef FERMI_JUMP_NO_HPP_
+#define FERMI_JUMP_NO_HPP_
 
 #include "../include/logging.hpp"
 
+#include <ieompp/models/hubbard/dispersion.hpp>
 #include <ieompp/models/hubbard_real_space/fermi_jump_no.hpp>
 
-template <typename Basis, typename Lattice, typename ExpectationValueFunction>
-auto init_fermi_jump(const Basis& basis, const Lattice& lattice, const ExpectationValueFunction& ev)
+template <typename Basis, typename Lattice, typename ExpectationValueFunction, typename Float>
+auto init_fermi_jump(const Basis& basis, const Lattice& lattice, const ExpectationValueFunction& ev,
+                     const Float& filling_factor)
 {
     static_cast<void>(basis);
-    get_loggers().main->info(u8"Init <Δn_{{k_F,↑}}> observable for half-filled model");
-    auto site_occupation = ieompp::models::hubbard_real_space::FermiJump1D_NO<double, Basis>{
+    get_loggers().main->info(u8"Init <Δn_{{k_F,↑}}> observable for filling factor {}",
+                             filling_factor);
+    auto jump = ieompp::models::hubbard_real_space::FermiJump1D_NO<double, Basis>{
         lattice,
         [&ev](const typename Basis::Monomial::Operator& a,
-              const typename Basis::Monomial::Operator& b) { return ev(a.index1, b.index1); }};
+              const typename Basis::Monomial::Operator& b) { return ev(a.index1, b.index1); },
+        ieompp::models::hubbard::calculate_fermi_momentum_1d(filling_factor)};
     get_loggers().main->info(u8"Finished initializing <Δn_{{k_F,↑}}> observable");
-    return site_occupation;
+    return jump;
 }
 
 #endif
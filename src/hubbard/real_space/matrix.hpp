@@ -3,20 +3,65 @@
 
 #include "../include/logging.hpp"
 
+#include <ieompp/exception.hpp>
+#include <ieompp/models/hubbard_real_space/adaptive_matrix.hpp>
+#include <ieompp/models/hubbard_real_space/basis_ordering.hpp>
 #include <ieompp/models/hubbard_real_space/blaze_sparse.hpp>
+#include <ieompp/models/hubbard_real_space/matrix_free.hpp>
+#include <ieompp/models/hubbard_real_space/split_matrix.hpp>
+#include <ieompp/types/compressed_row_matrix.hpp>
+#include <ieompp/types/matrix_powers.hpp>
+#include <ieompp/types/permutation.hpp>
+#include <ieompp/types/sliced_ellpack_matrix.hpp>
+#include <ieompp/types/value_dictionary_matrix.hpp>
+
+#include <complex>
+#include <string>
+#include <vector>
 
 template <typename Liouvillian, typename Basis, typename Lattice>
 auto compute_matrix(const Liouvillian& L, const Basis& basis, const Lattice& lattice)
+{
+    get_loggers().main->info("Creating {}x{} real sparse matrix", basis.size(), basis.size());
+    ieompp::types::CompressedRowMatrix<double> M(basis.size(), basis.size());
+    get_loggers().main->info("Computing matrix elements");
+    ieompp::models::hubbard_real_space::init_matrix_parallel(L, M, basis, lattice);
+    get_loggers().main->info("  {} out of {} matrix elements are non-zero ({}% filling)",
+                             M.non_zeros(), uint64_t(M.rows()) * M.columns(),
+                             double(M.non_zeros()) / (double(M.rows()) * M.columns()));
+    get_loggers().main->info("Finished matrix initialization");
+    return M;
+}
+
+template <typename Liouvillian, typename Operator, typename Lattice>
+auto compute_matrix(
+    const Liouvillian& L,
+    const ieompp::models::hubbard_real_space::TranslationBasis3Operator<Operator>& basis,
+    const Lattice& lattice)
 {
     get_loggers().main->info("Creating {}x{} complex sparse matrix", basis.size(), basis.size());
-    blaze::CompressedMatrix<std::complex<double>, blaze::rowMajor> M(basis.size(), basis.size());
+    ieompp::types::CompressedRowMatrix<std::complex<double>> M(basis.size(), basis.size());
     get_loggers().main->info("Computing matrix elements");
-    ieompp::models::hubbard_real_space::init_matrix(L, M, basis, lattice);
+    ieompp::models::hubbard_real_space::init_matrix_parallel(L, M, basis, lattice);
     get_loggers().main->info("  {} out of {} matrix elements are non-zero ({}% filling)",
-                             M.nonZeros(), M.rows() * M.columns(),
-                             double(M.nonZeros()) / (M.rows() * M.columns()));
-    get_loggers().main->info("Multiply matrix with prefactor 1i");
-    M *= std::complex<double>(0, 1);
+                             M.non_zeros(), uint64_t(M.rows()) * M.columns(),
+                             double(M.non_zeros()) / (double(M.rows()) * M.columns()));
+    get_loggers().main->info("Finished matrix initialization");
+    return M;
+}
+
+template <typename Liouvillian, typename Operator, typename Lattice>
+auto compute_adaptive_matrix(
+    const Liouvillian& L,
+    ieompp::models::hubbard_real_space::AdaptiveBasis3Operator<Operator>& basis,
+    const Lattice& lattice)
+{
+    get_loggers().main->info("Creating {}x{} adaptive real sparse matrix", basis.size(),
+                             basis.size());
+    ieompp::models::hubbard_real_space::AdaptiveMatrix<double, Operator, Liouvillian, Lattice> M(
+        L, basis, lattice);
+    get_loggers().main->info("  {} non-zero matrix elements, {} elements on the boundary",
+                             M.non_zeros(), M.boundary_size());
     get_loggers().main->info("Finished matrix initialization");
     return M;
 }
@@ -24,17 +69,147 @@ auto compute_matrix(const Liouvillian& L, const Basis& basis, const Lattice& lat
 template <typename Liouvillian, typename Basis, typename Lattice>
 auto compute_kinetic_matrix(const Liouvillian& L, const Basis& basis, const Lattice& lattice)
 {
-    get_loggers().main->info("Creating {}x{} complex sparse matrix", basis.size(), basis.size());
-    blaze::CompressedMatrix<std::complex<double>, blaze::rowMajor> M(basis.size(), basis.size());
+    get_loggers().main->info("Creating {}x{} real sparse matrix", basis.size(), basis.size());
+    ieompp::types::CompressedRowMatrix<double> M(basis.size(), basis.size());
     get_loggers().main->info("Computing matrix elements");
-    ieompp::models::hubbard_real_space::init_kinetic_matrix(L, M, basis, lattice);
+    ieompp::models::hubbard_real_space::init_kinetic_matrix_parallel(L, M, basis, lattice);
     get_loggers().main->info("  {} out of {} matrix elements are non-zero ({:.5f}% filling)",
-                             M.nonZeros(), M.rows() * M.columns(),
-                             double(M.nonZeros()) / (M.rows() * M.columns()));
-    get_loggers().main->info("Multiply matrix with prefactor 1i");
-    M *= std::complex<double>(0, 1);
+                             M.non_zeros(), uint64_t(M.rows()) * M.columns(),
+                             double(M.non_zeros()) / (double(M.rows()) * M.columns()));
     get_loggers().main->info("Finished matrix initialization");
     return M;
 }
 
+template <typename Compressed>
+auto compute_sliced_ellpack_matrix(const Compressed& compressed)
+{
+    get_loggers().main->info("Converting matrix to SELL-C-sigma format");
+    ieompp::types::SlicedEllpackMatrix<double> M(compressed);
+    get_loggers().main->info("  storing {} elements for {} non-zeros", M.stored_elements(),
+                             compressed.non_zeros());
+    get_loggers().main->info("Finished matrix conversion");
+    return M;
+}
+
+template <typename Liouvillian, typename Basis, typename Lattice>
+auto compute_sliced_ellpack_matrix(const Liouvillian& L, const Basis& basis,
+                                   const Lattice& lattice)
+{
+    return compute_sliced_ellpack_matrix(compute_matrix(L, basis, lattice));
+}
+
+template <typename Compressed>
+auto compute_value_dictionary_matrix(const Compressed& compressed)
+{
+    get_loggers().main->info("Converting matrix to value dictionary format");
+    ieompp::types::ValueDictionaryMatrix<double> M(compressed);
+    get_loggers().main->info("  {} distinct values", M.table().size());
+    get_loggers().main->info("Finished matrix conversion");
+    return M;
+}
+
+template <typename Liouvillian, typename Basis, typename Lattice>
+auto compute_value_dictionary_matrix(const Liouvillian& L, const Basis& basis,
+                                     const Lattice& lattice)
+{
+    return compute_value_dictionary_matrix(compute_matrix(L, basis, lattice));
+}
+
+template <typename Compressed>
+auto compute_matrix_powers(Compressed compressed, uint64_t block_rows)
+{
+    get_loggers().main->info("Setting up matrix-powers kernel with blocks of {} rows", block_rows);
+    ieompp::types::MatrixPowers<double> M(std::move(compressed), block_rows);
+    get_loggers().main->info("  {} of {} blocks are reused by the 4 products of a step",
+                             M.window(4), M.blocks());
+    get_loggers().main->info("Finished matrix-powers kernel setup");
+    return M;
+}
+
+// ordering is one of lexicographic (the order of the basis), rcm (reverse Cuthill-McKee on the
+// pattern of M) or blocked (tiles of block_size^3 site triples)
+template <typename Basis, typename Matrix>
+auto compute_basis_ordering(const std::string& ordering, uint64_t block_size, const Basis& basis,
+                            const Matrix& M)
+{
+    using Permutation = ieompp::types::Permutation<uint64_t>;
+
+    if(ordering == "lexicographic") {
+        return Permutation::identity(basis.size());
+    }
+
+    get_loggers().main->info("Computing {} basis ordering", ordering);
+    std::vector<uint64_t> new_to_old(basis.size());
+    if(ordering == "rcm") {
+        const auto rcm = ieompp::types::reverse_cuthill_mckee(M);
+        for(uint64_t i = 0; i < basis.size(); ++i) {
+            new_to_old[i] = rcm.old_index(i);
+        }
+    } else if(ordering == "blocked") {
+        const auto blocked =
+            ieompp::models::hubbard_real_space::blocked_basis_ordering(basis, block_size);
+        for(uint64_t i = 0; i < basis.size(); ++i) {
+            new_to_old[i] = blocked.old_index(i);
+        }
+    } else {
+        THROW(ieompp::Exception, "Unknown basis ordering \"" + ordering + "\"");
+    }
+    get_loggers().main->info("Finished basis ordering");
+    return Permutation(std::move(new_to_old));
+}
+
+template <typename Matrix, typename Permutation>
+auto reorder_matrix(const Matrix& M, const Permutation& permutation)
+{
+    get_loggers().main->info("Reordering matrix rows and columns");
+    auto reordered = ieompp::types::permute(M, permutation);
+    get_loggers().main->info("  bandwidth {} -> {}", ieompp::types::bandwidth(M),
+                             ieompp::types::bandwidth(reordered));
+    get_loggers().main->info("Finished matrix reordering");
+    return reordered;
+}
+
+template <typename Liouvillian, typename Basis, typename Lattice>
+auto compute_matrix_free(const Liouvillian& L, const Basis& basis, const Lattice& lattice)
+{
+    get_loggers().main->info("Creating {}x{} matrix-free real Liouvillian", basis.size(),
+                             basis.size());
+    ieompp::models::hubbard_real_space::MatrixFreeLiouvillian<double, Basis> M(L, basis, lattice);
+    get_loggers().main->info("Finished matrix initialization");
+    return M;
+}
+
+template <typename Basis, typename Lattice>
+auto compute_split_matrix(const Basis& basis, const Lattice& lattice)
+{
+    get_loggers().main->info("Computing kinetic and interaction parts of the {}x{} matrix",
+                             basis.size(), basis.size());
+    const auto split =
+        ieompp::models::hubbard_real_space::init_split_matrix<double>(basis, lattice);
+    get_loggers().main->info("  {} out of {} matrix elements are non-zero ({}% filling)",
+                             split.non_zeros(), split.rows() * split.rows(),
+                             double(split.non_zeros()) / (split.rows() * split.rows()));
+    get_loggers().main->info("Finished matrix initialization");
+    return split;
+}
+
+template <typename Split, typename Liouvillian>
+auto compute_matrix(const Split& split, const Liouvillian& L)
+{
+    get_loggers().main->info("Creating {}x{} real sparse matrix", split.rows(), split.rows());
+    ieompp::types::CompressedRowMatrix<double> M(split.rows(), split.rows());
+    get_loggers().main->info("Combining matrix elements");
+    ieompp::models::hubbard_real_space::init_combined_matrix(split, L, M);
+    get_loggers().main->info("Finished matrix initialization");
+    return M;
+}
+
+template <typename Split, typename Liouvillian, typename Matrix>
+void update_matrix(const Split& split, const Liouvillian& L, Matrix& M)
+{
+    get_loggers().main->info("Updating matrix elements for J={}, U={}", L.J, L.U);
+    ieompp::models::hubbard_real_space::update_combined_matrix(split, L, M);
+    get_loggers().main->info("Finished matrix update");
+}
+
 #endif
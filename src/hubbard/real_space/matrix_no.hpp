@@ -1,23 +1,23 @@
-#ifndef MATRIX_HPP_
-#define MATRIX_HPP_
+#ifndef MATRIX_NO_HPP_
+#define MATRIX_NO_HPP_
 
 #include "../include/logging.hpp"
 
 #include <ieompp/models/hubbard_real_space/blaze_sparse_no.hpp>
+#include <ieompp/models/hubbard_real_space/symbolic_matrix_no.hpp>
+#include <ieompp/types/compressed_row_matrix.hpp>
 
 template <typename Liouvillian, typename Basis, typename Lattice, typename ExpectationValue>
 auto compute_matrix(const Liouvillian& L, const Basis& basis, const Lattice& lattice,
                     const ExpectationValue& ev)
 {
-    get_loggers().main->info("Creating {}x{} complex sparse matrix", basis.size(), basis.size());
-    blaze::CompressedMatrix<std::complex<double>, blaze::rowMajor> M(basis.size(), basis.size());
+    get_loggers().main->info("Creating {}x{} real sparse matrix", basis.size(), basis.size());
+    ieompp::types::CompressedRowMatrix<double> M(basis.size(), basis.size());
     get_loggers().main->info("Computing matrix elements");
-    ieompp::models::hubbard_real_space::init_matrix_no(L, M, basis, lattice, ev);
+    ieompp::models::hubbard_real_space::init_matrix_no_parallel(L, M, basis, lattice, ev);
     get_loggers().main->info("  {} out of {} matrix elements are non-zero ({}% filling)",
-                             M.nonZeros(), M.rows() * M.columns(),
-                             double(M.nonZeros()) / (M.rows() * M.columns()));
-    get_loggers().main->info("Multiply matrix with prefactor 1i");
-    M *= std::complex<double>(0, 1);
+                             M.non_zeros(), uint64_t(M.rows()) * M.columns(),
+                             double(M.non_zeros()) / (double(M.rows()) * M.columns()));
     get_loggers().main->info("Finished matrix initialization");
     return M;
 }
@@ -25,17 +25,50 @@ auto compute_matrix(const Liouvillian& L, const Basis& basis, const Lattice& lat
 template <typename Liouvillian, typename Basis, typename Lattice>
 auto compute_kinetic_matrix(const Liouvillian& L, const Basis& basis, const Lattice& lattice)
 {
-    get_loggers().main->info("Creating {}x{} complex sparse matrix", basis.size(), basis.size());
-    blaze::CompressedMatrix<std::complex<double>, blaze::rowMajor> M(basis.size(), basis.size());
+    get_loggers().main->info("Creating {}x{} real sparse matrix", basis.size(), basis.size());
+    ieompp::types::CompressedRowMatrix<double> M(basis.size(), basis.size());
     get_loggers().main->info("Computing matrix elements");
-    ieompp::models::hubbard_real_space::init_kinetic_matrix_no(L, M, basis, lattice);
+    ieompp::models::hubbard_real_space::init_kinetic_matrix_no_parallel(L, M, basis, lattice);
     get_loggers().main->info("  {} out of {} matrix elements are non-zero ({:.5f}% filling)",
-                             M.nonZeros(), M.rows() * M.columns(),
-                             double(M.nonZeros()) / (M.rows() * M.columns()));
-    get_loggers().main->info("Multiply matrix with prefactor 1i");
-    M *= std::complex<double>(0, 1);
+                             M.non_zeros(), uint64_t(M.rows()) * M.columns(),
+                             double(M.non_zeros()) / (double(M.rows()) * M.columns()));
     get_loggers().main->info("Finished matrix initialization");
     return M;
 }
 
+template <typename Basis, typename Lattice>
+auto compute_symbolic_matrix(const Basis& basis, const Lattice& lattice)
+{
+    get_loggers().main->info("Computing sparsity pattern of the {}x{} matrix", basis.size(),
+                             basis.size());
+    const auto symbolic =
+        ieompp::models::hubbard_real_space::init_symbolic_matrix_no<double>(basis, lattice);
+    get_loggers().main->info("  {} non-zero elements made up of {} terms", symbolic.non_zeros(),
+                             symbolic.terms.size());
+    get_loggers().main->info("Finished computing sparsity pattern");
+    return symbolic;
+}
+
+template <typename Symbolic, typename Liouvillian, typename ExpectationValue>
+auto compute_numeric_matrix(const Symbolic& symbolic, const Liouvillian& L,
+                            const ExpectationValue& ev)
+{
+    get_loggers().main->info("Creating {}x{} real sparse matrix", symbolic.rows(),
+                             symbolic.rows());
+    ieompp::types::CompressedRowMatrix<double> M(symbolic.rows(), symbolic.rows());
+    get_loggers().main->info("Computing matrix elements");
+    ieompp::models::hubbard_real_space::init_numeric_matrix_no(symbolic, L, M, ev);
+    get_loggers().main->info("Finished matrix initialization");
+    return M;
+}
+
+template <typename Symbolic, typename Liouvillian, typename ExpectationValue, typename Matrix>
+void update_numeric_matrix(const Symbolic& symbolic, const Liouvillian& L,
+                           const ExpectationValue& ev, Matrix& M)
+{
+    get_loggers().main->info("Updating matrix elements");
+    ieompp::models::hubbard_real_space::update_numeric_matrix_no(symbolic, L, M, ev);
+    get_loggers().main->info("Finished matrix update");
+}
+
 #endif
@@ -5,16 +5,32 @@
 
 #include <ieompp/models/hubbard_real_space/site_occupation.hpp>
 
-template <typename Basis, typename ExpectationValueFunction>
-auto init_site_occupation(const Basis& basis, const Basis& conjugate_basis,
+template <typename Basis, typename ConjugateBasis, typename ExpectationValueFunction>
+auto init_site_occupation(const Basis& basis, const ConjugateBasis& conjugate_basis,
                           const ExpectationValueFunction& ev)
 {
     static_cast<void>(basis);
     get_loggers().main->info(u8"Init <n_{0,↑}> observable for half-filled model");
+    auto site_occupation =
+        ieompp::models::hubbard_real_space::SiteOccupation<double, Basis, ConjugateBasis>{
+            [&ev](const typename Basis::Monomial::Operator& a,
+                  const typename Basis::Monomial::Operator& b) { return ev(a.index1, b.index1); },
+            std::cref(basis), std::cref(conjugate_basis)};
+    get_loggers().main->info(u8"Finished initializing <n_{0,↑}> observable");
+    return site_occupation;
+}
+
+template <typename Operator, typename ExpectationValueFunction>
+auto init_site_occupation(
+    const ieompp::models::hubbard_real_space::SymmetricBasis3Operator<Operator>& basis,
+    const ExpectationValueFunction& ev)
+{
+    using Basis = ieompp::models::hubbard_real_space::SymmetricBasis3Operator<Operator>;
+
+    get_loggers().main->info(u8"Init <n_{0,↑}> observable for the symmetric sector");
     auto site_occupation = ieompp::models::hubbard_real_space::SiteOccupation<double, Basis>{
-        [&ev](const typename Basis::Monomial::Operator& a,
-              const typename Basis::Monomial::Operator& b) { return ev(a.index1, b.index1); },
-        std::cref(basis), std::cref(conjugate_basis)};
+        [&ev](const Operator& a, const Operator& b) { return ev(a.index1, b.index1); },
+        std::cref(basis)};
     get_loggers().main->info(u8"Finished initializing <n_{0,↑}> observable");
     return site_occupation;
 }
@@ -101,6 +101,21 @@ void test_closest()
     REQUIRE(disc.closest(Real(N - 1) + 0.51) == 0);
 }
 
+template <typename Real>
+void test_point_group()
+{
+    lattices::PeriodicChain<Real> disc(N, 1.);
+
+    const auto group = disc.point_group();
+    REQUIRE(group.size() == 2);
+    for(std::size_t i = 0; i < N; ++i) {
+        REQUIRE(group[0][i] == i);
+        REQUIRE(group[1][(N - i) % N] == i);
+        REQUIRE(disc.lattice_distance(0, group[1][i]) == disc.lattice_distance(0, i));
+        REQUIRE(disc.neighboring(group[1][i], group[1][(i + 1) % N]));
+    }
+}
+
 TEST_CASE("initialization (real space)")
 {
     test_initialization_real_space<float>();
@@ -135,3 +150,10 @@ TEST_CASE("unique_neighbors")
     test_unique_neighbors<double>();
     test_unique_neighbors<long double>();
 }
+
+TEST_CASE("point group")
+{
+    test_point_group<float>();
+    test_point_group<double>();
+    test_point_group<long double>();
+}
@@ -1,6 +1,8 @@
 #define CATCH_CONFIG_MAIN
 #include <catch.hpp>
 
+#include <algorithm>
+
 #include <ieompp/lattices/periodic_square_lattice.hpp>
 using namespace ieompp;
 
@@ -219,6 +221,54 @@ void test_closest()
     REQUIRE(disc.closest(Vector{-0.51, -0.51}) == disc.index(NX - 1, NY - 1));
 }
 
+template <typename Real>
+void test_point_group()
+{
+    lattices::PeriodicSquareLattice<Real> disc(NX, NY, 1., 1.);
+
+    const auto group = disc.point_group();
+    REQUIRE(group.size() == 8);
+    for(const auto& permutation : group) {
+        REQUIRE(permutation.size() == N);
+        REQUIRE(permutation[0] == 0);
+
+        auto sorted = permutation;
+        std::sort(sorted.begin(), sorted.end());
+        for(std::size_t i = 0; i < N; ++i) {
+            REQUIRE(sorted[i] == i);
+        }
+
+        for(std::size_t i = 0; i < NX; ++i) {
+            for(std::size_t j = 0; j < NY; ++j) {
+                const auto idx = disc.index(i, j);
+                REQUIRE(disc.neighboring(permutation[idx],
+                                         permutation[disc.index((i + 1) % NX, j)]));
+                REQUIRE(disc.neighboring(permutation[idx],
+                                         permutation[disc.index(i, (j + 1) % NY)]));
+            }
+        }
+    }
+}
+
+template <typename Real>
+void test_lattice_distance()
+{
+    lattices::PeriodicSquareLattice<Real> disc(NX, NY, 1., 1.);
+
+    for(std::size_t i = 0; i < NX; ++i) {
+        for(std::size_t j = 0; j < NY; ++j) {
+            const auto idx = disc.index(i, j);
+            REQUIRE(disc.lattice_distance(idx, idx) == 0);
+            REQUIRE(disc.lattice_distance(0, idx)
+                    == std::min(i, NX - i) + std::min(j, NY - j));
+            REQUIRE(disc.lattice_distance(0, idx) == disc.lattice_distance(idx, 0));
+            for(auto neighbor : disc.neighbors(idx)) {
+                REQUIRE(disc.lattice_distance(idx, neighbor) == 1);
+            }
+        }
+    }
+}
+
 TEST_CASE("initialization (real space)")
 {
     test_initialization_real_space<float>();
@@ -253,3 +303,17 @@ TEST_CASE("unique neighbors")
     test_unique_neighbors<double>();
     test_unique_neighbors<long double>();
 }
+
+TEST_CASE("point group")
+{
+    test_point_group<float>();
+    test_point_group<double>();
+    test_point_group<long double>();
+}
+
+TEST_CASE("lattice distance")
+{
+    test_lattice_distance<float>();
+    test_lattice_distance<double>();
+    test_lattice_distance<long double>();
+}
@@ -5,6 +5,7 @@
 #include <ieompp/algebra/operator.hpp>
 #include <ieompp/constants.hpp>
 #include <ieompp/lattices/periodic_chain.hpp>
+#include <ieompp/models/hubbard/conjugate_basis.hpp>
 #include <ieompp/models/hubbard/dispersion.hpp>
 #include <ieompp/models/hubbard_momentum_space/basis.hpp>
 #include <ieompp/models/hubbard_momentum_space/non_vanishing_expectation_values.hpp>
@@ -85,3 +86,30 @@ TEST_CASE("simple operators (half-filled, 1d)")
         REQUIRE(nvevs[16] == (Contribution{9ul, 9ul, 4.0}));
     }
 }
+
+TEST_CASE("conjugate basis view (half-filled, 1d)")
+{
+    for(uint64_t N = 3; N <= 8; ++N) {
+        const auto brillouin_zone = lattices::PeriodicChain<double, uint64_t>(N);
+        const auto lattice        = lattices::PeriodicChain<double, uint64_t>(N, 1.);
+        const auto dispersion     = models::hubbard::make_dispersion(brillouin_zone, lattice, 1.);
+
+        for(const auto k_idx : brillouin_zone) {
+            const auto basis =
+                models::hubbard_momentum_space::Basis3Operator<Monomial>(k_idx, brillouin_zone);
+            const auto conjugate_basis      = basis.get_conjugate();
+            const auto conjugate_basis_view = models::hubbard::make_conjugate_basis(basis);
+
+            const models::hubbard_momentum_space::NonVanishingExpectationValues<uint64_t, double>
+                nvevs(basis, conjugate_basis, dispersion, 0.),
+                view_nvevs(basis, conjugate_basis_view, dispersion, 0.);
+
+            CAPTURE(N);
+            CAPTURE(k_idx);
+            REQUIRE(view_nvevs.size() == nvevs.size());
+            for(std::size_t i = 0; i < nvevs.size(); ++i) {
+                REQUIRE(view_nvevs[i] == nvevs[i]);
+            }
+        }
+    }
+}
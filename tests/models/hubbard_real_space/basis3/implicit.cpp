@@ -0,0 +1,36 @@
+#include "basis3.hpp"
+
+#include <ieompp/models/hubbard_real_space/implicit_basis.hpp>
+using namespace ieompp;
+
+TEST_CASE("implicit")
+{
+    for(uint64_t N = 1; N <= 8; ++N) {
+        lattices::PeriodicChain<double, uint64_t> chain(N, 1.);
+        const models::hubbard_real_space::Basis3Operator<Monomial> basis(chain);
+        const models::hubbard_real_space::ImplicitBasis3Operator<Operator> implicit_basis(chain);
+
+        const auto conjugate_basis          = basis.get_conjugate();
+        const auto implicit_conjugate_basis = implicit_basis.get_conjugate();
+
+        REQUIRE(implicit_basis.size() == basis.size());
+        REQUIRE(implicit_basis.N == basis.N);
+        REQUIRE(!implicit_basis.is_conjugated());
+        REQUIRE(implicit_conjugate_basis.is_conjugated());
+
+        for(uint64_t i = 0; i < basis.size(); ++i) {
+            REQUIRE(implicit_basis[i].to_monomial<Monomial>() == basis[i]);
+            REQUIRE(implicit_conjugate_basis[i].to_monomial<Monomial>() == conjugate_basis[i]);
+            REQUIRE(implicit_basis[i].get_conjugate().to_monomial<Monomial>()
+                    == conjugate_basis[i]);
+        }
+
+        for(uint64_t i = 0; i < N; ++i) {
+            for(uint64_t j = 0; j < N; ++j) {
+                for(uint64_t k = 0; k < N; ++k) {
+                    REQUIRE(implicit_basis.get_3op_index(i, j, k) == basis.get_3op_index(i, j, k));
+                }
+            }
+        }
+    }
+}
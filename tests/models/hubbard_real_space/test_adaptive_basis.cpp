@@ -0,0 +1,221 @@
+#define CATCH_CONFIG_MAIN
+#include <catch.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <limits>
+#include <vector>
+
+#include <ieompp/algebra/operator.hpp>
+#include <ieompp/lattices/periodic_chain.hpp>
+#include <ieompp/lattices/periodic_square_lattice.hpp>
+#include <ieompp/models/hubbard/dispersion.hpp>
+#include <ieompp/models/hubbard_real_space/adaptive_basis.hpp>
+#include <ieompp/models/hubbard_real_space/adaptive_matrix.hpp>
+#include <ieompp/models/hubbard_real_space/blaze_sparse.hpp>
+#include <ieompp/models/hubbard_real_space/expectation_value.hpp>
+#include <ieompp/models/hubbard_real_space/fermi_jump.hpp>
+#include <ieompp/models/hubbard_real_space/implicit_basis.hpp>
+#include <ieompp/models/hubbard_real_space/liouvillian.hpp>
+#include <ieompp/ode/adaptive_rk4.hpp>
+#include <ieompp/ode/rk4.hpp>
+#include <ieompp/types/blaze.hpp>
+#include <ieompp/types/compressed_row_matrix.hpp>
+#include <ieompp/types/hash_index.hpp>
+using namespace ieompp;
+
+using Operator      = algebra::Operator<uint64_t, bool>;
+using Basis         = models::hubbard_real_space::ImplicitBasis3Operator<Operator>;
+using AdaptiveBasis = models::hubbard_real_space::AdaptiveBasis3Operator<Operator>;
+using Matrix        = types::CompressedRowMatrix<double>;
+using Vector        = blaze::DynamicVector<std::complex<double>>;
+
+namespace
+{
+    Vector make_vector(std::size_t size)
+    {
+        Vector x(size);
+        for(std::size_t i = 0; i < size; ++i) {
+            x[i] = std::complex<double>(std::cos(0.3 * i), std::sin(0.7 * i));
+        }
+        return x;
+    }
+
+    // grow the basis in batches of every stride-th real-space element and compare the adaptive
+    // matrix and its boundary flux with the real-space matrix after each batch
+    template <typename Lattice>
+    void test_matrix(const Lattice& lattice, uint64_t stride)
+    {
+        const auto liouvillian = models::hubbard_real_space::make_liouvillian(1.3, 0.7);
+        const Basis basis(lattice);
+        Matrix matrix;
+        models::hubbard_real_space::init_matrix_parallel(liouvillian, matrix, basis, lattice);
+
+        AdaptiveBasis adaptive_basis(lattice);
+        models::hubbard_real_space::AdaptiveMatrix<double, Operator, decltype(liouvillian),
+                                                   Lattice>
+            adaptive_matrix(liouvillian, adaptive_basis, lattice);
+
+        for(uint64_t offset = 0; offset < stride; ++offset) {
+            for(uint64_t i = basis.size() - 1 - offset; i >= basis.N; i -= stride) {
+                adaptive_basis.insert(i);
+            }
+            adaptive_matrix.extend();
+            REQUIRE(adaptive_matrix.rows() == adaptive_basis.size());
+
+            const auto v = make_vector(adaptive_basis.size());
+            Vector h, y(basis.size()), w(adaptive_basis.size());
+            models::hubbard_real_space::adaptive_to_real_space(adaptive_basis, v, h);
+            matrix.multiply(h, y);
+            adaptive_matrix.multiply(v, w);
+
+            double norm = 0.;
+            for(uint64_t i = 0; i < basis.size(); ++i) {
+                const auto index = adaptive_basis.find(i);
+                if(index == adaptive_basis.size()) {
+                    norm += std::norm(y[i]);
+                } else {
+                    REQUIRE(adaptive_basis.real_space_index(index) == i);
+                    REQUIRE(std::abs(w[index] - y[i]) < 1e-10);
+                }
+            }
+
+            std::vector<uint64_t> elements;
+            REQUIRE(adaptive_matrix.flux(v, std::numeric_limits<double>::max(), elements)
+                    == Approx(std::sqrt(norm)));
+            REQUIRE(elements.empty());
+        }
+        REQUIRE(adaptive_basis.size() == basis.size());
+        REQUIRE(adaptive_matrix.boundary_size() == 0);
+        REQUIRE(adaptive_matrix.non_zeros() == matrix.non_zeros());
+    }
+} // namespace
+
+TEST_CASE("hash index")
+{
+    using Index = types::HashIndex<uint64_t>;
+
+    std::vector<uint64_t> keys;
+    for(uint64_t i = 0; i < 100000; ++i) {
+        keys.push_back((i * 7919) % 1000003);
+    }
+    const Index index(keys);
+    REQUIRE(index.size() == keys.size());
+    for(uint64_t i = 0; i < keys.size(); ++i) {
+        REQUIRE(index.find(keys[i]) == i);
+    }
+    REQUIRE(index.find(1000003) == Index::not_found);
+
+    // the partitions are rebuilt while the keys are inserted
+    Index growing;
+    REQUIRE(growing.find(0) == Index::not_found);
+    for(uint64_t i = 0; i < keys.size(); ++i) {
+        REQUIRE(growing.insert(keys[i], i) == std::make_pair(i, true));
+    }
+    REQUIRE(growing.size() == keys.size());
+    for(uint64_t i = 0; i < keys.size(); ++i) {
+        REQUIRE(growing.find(keys[i]) == i);
+        REQUIRE(growing.insert(keys[i], 0) == std::make_pair(i, false));
+    }
+    REQUIRE(growing.find(1000003) == Index::not_found);
+}
+
+TEST_CASE("insertion")
+{
+    const lattices::PeriodicChain<double, uint64_t> lattice(5, 1.);
+    AdaptiveBasis basis(lattice);
+    REQUIRE(basis.size() == 5);
+    for(uint64_t i = 0; i < basis.N; ++i) {
+        REQUIRE(basis.find(i) == i);
+        REQUIRE(basis.insert(i) == std::make_pair(i, false));
+    }
+
+    const uint64_t elements[] = {97, 5, 129, 42};
+    for(uint64_t i = 0; i < 4; ++i) {
+        REQUIRE(basis.find(elements[i]) == basis.size());
+        REQUIRE(basis.insert(elements[i]) == std::make_pair(5 + i, true));
+        REQUIRE(basis.insert(elements[i]) == std::make_pair(5 + i, false));
+        REQUIRE(basis.real_space_index(5 + i) == elements[i]);
+        REQUIRE(basis[5 + i][0].index1 == (elements[i] - 5) / 25);
+        REQUIRE(basis[5 + i][2].index1 == (elements[i] - 5) % 5);
+    }
+    REQUIRE(basis.size() == 9);
+    for(uint64_t i = 0; i < 4; ++i) {
+        REQUIRE(basis.find(elements[i]) == 5 + i);
+    }
+    REQUIRE(basis.find(6) == basis.size());
+}
+
+TEST_CASE("adaptive matrices")
+{
+    const lattices::PeriodicChain<double, uint64_t> chain(6, 1.);
+    for(uint64_t stride = 1; stride <= 4; ++stride) {
+        test_matrix(chain, stride);
+    }
+
+    const lattices::PeriodicSquareLattice<double, uint64_t> square(3, 3);
+    test_matrix(square, 3);
+}
+
+TEST_CASE("adaptive propagation")
+{
+    const lattices::PeriodicChain<double, uint64_t> lattice(8, 1.);
+    const auto liouvillian = models::hubbard_real_space::make_liouvillian(1., 2.);
+    const double dt        = 0.01;
+    const uint64_t steps   = 100;
+
+    const Basis basis(lattice);
+    Matrix matrix;
+    models::hubbard_real_space::init_matrix_parallel(liouvillian, matrix, basis, lattice);
+    Vector reference(basis.size());
+    reference.reset();
+    reference[0] = 1.;
+    const ode::RK4<double> rk4(basis.size(), dt);
+    for(uint64_t step = 0; step < steps; ++step) {
+        rk4.step_imaginary(matrix, reference);
+    }
+
+    const auto k_F = models::hubbard::calculate_fermi_momentum_1d(0.5);
+    const models::hubbard_real_space::ExpectationValue1DHalfFilled<double, decltype(lattice)> ev(
+        lattice, 0.5, k_F);
+    const auto ev_function = [&ev](const Operator& a, const Operator& b) {
+        return ev(a.index1, b.index1);
+    };
+    const models::hubbard_real_space::FermiJump1D<double, Basis> jump(basis, lattice, ev_function,
+                                                                      k_F);
+
+    for(const double threshold : {0., 1e-4, 1e-2}) {
+        AdaptiveBasis adaptive_basis(lattice);
+        models::hubbard_real_space::AdaptiveMatrix<double, Operator, decltype(liouvillian),
+                                                   decltype(lattice)>
+            adaptive_matrix(liouvillian, adaptive_basis, lattice);
+        const models::hubbard_real_space::FermiJump1D<double, AdaptiveBasis> adaptive_jump(
+            adaptive_basis, lattice, ev_function, k_F);
+
+        Vector v(adaptive_basis.size());
+        v.reset();
+        v[0] = 1.;
+        ode::AdaptiveRK4<double> integrator(dt, threshold);
+        for(uint64_t step = 0; step < steps; ++step) {
+            integrator.step_imaginary(adaptive_matrix, v);
+        }
+        REQUIRE(v.size() == adaptive_basis.size());
+
+        Vector h;
+        models::hubbard_real_space::adaptive_to_real_space(adaptive_basis, v, h);
+        double deviation = 0.;
+        for(uint64_t i = 0; i < basis.size(); ++i) {
+            deviation += std::norm(h[i] - reference[i]);
+        }
+        deviation = std::sqrt(deviation);
+
+        // the error indicator estimates the truncation error, the error of the RK4 steps is
+        // much smaller
+        REQUIRE(deviation <= integrator.error_indicator());
+        REQUIRE(adaptive_jump(v) == Approx(jump(h)));
+        if(threshold >= 1e-2) {
+            REQUIRE(adaptive_basis.size() < basis.size());
+        }
+    }
+}
@@ -0,0 +1,358 @@
+#define CATCH_CONFIG_MAIN
+#include <catch.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <complex>
+
+#include <ieompp/algebra/monomial.hpp>
+#include <ieompp/algebra/operator.hpp>
+#include <ieompp/lattices/periodic_chain.hpp>
+#include <ieompp/models/hubbard_real_space/basis.hpp>
+#include <ieompp/models/hubbard_real_space/basis_ordering.hpp>
+#include <ieompp/models/hubbard_real_space/blaze_sparse.hpp>
+#include <ieompp/models/hubbard_real_space/blaze_sparse_no.hpp>
+#include <ieompp/models/hubbard_real_space/expectation_value.hpp>
+#include <ieompp/models/hubbard_real_space/implicit_basis.hpp>
+#include <ieompp/models/hubbard_real_space/liouvillian.hpp>
+#include <ieompp/models/hubbard_real_space/matrix_free.hpp>
+#include <ieompp/models/hubbard_real_space/symbolic_matrix_no.hpp>
+#include <ieompp/ode/matrix_powers_rk4.hpp>
+#include <ieompp/ode/rk4.hpp>
+#include <ieompp/types/blaze.hpp>
+#include <ieompp/types/compressed_row_matrix.hpp>
+#include <ieompp/types/matrix_powers.hpp>
+#include <ieompp/types/permutation.hpp>
+#include <ieompp/types/sliced_ellpack_matrix.hpp>
+#include <ieompp/types/value_dictionary_matrix.hpp>
+using namespace ieompp;
+
+using Operator = algebra::Operator<uint64_t, bool>;
+using Monomial = algebra::Monomial<Operator>;
+using Basis    = models::hubbard_real_space::Basis3Operator<Monomial>;
+using Matrix   = types::CompressedRowMatrix<double>;
+using Vector   = blaze::DynamicVector<std::complex<double>>;
+
+// matrix has to contain the elements of reference and may contain additional explicit zeros
+void require_equal_up_to_zeros(const Matrix& matrix, const Matrix& reference)
+{
+    REQUIRE(matrix.rows() == reference.rows());
+    for(std::size_t row = 0; row < reference.rows(); ++row) {
+        auto it = matrix.begin(row);
+        for(auto ref = reference.begin(row); ref != reference.end(row); ++ref, ++it) {
+            for(; (it != matrix.end(row)) && (it->index() < ref->index()); ++it) {
+                REQUIRE(it->value() == Approx(0.));
+            }
+            REQUIRE(it != matrix.end(row));
+            REQUIRE(it->index() == ref->index());
+            REQUIRE(it->value() == Approx(ref->value()));
+        }
+        for(; it != matrix.end(row); ++it) {
+            REQUIRE(it->value() == Approx(0.));
+        }
+    }
+}
+
+TEST_CASE("init_matrix_parallel")
+{
+    const auto liouvillian = models::hubbard_real_space::make_liouvillian(1.3, 0.7);
+    for(uint64_t N = 3; N <= 8; ++N) {
+        const lattices::PeriodicChain<double, uint64_t> lattice(N, 1.);
+        const Basis basis(lattice);
+
+        Matrix serial, parallel;
+        models::hubbard_real_space::init_matrix(liouvillian, serial, basis, lattice);
+        models::hubbard_real_space::init_matrix_parallel(liouvillian, parallel, basis, lattice);
+
+        REQUIRE(serial.rows() == basis.size());
+        REQUIRE(serial.columns() == basis.size());
+        REQUIRE(serial.row_pointers() == parallel.row_pointers());
+        REQUIRE(serial.column_indices() == parallel.column_indices());
+        REQUIRE(serial.values() == parallel.values());
+
+        // the predicted number of elements is exact for N >= 3
+        const auto non_zeros =
+            models::hubbard_real_space::number_of_kinetic_elements<Basis, decltype(lattice)>(basis)
+            + models::hubbard_real_space::number_of_interaction_elements(basis);
+        REQUIRE(parallel.non_zeros() == non_zeros);
+    }
+}
+
+TEST_CASE("split matrix")
+{
+    const auto liouvillian = models::hubbard_real_space::make_liouvillian(1.3, 0.7);
+    const auto updated     = models::hubbard_real_space::make_liouvillian(-0.4, 2.1);
+    for(uint64_t N = 3; N <= 8; ++N) {
+        const lattices::PeriodicChain<double, uint64_t> lattice(N, 1.);
+        const Basis basis(lattice);
+        const auto split = models::hubbard_real_space::init_split_matrix<double>(basis, lattice);
+
+        Matrix combined, reference;
+        models::hubbard_real_space::init_combined_matrix(split, liouvillian, combined);
+        models::hubbard_real_space::init_matrix(liouvillian, reference, basis, lattice);
+        require_equal_up_to_zeros(combined, reference);
+
+        models::hubbard_real_space::update_combined_matrix(split, updated, combined);
+        models::hubbard_real_space::init_matrix(updated, reference, basis, lattice);
+        require_equal_up_to_zeros(combined, reference);
+    }
+}
+
+TEST_CASE("split matrix_no")
+{
+    const auto liouvillian = models::hubbard_real_space::make_liouvillian(1.3, 0.7);
+    const auto updated     = models::hubbard_real_space::make_liouvillian(-0.4, 2.1);
+    for(uint64_t N = 3; N <= 8; ++N) {
+        const lattices::PeriodicChain<double, uint64_t> lattice(N, 1.);
+        const Basis basis(lattice);
+        const models::hubbard_real_space::ExpectationValue1DHalfFilled<double, decltype(lattice)>
+            ev(lattice, 0.5, 0.25);
+        const auto split =
+            models::hubbard_real_space::init_split_matrix_no<double>(basis, lattice, ev);
+
+        Matrix combined, reference;
+        models::hubbard_real_space::init_combined_matrix(split, liouvillian, combined);
+        models::hubbard_real_space::init_matrix_no(liouvillian, reference, basis, lattice, ev);
+        require_equal_up_to_zeros(combined, reference);
+
+        models::hubbard_real_space::update_combined_matrix(split, updated, combined);
+        models::hubbard_real_space::init_matrix_no(updated, reference, basis, lattice, ev);
+        require_equal_up_to_zeros(combined, reference);
+    }
+}
+
+TEST_CASE("matrix-free Liouvillian")
+{
+    const auto liouvillian = models::hubbard_real_space::make_liouvillian(1.3, 0.7);
+    for(uint64_t N = 3; N <= 8; ++N) {
+        const lattices::PeriodicChain<double, uint64_t> lattice(N, 1.);
+        const Basis basis(lattice);
+
+        Matrix matrix;
+        models::hubbard_real_space::init_matrix(liouvillian, matrix, basis, lattice);
+        const models::hubbard_real_space::MatrixFreeLiouvillian<double, Basis> matrix_free(
+            liouvillian, basis, lattice);
+
+        Vector x(basis.size()), y_sparse(basis.size()), y_matrix_free(basis.size());
+        for(std::size_t i = 0; i < basis.size(); ++i) {
+            x[i] = std::complex<double>(std::cos(0.3 * i), std::sin(0.7 * i));
+        }
+
+        matrix.multiply(x, y_sparse);
+        matrix_free.multiply(x, y_matrix_free);
+
+        for(std::size_t i = 0; i < basis.size(); ++i) {
+            REQUIRE(y_sparse[i].real() == Approx(y_matrix_free[i].real()));
+            REQUIRE(y_sparse[i].imag() == Approx(y_matrix_free[i].imag()));
+        }
+    }
+}
+
+TEST_CASE("sliced ELLPACK matrix")
+{
+    const auto liouvillian = models::hubbard_real_space::make_liouvillian(1.3, 0.7);
+    for(uint64_t N = 3; N <= 8; ++N) {
+        const lattices::PeriodicChain<double, uint64_t> lattice(N, 1.);
+        const Basis basis(lattice);
+
+        Matrix matrix;
+        models::hubbard_real_space::init_matrix_parallel(liouvillian, matrix, basis, lattice);
+        const types::SlicedEllpackMatrix<double> sliced_ellpack(matrix);
+        const types::SlicedEllpackMatrix<double, uint32_t, 3> sliced_ellpack_3(matrix, 7);
+
+        REQUIRE(sliced_ellpack.rows() == matrix.rows());
+        REQUIRE(sliced_ellpack.stored_elements() >= matrix.non_zeros());
+
+        Vector x(basis.size()), y(basis.size()), y_8(basis.size()), y_3(basis.size());
+        for(std::size_t i = 0; i < basis.size(); ++i) {
+            x[i] = std::complex<double>(std::cos(0.3 * i), std::sin(0.7 * i));
+        }
+
+        matrix.multiply(x, y);
+        sliced_ellpack.multiply(x, y_8);
+        sliced_ellpack_3.multiply(x, y_3);
+
+        for(std::size_t i = 0; i < basis.size(); ++i) {
+            REQUIRE(y_8[i].real() == Approx(y[i].real()));
+            REQUIRE(y_8[i].imag() == Approx(y[i].imag()));
+            REQUIRE(y_3[i].real() == Approx(y[i].real()));
+            REQUIRE(y_3[i].imag() == Approx(y[i].imag()));
+        }
+    }
+}
+
+TEST_CASE("value dictionary matrix")
+{
+    const auto liouvillian = models::hubbard_real_space::make_liouvillian(1.3, 0.7);
+    for(uint64_t N = 3; N <= 8; ++N) {
+        const lattices::PeriodicChain<double, uint64_t> lattice(N, 1.);
+        const Basis basis(lattice);
+
+        Matrix matrix;
+        models::hubbard_real_space::init_matrix_parallel(liouvillian, matrix, basis, lattice);
+        const types::ValueDictionaryMatrix<double> value_dictionary(matrix);
+
+        REQUIRE(value_dictionary.table().size() == 3);
+        REQUIRE(value_dictionary.non_zeros() == matrix.non_zeros());
+
+        Vector x(basis.size()), y(basis.size()), y_dictionary(basis.size());
+        for(std::size_t i = 0; i < basis.size(); ++i) {
+            x[i] = std::complex<double>(std::cos(0.3 * i), std::sin(0.7 * i));
+        }
+
+        matrix.multiply(x, y);
+        value_dictionary.multiply(x, y_dictionary);
+
+        for(std::size_t i = 0; i < basis.size(); ++i) {
+            REQUIRE(y_dictionary[i].real() == Approx(y[i].real()));
+            REQUIRE(y_dictionary[i].imag() == Approx(y[i].imag()));
+        }
+    }
+}
+
+TEST_CASE("symbolic and numeric init_matrix_no")
+{
+    const auto liouvillian = models::hubbard_real_space::make_liouvillian(1.3, 0.7);
+    for(uint64_t N = 3; N <= 8; ++N) {
+        const lattices::PeriodicChain<double, uint64_t> lattice(N, 1.);
+        const Basis basis(lattice);
+        const auto symbolic =
+            models::hubbard_real_space::init_symbolic_matrix_no<double>(basis, lattice);
+
+        for(const auto filling_factor : {0.5, 0.3}) {
+            const models::hubbard_real_space::ExpectationValue1DHalfFilled<double,
+                                                                           decltype(lattice)>
+                ev(lattice, filling_factor, 0.5 * filling_factor);
+
+            Matrix reference, numeric;
+            models::hubbard_real_space::init_matrix_no(liouvillian, reference, basis, lattice, ev);
+            models::hubbard_real_space::init_numeric_matrix_no(symbolic, liouvillian, numeric, ev);
+
+            // the symbolic pattern may contain explicit zeros that init_matrix_no drops
+            require_equal_up_to_zeros(numeric, reference);
+        }
+    }
+}
+
+TEST_CASE("basis reordering")
+{
+    const auto liouvillian = models::hubbard_real_space::make_liouvillian(1.3, 0.7);
+    for(uint64_t N = 3; N <= 8; ++N) {
+        const lattices::PeriodicChain<double, uint64_t> lattice(N, 1.);
+        const Basis basis(lattice);
+
+        Matrix matrix;
+        models::hubbard_real_space::init_matrix_parallel(liouvillian, matrix, basis, lattice);
+
+        Vector x(basis.size()), y(basis.size());
+        for(std::size_t i = 0; i < basis.size(); ++i) {
+            x[i] = std::complex<double>(std::cos(0.3 * i), std::sin(0.7 * i));
+        }
+        matrix.multiply(x, y);
+
+        const auto rcm     = types::reverse_cuthill_mckee(matrix);
+        const auto blocked = models::hubbard_real_space::blocked_basis_ordering(basis, 2);
+
+        const auto check = [&](const auto& permutation) {
+            REQUIRE(permutation.size() == basis.size());
+            for(std::size_t i = 0; i < basis.size(); ++i) {
+                REQUIRE(permutation.new_index(permutation.old_index(i)) == i);
+            }
+
+            const auto permuted = types::permute(matrix, permutation);
+            REQUIRE(permuted.non_zeros() == matrix.non_zeros());
+
+            const Vector x_permuted = permutation.apply(x);
+            for(std::size_t i = 0; i < basis.size(); ++i) {
+                REQUIRE(x_permuted[permutation.new_index(i)] == x[i]);
+            }
+
+            Vector y_permuted(basis.size());
+            permuted.multiply(x_permuted, y_permuted);
+            const Vector y_restored = permutation.restore(y_permuted);
+            for(std::size_t i = 0; i < basis.size(); ++i) {
+                REQUIRE(y_restored[i].real() == Approx(y[i].real()));
+                REQUIRE(y_restored[i].imag() == Approx(y[i].imag()));
+            }
+        };
+        check(rcm);
+        check(blocked);
+
+        REQUIRE(types::bandwidth(types::permute(matrix, rcm)) <= types::bandwidth(matrix));
+    }
+}
+
+TEST_CASE("matrix powers")
+{
+    const auto liouvillian = models::hubbard_real_space::make_liouvillian(1.3, 0.7);
+    for(uint64_t N = 3; N <= 8; ++N) {
+        const lattices::PeriodicChain<double, uint64_t> lattice(N, 1.);
+        const Basis basis(lattice);
+
+        Matrix matrix;
+        models::hubbard_real_space::init_matrix_parallel(liouvillian, matrix, basis, lattice);
+        matrix = types::permute(matrix, types::reverse_cuthill_mckee(matrix));
+
+        Vector x(basis.size());
+        for(std::size_t i = 0; i < basis.size(); ++i) {
+            x[i] = std::complex<double>(std::cos(0.3 * i), std::sin(0.7 * i));
+        }
+
+        for(const uint32_t block_rows : {1u, 7u, 1024u}) {
+            const types::MatrixPowers<double> matrix_powers(matrix, block_rows);
+
+            std::array<Vector, 4> powers;
+            matrix_powers.powers(x, powers);
+
+            Vector expected = x, y(basis.size());
+            for(const auto& power : powers) {
+                matrix.multiply(expected, y);
+                expected = y;
+                for(std::size_t i = 0; i < basis.size(); ++i) {
+                    REQUIRE(power[i].real() == Approx(expected[i].real()));
+                    REQUIRE(power[i].imag() == Approx(expected[i].imag()));
+                }
+            }
+
+            const ode::RK4<double> rk4(basis.size(), 0.01);
+            ode::MatrixPowersRK4<double> powers_rk4(basis.size(), 0.01);
+            Vector u_stages = x, u_powers = x;
+            rk4.step_imaginary(matrix, u_stages);
+            powers_rk4.step_imaginary(matrix_powers, u_powers);
+            for(std::size_t i = 0; i < basis.size(); ++i) {
+                REQUIRE(u_powers[i].real() == Approx(u_stages[i].real()));
+                REQUIRE(u_powers[i].imag() == Approx(u_stages[i].imag()));
+            }
+        }
+    }
+}
+
+TEST_CASE("implicit basis")
+{
+    using ImplicitBasis = models::hubbard_real_space::ImplicitBasis3Operator<Operator>;
+
+    const auto liouvillian = models::hubbard_real_space::make_liouvillian(1.3, 0.7);
+    for(uint64_t N = 3; N <= 8; ++N) {
+        const lattices::PeriodicChain<double, uint64_t> lattice(N, 1.);
+        const Basis basis(lattice);
+        const ImplicitBasis implicit_basis(lattice);
+        const models::hubbard_real_space::ExpectationValue1DHalfFilled<double, decltype(lattice)>
+            ev(lattice, 0.5, 0.25);
+
+        Matrix matrix, implicit_matrix;
+        models::hubbard_real_space::init_matrix_parallel(liouvillian, matrix, basis, lattice);
+        models::hubbard_real_space::init_matrix_parallel(liouvillian, implicit_matrix,
+                                                         implicit_basis, lattice);
+        REQUIRE(implicit_matrix.row_pointers() == matrix.row_pointers());
+        REQUIRE(implicit_matrix.column_indices() == matrix.column_indices());
+        REQUIRE(implicit_matrix.values() == matrix.values());
+
+        models::hubbard_real_space::init_matrix_no(liouvillian, matrix, basis, lattice, ev);
+        models::hubbard_real_space::init_matrix_no(liouvillian, implicit_matrix, implicit_basis,
+                                                   lattice, ev);
+        REQUIRE(implicit_matrix.row_pointers() == matrix.row_pointers());
+        REQUIRE(implicit_matrix.column_indices() == matrix.column_indices());
+        REQUIRE(implicit_matrix.values() == matrix.values());
+    }
+}
@@ -1,12 +1,19 @@
 #define CATCH_CONFIG_MAIN
 #include <catch.hpp>
 
+#include <cmath>
+#include <complex>
+#include <vector>
+
 #include <ieompp/algebra/monomial.hpp>
 #include <ieompp/algebra/operator.hpp>
 #include <ieompp/lattices/periodic_chain.hpp>
+#include <ieompp/models/hubbard/conjugate_basis.hpp>
 #include <ieompp/models/hubbard_real_space/basis.hpp>
 #include <ieompp/models/hubbard_real_space/expectation_value.hpp>
+#include <ieompp/models/hubbard_real_space/implicit_basis.hpp>
 #include <ieompp/models/hubbard_real_space/site_occupation.hpp>
+#include <ieompp/types/permutation.hpp>
 using namespace ieompp;
 
 using Operator = algebra::Operator<uint64_t, bool>;
@@ -57,3 +64,105 @@ TEST_CASE("")
             == Approx(4 * ev(0, 3) * ev(1, 2)));
     // clang-format on
 }
+
+TEST_CASE("implicit basis")
+{
+    using ImplicitBasis = models::hubbard_real_space::ImplicitBasis3Operator<Operator>;
+
+    const uint64_t N = 5;
+    const lattices::PeriodicChain<double, uint64_t> lattice(N, 1.);
+    const models::hubbard_real_space::ExpectationValue1DHalfFilled<double, decltype(lattice)> ev(
+        lattice, 1., 0.5);
+    const auto ev_function = [&ev](const Operator& a, const Operator& b) {
+        return ev(a.index1, b.index1);
+    };
+
+    const Basis basis(lattice);
+    const auto conjugate_basis = basis.get_conjugate();
+    const ImplicitBasis implicit_basis(lattice);
+    const auto implicit_conjugate_basis = implicit_basis.get_conjugate();
+
+    const auto site_occupation = models::hubbard_real_space::SiteOccupation<double, Basis>{
+        ev_function, std::cref(basis), std::cref(conjugate_basis)};
+    const auto implicit_site_occupation =
+        models::hubbard_real_space::SiteOccupation<double, ImplicitBasis>{
+            ev_function, std::cref(implicit_basis), std::cref(implicit_conjugate_basis)};
+
+    std::vector<std::complex<double>> h(basis.size());
+    for(std::size_t i = 0; i < basis.size(); ++i) {
+        h[i] = std::complex<double>(std::cos(0.3 * i), std::sin(0.7 * i));
+    }
+
+    REQUIRE(implicit_site_occupation(h) == Approx(site_occupation(h)));
+}
+
+TEST_CASE("conjugate basis view")
+{
+    using ConjugateBasis = models::hubbard::ConjugateBasis<Basis>;
+
+    const uint64_t N = 5;
+    const lattices::PeriodicChain<double, uint64_t> lattice(N, 1.);
+    const models::hubbard_real_space::ExpectationValue1DHalfFilled<double, decltype(lattice)> ev(
+        lattice, 1., 0.5);
+    const auto ev_function = [&ev](const Operator& a, const Operator& b) {
+        return ev(a.index1, b.index1);
+    };
+
+    const Basis basis(lattice);
+    const auto conjugate_basis      = basis.get_conjugate();
+    const auto conjugate_basis_view = models::hubbard::make_conjugate_basis(basis);
+
+    REQUIRE(conjugate_basis_view.size() == conjugate_basis.size());
+    for(std::size_t i = 0; i < basis.size(); ++i) {
+        REQUIRE(conjugate_basis_view[i] == conjugate_basis[i]);
+    }
+    REQUIRE(conjugate_basis_view.get_3op_index(1, 2, 3) == conjugate_basis.get_3op_index(1, 2, 3));
+    REQUIRE(&conjugate_basis_view.get_conjugate() == &basis);
+
+    const auto site_occupation = models::hubbard_real_space::SiteOccupation<double, Basis>{
+        ev_function, std::cref(basis), std::cref(conjugate_basis)};
+    const auto view_site_occupation =
+        models::hubbard_real_space::SiteOccupation<double, Basis, ConjugateBasis>{
+            ev_function, std::cref(basis), std::cref(conjugate_basis_view)};
+
+    std::vector<std::complex<double>> h(basis.size());
+    for(std::size_t i = 0; i < basis.size(); ++i) {
+        h[i] = std::complex<double>(std::sin(0.4 * i), std::cos(0.9 * i));
+    }
+
+    REQUIRE(view_site_occupation(h) == Approx(site_occupation(h)));
+}
+
+TEST_CASE("permuted vector")
+{
+    const uint64_t N = 5;
+    const lattices::PeriodicChain<double, uint64_t> lattice(N, 1.);
+    const models::hubbard_real_space::ExpectationValue1DHalfFilled<double, decltype(lattice)> ev(
+        lattice, 1., 0.5);
+    const auto ev_function = [&ev](const Operator& a, const Operator& b) {
+        return ev(a.index1, b.index1);
+    };
+
+    const Basis basis(lattice);
+    const auto conjugate_basis = basis.get_conjugate();
+
+    const auto site_occupation = models::hubbard_real_space::SiteOccupation<double, Basis>{
+        ev_function, std::cref(basis), std::cref(conjugate_basis)};
+    auto permuted_site_occupation = site_occupation;
+
+    // new index i is the old index (7 * i) % size, 7 is coprime to the basis size 130
+    std::vector<uint64_t> new_to_old(basis.size());
+    for(std::size_t i = 0; i < basis.size(); ++i) {
+        new_to_old[i] = (7 * i) % basis.size();
+    }
+    const types::Permutation<uint64_t> permutation(std::move(new_to_old));
+    permuted_site_occupation.permute(permutation);
+
+    std::vector<std::complex<double>> h(basis.size());
+    for(std::size_t i = 0; i < basis.size(); ++i) {
+        h[i] = std::complex<double>(std::cos(0.3 * i), std::sin(0.7 * i));
+    }
+    const auto permuted_h = permutation.apply(h);
+
+    REQUIRE(permuted_site_occupation(permuted_h) == Approx(site_occupation(h)));
+}
@@ -0,0 +1,202 @@
+#define CATCH_CONFIG_MAIN
+#include <catch.hpp>
+
+#include <cmath>
+#include <complex>
+#include <vector>
+
+#include <ieompp/algebra/operator.hpp>
+#include <ieompp/lattices/periodic_chain.hpp>
+#include <ieompp/lattices/periodic_square_lattice.hpp>
+#include <ieompp/models/hubbard/dispersion.hpp>
+#include <ieompp/models/hubbard_real_space/blaze_sparse.hpp>
+#include <ieompp/models/hubbard_real_space/expectation_value.hpp>
+#include <ieompp/models/hubbard_real_space/fermi_jump.hpp>
+#include <ieompp/models/hubbard_real_space/implicit_basis.hpp>
+#include <ieompp/models/hubbard_real_space/liouvillian.hpp>
+#include <ieompp/models/hubbard_real_space/site_occupation.hpp>
+#include <ieompp/models/hubbard_real_space/symmetric_basis.hpp>
+#include <ieompp/types/blaze.hpp>
+#include <ieompp/types/compressed_row_matrix.hpp>
+using namespace ieompp;
+
+using Operator       = algebra::Operator<uint64_t, bool>;
+using Basis          = models::hubbard_real_space::ImplicitBasis3Operator<Operator>;
+using SymmetricBasis = models::hubbard_real_space::SymmetricBasis3Operator<Operator>;
+using Matrix         = types::CompressedRowMatrix<double>;
+using Vector         = blaze::DynamicVector<std::complex<double>>;
+
+namespace
+{
+    // symmetric vector of the sector with arbitrary coefficients
+    Vector make_vector(std::size_t size)
+    {
+        Vector x(size);
+        for(std::size_t i = 0; i < size; ++i) {
+            x[i] = std::complex<double>(std::cos(0.3 * i), std::sin(0.7 * i));
+        }
+        return x;
+    }
+
+    // M h for a symmetric h equals the expansion of M_G v
+    template <typename Lattice>
+    void test_matrix(const Lattice& lattice)
+    {
+        const auto liouvillian = models::hubbard_real_space::make_liouvillian(1.3, 0.7);
+        const Basis basis(lattice);
+        const SymmetricBasis symmetric_basis(lattice);
+
+        Matrix matrix, symmetric_matrix;
+        models::hubbard_real_space::init_matrix_parallel(liouvillian, matrix, basis, lattice);
+        models::hubbard_real_space::init_matrix_parallel(liouvillian, symmetric_matrix,
+                                                         symmetric_basis, lattice);
+        REQUIRE(symmetric_matrix.rows() == symmetric_basis.size());
+
+        const auto v = make_vector(symmetric_basis.size());
+        Vector h, y(basis.size()), w(symmetric_basis.size()), y_restored;
+        models::hubbard_real_space::symmetric_to_real_space(symmetric_basis, v, h);
+        matrix.multiply(h, y);
+        symmetric_matrix.multiply(v, w);
+        models::hubbard_real_space::symmetric_to_real_space(symmetric_basis, w, y_restored);
+
+        for(std::size_t i = 0; i < basis.size(); ++i) {
+            REQUIRE(std::abs(y_restored[i] - y[i]) < 1e-10);
+        }
+
+        // the sector matrix is symmetric: <v, M_G w> = <M_G v, w> for real v, w
+        Vector a(symmetric_basis.size()), b(symmetric_basis.size());
+        Vector Ma(symmetric_basis.size()), Mb(symmetric_basis.size());
+        for(std::size_t i = 0; i < symmetric_basis.size(); ++i) {
+            a[i] = std::cos(0.3 * i);
+            b[i] = std::sin(0.7 * i);
+        }
+        symmetric_matrix.multiply(a, Ma);
+        symmetric_matrix.multiply(b, Mb);
+        std::complex<double> aMb = 0., Mab = 0.;
+        for(std::size_t i = 0; i < symmetric_basis.size(); ++i) {
+            aMb += a[i] * Mb[i];
+            Mab += Ma[i] * b[i];
+        }
+        REQUIRE(aMb.real() == Approx(Mab.real()));
+    }
+} // namespace
+
+TEST_CASE("orbits")
+{
+    for(uint64_t N = 2; N <= 8; ++N) {
+        const lattices::PeriodicChain<double, uint64_t> lattice(N, 1.);
+        const SymmetricBasis basis(lattice);
+        const auto& real_space_basis = basis.real_space_basis;
+
+        REQUIRE(basis.group().size() == ((N <= 2) ? 1 : 2));
+        REQUIRE(basis.representative(0) == 0);
+        REQUIRE(basis.orbit_size(0) == 1);
+
+        uint64_t orbit_sizes = 0;
+        for(uint64_t i = 0; i < basis.size(); ++i) {
+            REQUIRE(basis.reduce(basis.representative(i)) == i);
+            orbit_sizes += basis.orbit_size(i);
+        }
+        REQUIRE(orbit_sizes == real_space_basis.size());
+
+        for(uint64_t i = 0; i < real_space_basis.size(); ++i) {
+            const auto inverted = basis.transform(basis.group().back(), i);
+            REQUIRE(basis.reduce(inverted) == basis.reduce(i));
+        }
+    }
+
+    const lattices::PeriodicChain<double, uint64_t> lattice(4, 1.);
+    std::vector<std::vector<uint64_t>> shift{{1, 2, 3, 0}};
+    REQUIRE_THROWS(SymmetricBasis(lattice, shift));
+    std::vector<std::vector<uint64_t>> swap{{0, 2, 1, 3}};
+    REQUIRE_THROWS(SymmetricBasis(lattice, swap));
+}
+
+TEST_CASE("symmetric to real space")
+{
+    const lattices::PeriodicChain<double, uint64_t> lattice(6, 1.);
+    const SymmetricBasis basis(lattice);
+
+    const auto v = make_vector(basis.size());
+    Vector h, restored;
+    models::hubbard_real_space::symmetric_to_real_space(basis, v, h);
+    models::hubbard_real_space::real_space_to_symmetric(basis, h, restored);
+
+    double norm_h = 0., norm_v = 0.;
+    for(std::size_t i = 0; i < h.size(); ++i) {
+        norm_h += std::norm(h[i]);
+    }
+    for(std::size_t i = 0; i < v.size(); ++i) {
+        norm_v += std::norm(v[i]);
+        REQUIRE(restored[i].real() == Approx(v[i].real()));
+        REQUIRE(restored[i].imag() == Approx(v[i].imag()));
+    }
+    REQUIRE(norm_h == Approx(norm_v));
+}
+
+TEST_CASE("symmetric matrices")
+{
+    for(uint64_t N = 3; N <= 8; ++N) {
+        test_matrix(lattices::PeriodicChain<double, uint64_t>(N, 1.));
+    }
+    test_matrix(lattices::PeriodicSquareLattice<double, uint64_t>(3, 3));
+    test_matrix(lattices::PeriodicSquareLattice<double, uint64_t>(4, 4));
+}
+
+TEST_CASE("site occupation and fermi jump (1d)")
+{
+    const uint64_t N = 8;
+    const lattices::PeriodicChain<double, uint64_t> lattice(N, 1.);
+    const auto k_F = models::hubbard::calculate_fermi_momentum_1d(0.5);
+    const models::hubbard_real_space::ExpectationValue1DHalfFilled<double, decltype(lattice)> ev(
+        lattice, 0.5, k_F);
+    const auto ev_function = [&ev](const Operator& a, const Operator& b) {
+        return ev(a.index1, b.index1);
+    };
+
+    const Basis basis(lattice);
+    const auto conjugate_basis = basis.get_conjugate();
+    const SymmetricBasis symmetric_basis(lattice);
+
+    const auto v = make_vector(symmetric_basis.size());
+    Vector h;
+    models::hubbard_real_space::symmetric_to_real_space(symmetric_basis, v, h);
+
+    const auto site_occupation = models::hubbard_real_space::SiteOccupation<double, Basis>{
+        ev_function, std::cref(basis), std::cref(conjugate_basis)};
+    const auto symmetric_site_occupation =
+        models::hubbard_real_space::SiteOccupation<double, SymmetricBasis>{
+            ev_function, std::cref(symmetric_basis)};
+    REQUIRE(symmetric_site_occupation(v) == Approx(site_occupation(h)));
+
+    const models::hubbard_real_space::FermiJump1D<double, Basis> jump(basis, lattice, ev_function,
+                                                                      k_F);
+    const models::hubbard_real_space::FermiJump1D<double, SymmetricBasis> symmetric_jump(
+        symmetric_basis, lattice, ev_function, k_F);
+    REQUIRE(symmetric_jump(v) == Approx(jump(h)));
+}
+
+TEST_CASE("fermi jump (2d)")
+{
+    const lattices::PeriodicSquareLattice<double, uint64_t> lattice(4, 4);
+    const models::hubbard_real_space::ExpectationValue2DHalfFilled<double, decltype(lattice)> ev(
+        lattice);
+    const auto ev_function = [&ev](const Operator& a, const Operator& b) {
+        return ev(a.index1, b.index1);
+    };
+    const typename decltype(lattice)::Vector k_F{HalfPi<double>::value, HalfPi<double>::value};
+
+    const Basis basis(lattice);
+    const SymmetricBasis symmetric_basis(lattice);
+    REQUIRE(symmetric_basis.group().size() == 8);
+
+    const auto v = make_vector(symmetric_basis.size());
+    Vector h;
+    models::hubbard_real_space::symmetric_to_real_space(symmetric_basis, v, h);
+
+    const models::hubbard_real_space::FermiJump2D<double, Basis> jump(basis, lattice, ev_function,
+                                                                      k_F);
+    const models::hubbard_real_space::FermiJump2D<double, SymmetricBasis> symmetric_jump(
+        symmetric_basis, lattice, ev_function, k_F);
+    REQUIRE(symmetric_jump(v) == Approx(jump(h)));
+}
@@ -0,0 +1,176 @@
+#define CATCH_CONFIG_MAIN
+#include <catch.hpp>
+
+#include <cmath>
+#include <complex>
+#include <vector>
+
+#include <ieompp/algebra/operator.hpp>
+#include <ieompp/lattices/periodic_chain.hpp>
+#include <ieompp/models/hubbard/dispersion.hpp>
+#include <ieompp/models/hubbard_real_space/blaze_sparse.hpp>
+#include <ieompp/models/hubbard_real_space/expectation_value.hpp>
+#include <ieompp/models/hubbard_real_space/fermi_jump.hpp>
+#include <ieompp/models/hubbard_real_space/implicit_basis.hpp>
+#include <ieompp/models/hubbard_real_space/liouvillian.hpp>
+#include <ieompp/models/hubbard_real_space/site_occupation.hpp>
+#include <ieompp/models/hubbard_real_space/translation_basis.hpp>
+#include <ieompp/types/blaze.hpp>
+#include <ieompp/types/compressed_row_matrix.hpp>
+using namespace ieompp;
+
+using Operator         = algebra::Operator<uint64_t, bool>;
+using Basis            = models::hubbard_real_space::ImplicitBasis3Operator<Operator>;
+using TranslationBasis = models::hubbard_real_space::TranslationBasis3Operator<Operator>;
+using Vector           = blaze::DynamicVector<std::complex<double>>;
+
+namespace
+{
+    Vector make_vector(std::size_t size)
+    {
+        Vector x(size);
+        for(std::size_t i = 0; i < size; ++i) {
+            x[i] = std::complex<double>(std::cos(0.3 * i), std::sin(0.7 * i));
+        }
+        return x;
+    }
+} // namespace
+
+TEST_CASE("reduce")
+{
+    for(uint64_t N = 2; N <= 6; ++N) {
+        const lattices::PeriodicChain<double, uint64_t> lattice(N, 1.);
+        const TranslationBasis basis(0, lattice);
+        const auto& real_space_basis = basis.real_space_basis;
+
+        REQUIRE(basis.size() == N * N + 1);
+
+        for(uint64_t i = 0; i < real_space_basis.size(); ++i) {
+            const auto reduced = basis.reduce(i);
+            REQUIRE(reduced.first < basis.size());
+            REQUIRE(reduced.second < N);
+            REQUIRE(basis.real_space_index(reduced.second, reduced.first) == i);
+        }
+
+        for(uint64_t index = 0; index < basis.size(); ++index) {
+            const auto monomial = basis[index];
+            REQUIRE(monomial[0].index1 == 0);
+            for(uint64_t shift = 0; shift < N; ++shift) {
+                const auto shifted = real_space_basis[basis.real_space_index(shift, index)];
+                REQUIRE(shifted.size() == monomial.size());
+                for(std::size_t k = 0; k < monomial.size(); ++k) {
+                    REQUIRE(shifted[k].index1 == (monomial[k].index1 + shift) % N);
+                    REQUIRE(shifted[k].index2 == monomial[k].index2);
+                }
+            }
+        }
+    }
+}
+
+TEST_CASE("sectors to real space")
+{
+    const uint64_t N = 5;
+    const lattices::PeriodicChain<double, uint64_t> lattice(N, 1.);
+    const TranslationBasis basis(0, lattice);
+
+    const auto h = make_vector(basis.real_space_basis.size());
+    std::vector<Vector> sectors;
+    Vector restored;
+    models::hubbard_real_space::real_space_to_translation_sectors(basis, h, sectors);
+    models::hubbard_real_space::translation_sectors_to_real_space(basis, sectors, restored);
+
+    REQUIRE(sectors.size() == N);
+    REQUIRE(restored.size() == h.size());
+    for(std::size_t i = 0; i < h.size(); ++i) {
+        REQUIRE(restored[i].real() == Approx(h[i].real()));
+        REQUIRE(restored[i].imag() == Approx(h[i].imag()));
+    }
+}
+
+TEST_CASE("sector matrices")
+{
+    const auto liouvillian = models::hubbard_real_space::make_liouvillian(1.3, 0.7);
+    for(uint64_t N = 3; N <= 6; ++N) {
+        const lattices::PeriodicChain<double, uint64_t> lattice(N, 1.);
+        const Basis basis(lattice);
+
+        types::CompressedRowMatrix<double> matrix;
+        models::hubbard_real_space::init_matrix_parallel(liouvillian, matrix, basis, lattice);
+
+        const auto x = make_vector(basis.size());
+        Vector y(basis.size());
+        matrix.multiply(x, y);
+
+        // apply the sector matrices to the sectors of x and transform the result back
+        std::vector<TranslationBasis> sector_bases;
+        std::vector<Vector> x_sectors, y_sectors(N);
+        for(uint64_t k = 0; k < N; ++k) {
+            sector_bases.emplace_back(k, lattice);
+        }
+        models::hubbard_real_space::real_space_to_translation_sectors(sector_bases[0], x,
+                                                                       x_sectors);
+        for(uint64_t k = 0; k < N; ++k) {
+            types::CompressedRowMatrix<std::complex<double>> sector_matrix;
+            models::hubbard_real_space::init_matrix_parallel(liouvillian, sector_matrix,
+                                                             sector_bases[k], lattice);
+            REQUIRE(sector_matrix.rows() == N * N + 1);
+
+            y_sectors[k].resize(sector_matrix.rows());
+            sector_matrix.multiply(x_sectors[k], y_sectors[k]);
+        }
+        Vector y_restored;
+        models::hubbard_real_space::translation_sectors_to_real_space(sector_bases[0], y_sectors,
+                                                                       y_restored);
+
+        for(std::size_t i = 0; i < basis.size(); ++i) {
+            REQUIRE(y_restored[i].real() == Approx(y[i].real()));
+            REQUIRE(std::abs(y_restored[i].imag() - y[i].imag()) < 1e-10);
+        }
+    }
+}
+
+TEST_CASE("site occupation and fermi jump")
+{
+    const uint64_t N = 8;
+    const lattices::PeriodicChain<double, uint64_t> lattice(N, 1.);
+    const auto k_F = models::hubbard::calculate_fermi_momentum_1d(0.5);
+    const models::hubbard_real_space::ExpectationValue1DHalfFilled<double, decltype(lattice)> ev(
+        lattice, 0.5, k_F);
+    const auto ev_function = [&ev](const Operator& a, const Operator& b) {
+        return ev(a.index1, b.index1);
+    };
+
+    const Basis basis(lattice);
+    const auto conjugate_basis = basis.get_conjugate();
+    const auto h               = make_vector(basis.size());
+
+    std::vector<TranslationBasis> sector_bases;
+    for(uint64_t k = 0; k < N; ++k) {
+        sector_bases.emplace_back(k, lattice);
+    }
+    std::vector<Vector> sectors;
+    models::hubbard_real_space::real_space_to_translation_sectors(sector_bases[0], h, sectors);
+
+    const auto site_occupation = models::hubbard_real_space::SiteOccupation<double, Basis>{
+        ev_function, std::cref(basis), std::cref(conjugate_basis)};
+    double sector_sum = 0.;
+    for(uint64_t k = 0; k < N; ++k) {
+        const auto sector_site_occupation =
+            models::hubbard_real_space::SiteOccupation<double, TranslationBasis>{
+                ev_function, std::cref(sector_bases[k])};
+        sector_sum += sector_site_occupation(sectors[k]);
+    }
+    REQUIRE(sector_sum == Approx(site_occupation(h)));
+
+    const auto k_F_index = models::hubbard_real_space::translation_momentum_index(lattice, k_F);
+    REQUIRE(k_F_index == N / 4);
+
+    const models::hubbard_real_space::FermiJump1D<double, Basis> jump(basis, lattice, ev_function,
+                                                                      k_F);
+    const models::hubbard_real_space::FermiJump1D<double, TranslationBasis> sector_jump(
+        sector_bases[k_F_index], lattice, ev_function, k_F);
+    REQUIRE(sector_jump(sectors[k_F_index]) == Approx(jump(h)));
+
+    REQUIRE_THROWS(models::hubbard_real_space::FermiJump1D<double, TranslationBasis>(
+        sector_bases[0], lattice, ev_function, k_F));
+}
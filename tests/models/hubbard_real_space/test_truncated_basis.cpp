@@ -0,0 +1,191 @@
+#define CATCH_CONFIG_MAIN
+#include <catch.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+
+#include <ieompp/algebra/operator.hpp>
+#include <ieompp/lattices/periodic_chain.hpp>
+#include <ieompp/lattices/periodic_square_lattice.hpp>
+#include <ieompp/models/hubbard/dispersion.hpp>
+#include <ieompp/models/hubbard_real_space/blaze_sparse.hpp>
+#include <ieompp/models/hubbard_real_space/expectation_value.hpp>
+#include <ieompp/models/hubbard_real_space/fermi_jump.hpp>
+#include <ieompp/models/hubbard_real_space/implicit_basis.hpp>
+#include <ieompp/models/hubbard_real_space/liouvillian.hpp>
+#include <ieompp/models/hubbard_real_space/site_occupation.hpp>
+#include <ieompp/models/hubbard_real_space/truncated_basis.hpp>
+#include <ieompp/types/blaze.hpp>
+#include <ieompp/types/compressed_row_matrix.hpp>
+using namespace ieompp;
+
+using Operator       = algebra::Operator<uint64_t, bool>;
+using Basis          = models::hubbard_real_space::ImplicitBasis3Operator<Operator>;
+using TruncatedBasis = models::hubbard_real_space::TruncatedBasis3Operator<Operator>;
+using Matrix         = types::CompressedRowMatrix<double>;
+using Vector         = blaze::DynamicVector<std::complex<double>>;
+
+namespace
+{
+    Vector make_vector(std::size_t size)
+    {
+        Vector x(size);
+        for(std::size_t i = 0; i < size; ++i) {
+            x[i] = std::complex<double>(std::cos(0.3 * i), std::sin(0.7 * i));
+        }
+        return x;
+    }
+
+    template <typename Lattice>
+    void test_elements(const Lattice& lattice, uint64_t cutoff)
+    {
+        const TruncatedBasis basis(lattice, cutoff);
+        const auto& real_space_basis = basis.real_space_basis;
+
+        // all local monomials are contained in the order of the real-space basis
+        uint64_t index = 0;
+        for(uint64_t i = 0; i < real_space_basis.size(); ++i) {
+            const auto monomial = real_space_basis[i];
+            bool local          = true;
+            if(monomial.size() == 3) {
+                local = (lattice.lattice_distance(monomial[0].index1, monomial[1].index1) <= cutoff)
+                        && (lattice.lattice_distance(monomial[0].index1, monomial[2].index1)
+                            <= cutoff)
+                        && (lattice.lattice_distance(monomial[1].index1, monomial[2].index1)
+                            <= cutoff);
+            }
+
+            if(local) {
+                REQUIRE(basis.real_space_index(index) == i);
+                REQUIRE(basis.find(i) == index);
+                ++index;
+            } else {
+                REQUIRE(basis.find(i) == basis.size());
+            }
+        }
+        REQUIRE(index == basis.size());
+
+        for(uint64_t site = 0; site < basis.N; ++site) {
+            const auto range = basis.three_operator_range(site);
+            for(auto i = range.first; i < range.second; ++i) {
+                REQUIRE(basis[i][0].index1 == site);
+            }
+        }
+    }
+
+    // the truncated matrix is the principal submatrix of the real-space matrix
+    template <typename Lattice>
+    void test_matrix(const Lattice& lattice, uint64_t cutoff)
+    {
+        const auto liouvillian = models::hubbard_real_space::make_liouvillian(1.3, 0.7);
+        const Basis basis(lattice);
+        const TruncatedBasis truncated_basis(lattice, cutoff);
+
+        Matrix matrix, truncated_matrix;
+        models::hubbard_real_space::init_matrix_parallel(liouvillian, matrix, basis, lattice);
+        models::hubbard_real_space::init_matrix_parallel(liouvillian, truncated_matrix,
+                                                         truncated_basis, lattice);
+        REQUIRE(truncated_matrix.rows() == truncated_basis.size());
+
+        const auto v = make_vector(truncated_basis.size());
+        Vector h, y(basis.size()), w(truncated_basis.size());
+        models::hubbard_real_space::truncated_to_real_space(truncated_basis, v, h);
+        matrix.multiply(h, y);
+        truncated_matrix.multiply(v, w);
+
+        for(std::size_t i = 0; i < truncated_basis.size(); ++i) {
+            REQUIRE(std::abs(w[i] - y[truncated_basis.real_space_index(i)]) < 1e-10);
+        }
+    }
+} // namespace
+
+TEST_CASE("elements")
+{
+    for(uint64_t N = 2; N <= 7; ++N) {
+        const lattices::PeriodicChain<double, uint64_t> lattice(N, 1.);
+        for(uint64_t cutoff = 0; cutoff <= N / 2; ++cutoff) {
+            test_elements(lattice, cutoff);
+        }
+        REQUIRE(TruncatedBasis(lattice, N / 2).size() == Basis(lattice).size());
+    }
+
+    const lattices::PeriodicSquareLattice<double, uint64_t> lattice(4, 4);
+    for(uint64_t cutoff = 0; cutoff <= 4; ++cutoff) {
+        test_elements(lattice, cutoff);
+    }
+    REQUIRE(TruncatedBasis(lattice, 4).size() == Basis(lattice).size());
+}
+
+TEST_CASE("truncated matrices")
+{
+    const lattices::PeriodicChain<double, uint64_t> chain(8, 1.);
+    for(uint64_t cutoff = 0; cutoff <= 4; ++cutoff) {
+        test_matrix(chain, cutoff);
+    }
+
+    const lattices::PeriodicSquareLattice<double, uint64_t> square(4, 4);
+    for(uint64_t cutoff = 0; cutoff <= 4; ++cutoff) {
+        test_matrix(square, cutoff);
+    }
+}
+
+TEST_CASE("site occupation and fermi jump (1d)")
+{
+    const lattices::PeriodicChain<double, uint64_t> lattice(8, 1.);
+    const auto k_F = models::hubbard::calculate_fermi_momentum_1d(0.5);
+    const models::hubbard_real_space::ExpectationValue1DHalfFilled<double, decltype(lattice)> ev(
+        lattice, 0.5, k_F);
+    const auto ev_function = [&ev](const Operator& a, const Operator& b) {
+        return ev(a.index1, b.index1);
+    };
+
+    const Basis basis(lattice);
+    const auto conjugate_basis = basis.get_conjugate();
+    const auto site_occupation = models::hubbard_real_space::SiteOccupation<double, Basis>{
+        ev_function, std::cref(basis), std::cref(conjugate_basis)};
+    const models::hubbard_real_space::FermiJump1D<double, Basis> jump(basis, lattice, ev_function,
+                                                                      k_F);
+
+    for(uint64_t cutoff = 0; cutoff <= 4; ++cutoff) {
+        const TruncatedBasis truncated_basis(lattice, cutoff);
+        const auto v = make_vector(truncated_basis.size());
+        Vector h;
+        models::hubbard_real_space::truncated_to_real_space(truncated_basis, v, h);
+
+        const auto truncated_site_occupation =
+            models::hubbard_real_space::SiteOccupation<double, TruncatedBasis>{
+                ev_function, std::cref(truncated_basis)};
+        REQUIRE(truncated_site_occupation(v) == Approx(site_occupation(h)));
+
+        const models::hubbard_real_space::FermiJump1D<double, TruncatedBasis> truncated_jump(
+            truncated_basis, lattice, ev_function, k_F);
+        REQUIRE(truncated_jump(v) == Approx(jump(h)));
+    }
+}
+
+TEST_CASE("fermi jump (2d)")
+{
+    const lattices::PeriodicSquareLattice<double, uint64_t> lattice(4, 4);
+    const models::hubbard_real_space::ExpectationValue2DHalfFilled<double, decltype(lattice)> ev(
+        lattice);
+    const auto ev_function = [&ev](const Operator& a, const Operator& b) {
+        return ev(a.index1, b.index1);
+    };
+    const typename decltype(lattice)::Vector k_F{HalfPi<double>::value, HalfPi<double>::value};
+
+    const Basis basis(lattice);
+    const models::hubbard_real_space::FermiJump2D<double, Basis> jump(basis, lattice, ev_function,
+                                                                      k_F);
+
+    for(uint64_t cutoff = 1; cutoff <= 2; ++cutoff) {
+        const TruncatedBasis truncated_basis(lattice, cutoff);
+        const auto v = make_vector(truncated_basis.size());
+        Vector h;
+        models::hubbard_real_space::truncated_to_real_space(truncated_basis, v, h);
+
+        const models::hubbard_real_space::FermiJump2D<double, TruncatedBasis> truncated_jump(
+            truncated_basis, lattice, ev_function, k_F);
+        REQUIRE(truncated_jump(v) == Approx(jump(h)));
+    }
+}
@@ -0,0 +1,60 @@
+#ifndef TESTS_ODE_HUBBARD_CHAIN_HPP_
+#define TESTS_ODE_HUBBARD_CHAIN_HPP_
+
+#include <catch.hpp>
+
+#include <complex>
+
+#include <ieompp/algebra/monomial.hpp>
+#include <ieompp/algebra/operator.hpp>
+#include <ieompp/lattices/periodic_chain.hpp>
+#include <ieompp/models/hubbard_real_space/basis.hpp>
+#include <ieompp/models/hubbard_real_space/blaze_sparse.hpp>
+#include <ieompp/models/hubbard_real_space/liouvillian.hpp>
+#include <ieompp/ode/rk4.hpp>
+#include <ieompp/types/blaze.hpp>
+#include <ieompp/types/compressed_row_matrix.hpp>
+
+using Operator = ieompp::algebra::Operator<uint64_t, bool>;
+using Monomial = ieompp::algebra::Monomial<Operator>;
+using Basis    = ieompp::models::hubbard_real_space::Basis3Operator<Monomial>;
+using Matrix   = ieompp::types::CompressedRowMatrix<double>;
+using Vector   = blaze::DynamicVector<std::complex<double>>;
+
+// Liouvillian of the Hubbard model with J = 1.3 and U = 0.7 on a periodic chain, the integrators
+// are compared with RK4 started from the same initial state
+struct HubbardChain {
+    const ieompp::lattices::PeriodicChain<double, uint64_t> lattice;
+    const Basis basis;
+    Matrix matrix;
+
+    explicit HubbardChain(uint64_t sites = 8) : lattice(sites, 1.), basis(lattice)
+    {
+        const auto liouvillian = ieompp::models::hubbard_real_space::make_liouvillian(1.3, 0.7);
+        ieompp::models::hubbard_real_space::init_matrix_parallel(liouvillian, matrix, basis,
+                                                                 lattice);
+    }
+
+    std::size_t size() const { return basis.size(); }
+
+    // the vector (1, 0, 0, …)
+    Vector initial_state() const
+    {
+        Vector u(size());
+        u.reset();
+        u[0] = 1.;
+        return u;
+    }
+
+    // propagate u by steps RK4 steps of width dt, the default is accurate enough to serve as
+    // reference for the tolerances of the tests
+    void propagate_reference(Vector& u, int steps, double dt = 0.001) const
+    {
+        const ieompp::ode::RK4<double> rk4(size(), dt);
+        for(int step = 0; step < steps; ++step) {
+            rk4.step_imaginary(matrix, u);
+        }
+    }
+};
+
+#endif
@@ -0,0 +1,34 @@
+#define CATCH_CONFIG_MAIN
+#include "hubbard_chain.hpp"
+
+#include <cmath>
+
+#include <ieompp/ode/active_set_rk4.hpp>
+using namespace ieompp;
+
+TEST_CASE("active set")
+{
+    const HubbardChain chain(12);
+
+    for(const double tolerance : {0., 1e-10}) {
+        ode::ActiveSetRK4<double> active_set_rk4(chain.size(), 0.01, tolerance);
+
+        Vector u        = chain.initial_state();
+        Vector u_active = u;
+
+        bool was_sparse = false;
+        for(int step = 0; step < 200; ++step) {
+            chain.propagate_reference(u, 1, 0.01);
+            active_set_rk4.step_imaginary(chain.matrix, u_active);
+            was_sparse = was_sparse || (active_set_rk4.active() < chain.size() / 10);
+        }
+        REQUIRE(was_sparse);
+        REQUIRE(active_set_rk4.is_dense());
+
+        // without a tolerance the steps are exact
+        const double max_deviation = (tolerance == 0.) ? 1e-12 : 1e-8;
+        for(std::size_t i = 0; i < chain.size(); ++i) {
+            REQUIRE(std::abs(u_active[i] - u[i]) < max_deviation);
+        }
+    }
+}
@@ -0,0 +1,44 @@
+#define CATCH_CONFIG_MAIN
+#include "hubbard_chain.hpp"
+
+#include <cmath>
+
+#include <ieompp/ode/chebyshev.hpp>
+using namespace ieompp;
+
+TEST_CASE("bessel_functions")
+{
+    // J_0(1), J_1(1), J_2(1) and J_20(10) to ten digits
+    const auto J = ode::bessel_functions(1., 3);
+    REQUIRE(std::abs(J[0] - 0.7651976866) < 1e-10);
+    REQUIRE(std::abs(J[1] - 0.4400505857) < 1e-10);
+    REQUIRE(std::abs(J[2] - 0.1149034849) < 1e-10);
+    REQUIRE(std::abs(ode::bessel_functions(10., 21)[20] - 1.151336925e-5) < 1e-14);
+}
+
+TEST_CASE("Chebyshev propagator")
+{
+    const HubbardChain chain;
+
+    ode::Chebyshev<double> single(chain.size(), 0.5, 1e-12);
+    ode::Chebyshev<double> multiple(chain.size(), 0.5, 1e-12, 4);
+
+    Vector reference  = chain.initial_state();
+    Vector u_single   = reference;
+    Vector u_multiple = reference;
+
+    for(int interval = 1; interval <= 4; ++interval) {
+        chain.propagate_reference(reference, 500);
+        single.step_imaginary(chain.matrix, u_single);
+        multiple.step_imaginary(chain.matrix, u_multiple);
+        for(std::size_t i = 0; i < chain.size(); ++i) {
+            REQUIRE(std::abs(u_single[i] - reference[i]) < 1e-9);
+            REQUIRE(std::abs(u_multiple[i] - reference[i]) < 1e-9);
+        }
+    }
+
+    // the states after all four steps come from a single expansion
+    REQUIRE(single.expansions() == 4);
+    REQUIRE(multiple.expansions() == 1);
+    REQUIRE(multiple.products() < single.products());
+}
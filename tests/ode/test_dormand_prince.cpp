@@ -0,0 +1,32 @@
+#define CATCH_CONFIG_MAIN
+#include "hubbard_chain.hpp"
+
+#include <cmath>
+
+#include <ieompp/ode/dormand_prince.hpp>
+using namespace ieompp;
+
+TEST_CASE("Dormand-Prince")
+{
+    const HubbardChain chain;
+
+    // the error of the reference is far below the tolerance
+    ode::DormandPrince<double> dormand_prince(chain.size(), 0.25, 1e-9, 1e-9);
+
+    Vector reference = chain.initial_state();
+    Vector u         = reference;
+
+    for(int interval = 1; interval <= 4; ++interval) {
+        chain.propagate_reference(reference, 250);
+        dormand_prince.step_imaginary(chain.matrix, u);
+        for(std::size_t i = 0; i < chain.size(); ++i) {
+            REQUIRE(std::abs(u[i] - reference[i]) < 1e-7);
+        }
+    }
+
+    // every interval ends with a shortened step, the stages are reused between the calls
+    REQUIRE(dormand_prince.accepted_steps() >= 4);
+    REQUIRE(dormand_prince.accepted_steps() < 1000);
+    REQUIRE(dormand_prince.products()
+            == 1 + 6 * (dormand_prince.accepted_steps() + dormand_prince.rejected_steps()));
+}
@@ -0,0 +1,34 @@
+#define CATCH_CONFIG_MAIN
+#include "hubbard_chain.hpp"
+
+#include <cmath>
+
+#include <ieompp/ode/fused_rk4.hpp>
+using namespace ieompp;
+
+TEST_CASE("fused RK4")
+{
+    const HubbardChain chain;
+
+    ode::FusedRK4<double> fused_rk4(chain.size(), 0.01);
+    const ode::FusedRK4<double> shared_rk4(chain.size(), 0.01);
+    ode::FusedRK4<double>::Workspace workspace(chain.size());
+
+    Vector u      = chain.initial_state();
+    Vector u_own  = u;
+    Vector u_ws   = u;
+    Vector u_back = u;
+
+    // two integrators and an external workspace are used alternately
+    for(int step = 0; step < 50; ++step) {
+        chain.propagate_reference(u, 1, 0.01);
+        fused_rk4.step_imaginary(chain.matrix, u_own);
+        shared_rk4.step_imaginary(chain.matrix, u_ws, workspace);
+        fused_rk4.step_imaginary(chain.matrix, u_back);
+    }
+    for(std::size_t i = 0; i < chain.size(); ++i) {
+        REQUIRE(std::abs(u_own[i] - u[i]) < 1e-12);
+        REQUIRE(u_ws[i] == u_own[i]);
+        REQUIRE(u_back[i] == u_own[i]);
+    }
+}
@@ -0,0 +1,33 @@
+#define CATCH_CONFIG_MAIN
+#include "hubbard_chain.hpp"
+
+#include <cmath>
+
+#include <ieompp/ode/krylov.hpp>
+using namespace ieompp;
+
+TEST_CASE("Krylov propagator")
+{
+    const HubbardChain chain;
+
+    ode::Krylov<double> lanczos(chain.size(), 0.5, 20, 1e-10);
+    ode::Krylov<double> arnoldi(chain.size(), 0.5, 20, 1e-10, false);
+
+    Vector reference = chain.initial_state();
+    Vector u_lanczos = reference;
+    Vector u_arnoldi = reference;
+
+    for(int interval = 1; interval <= 4; ++interval) {
+        chain.propagate_reference(reference, 500);
+        lanczos.step_imaginary(chain.matrix, u_lanczos);
+        arnoldi.step_imaginary(chain.matrix, u_arnoldi);
+        for(std::size_t i = 0; i < chain.size(); ++i) {
+            REQUIRE(std::abs(u_lanczos[i] - reference[i]) < 1e-8);
+            REQUIRE(std::abs(u_arnoldi[i] - reference[i]) < 1e-8);
+        }
+    }
+
+    // rejected substeps need no products, RK4 with dt = 0.01 would need 800 products until t = 2
+    REQUIRE(lanczos.products() == 20 * lanczos.substeps());
+    REQUIRE(lanczos.products() < 800);
+}
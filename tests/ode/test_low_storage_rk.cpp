@@ -0,0 +1,42 @@
+#define CATCH_CONFIG_MAIN
+#include "hubbard_chain.hpp"
+
+#include <algorithm>
+#include <cmath>
+
+#include <ieompp/ode/low_storage_rk.hpp>
+using namespace ieompp;
+
+TEST_CASE("low-storage Runge-Kutta")
+{
+    using LowStorageRK = ode::LowStorageRK<double>;
+
+    const HubbardChain chain;
+
+    Vector reference = chain.initial_state();
+    chain.propagate_reference(reference, 1000);
+
+    // the error at t = 1 decreases with the order of the scheme when the step size is halved
+    const auto error = [&](const LowStorageRK::Tableau& tableau, double dt) {
+        LowStorageRK integrator(chain.size(), dt, tableau);
+        Vector u = chain.initial_state();
+        for(int step = 0; step < int(std::round(1. / dt)); ++step) {
+            integrator.step_imaginary(chain.matrix, u);
+        }
+        double deviation = 0.;
+        for(std::size_t i = 0; i < chain.size(); ++i) {
+            deviation = std::max(deviation, std::abs(u[i] - reference[i]));
+        }
+        return deviation;
+    };
+
+    const auto fourth_order = LowStorageRK::Tableau::carpenter_kennedy_4();
+    REQUIRE(error(fourth_order, 0.01) < 1e-8);
+    REQUIRE(error(fourth_order, 0.04) / error(fourth_order, 0.02) > 12.);
+
+    const auto third_order = LowStorageRK::Tableau::williamson_3();
+    REQUIRE(error(third_order, 0.01) < 1e-5);
+    const double ratio = error(third_order, 0.04) / error(third_order, 0.02);
+    REQUIRE(ratio > 6.);
+    REQUIRE(ratio < 12.);
+}
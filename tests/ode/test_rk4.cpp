@@ -0,0 +1,61 @@
+#define CATCH_CONFIG_MAIN
+#include <catch.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+
+#include <ieompp/algebra/monomial.hpp>
+#include <ieompp/algebra/operator.hpp>
+#include <ieompp/lattices/periodic_chain.hpp>
+#include <ieompp/models/hubbard_real_space/basis.hpp>
+#include <ieompp/models/hubbard_real_space/blaze_sparse.hpp>
+#include <ieompp/models/hubbard_real_space/liouvillian.hpp>
+#include <ieompp/ode/rk4.hpp>
+#include <ieompp/types/blaze.hpp>
+#include <ieompp/types/compressed_row_matrix.hpp>
+using namespace ieompp;
+
+using Operator = algebra::Operator<uint64_t, bool>;
+using Monomial = algebra::Monomial<Operator>;
+using Basis    = models::hubbard_real_space::Basis3Operator<Monomial>;
+using Vector   = blaze::DynamicVector<std::complex<double>>;
+
+TEST_CASE("step_imaginary")
+{
+    const auto liouvillian = models::hubbard_real_space::make_liouvillian(1.3, 0.7);
+    const lattices::PeriodicChain<double, uint64_t> lattice(8, 1.);
+    const Basis basis(lattice);
+
+    types::CompressedRowMatrix<double> m;
+    models::hubbard_real_space::init_matrix_parallel(liouvillian, m, basis, lattice);
+
+    // i * m stored as a complex matrix for the plain step
+    types::CompressedRowMatrix<std::complex<double>> im(m.rows(), m.columns());
+    im.reserve(m.non_zeros());
+    for(std::size_t row = 0; row < m.rows(); ++row) {
+        for(auto it = m.begin(row); it != m.end(row); ++it) {
+            im.append(row, it->index(), std::complex<double>(0., it->value()));
+        }
+        im.finalize(row);
+    }
+
+    Vector u(basis.size()), reference(basis.size());
+    for(std::size_t i = 0; i < basis.size(); ++i) {
+        u[i] = std::complex<double>(std::cos(0.3 * i), std::sin(0.7 * i));
+    }
+    reference = u;
+
+    const ode::RK4<double> rk4(basis.size(), 0.01);
+    for(int step = 0; step < 100; ++step) {
+        rk4.step_imaginary(m, u);
+        rk4.step(im, reference);
+    }
+
+    double deviation = 0., norm = 0.;
+    for(std::size_t i = 0; i < basis.size(); ++i) {
+        deviation = std::max(deviation, std::abs(u[i] - reference[i]));
+        norm      = std::max(norm, std::abs(reference[i]));
+    }
+    REQUIRE(deviation <= 1e-13 * norm);
+}
@@ -0,0 +1,132 @@
+#define CATCH_CONFIG_MAIN
+#include <catch.hpp>
+
+#include <complex>
+#include <cstdint>
+
+#include <ieompp/types/blaze.hpp>
+#include <ieompp/types/compressed_row_matrix.hpp>
+#include <ieompp/types/row_assembly.hpp>
+#include <ieompp/types/triplet.hpp>
+using namespace ieompp;
+
+using TripletList = types::TripletList<double, uint32_t>;
+using Matrix      = types::CompressedRowMatrix<double>;
+using Vector      = blaze::DynamicVector<std::complex<double>>;
+
+// unsorted entries of row with duplicate columns, the entries of column row + 2 cancel but
+// are kept as an explicit zero where they are the last ones of the row
+void fill_row(uint32_t row, uint32_t columns, TripletList& triplets)
+{
+    triplets.clear();
+    triplets.emplace_back(row, (row + 1) % columns, 1.5);
+    triplets.emplace_back(row, (row + 2) % columns, 0.5);
+    triplets.emplace_back(row, row, -2.);
+    triplets.emplace_back(row, (row + 1) % columns, row + 1.);
+    triplets.emplace_back(row, (row + 2) % columns, -0.5);
+    triplets.sort();
+    triplets.merge_columns();
+}
+
+TEST_CASE("merge_columns")
+{
+    TripletList triplets;
+    triplets.emplace_back(0, 0, 1.);
+    triplets.emplace_back(0, 0, 2.);
+    triplets.emplace_back(0, 1, 3.);
+    triplets.emplace_back(0, 2, 4.);
+    triplets.emplace_back(0, 2, -4.);
+    triplets.emplace_back(0, 3, 5.);
+    triplets.emplace_back(0, 3, -1.);
+
+    const auto reference = triplets.make_columns_unique();
+    triplets.merge_columns();
+    REQUIRE(triplets.size() == 3);
+    REQUIRE(triplets.size() == reference.size());
+    for(std::size_t i = 0; i < triplets.size(); ++i) {
+        REQUIRE(triplets[i].column == reference[i].column);
+        REQUIRE(triplets[i].value == reference[i].value);
+    }
+    REQUIRE(triplets.has_unique_columns());
+
+    TripletList empty;
+    empty.merge_columns();
+    REQUIRE(empty.empty());
+}
+
+TEST_CASE("assemble_rows_parallel")
+{
+    const uint32_t size = 100;
+
+    const auto rows = types::assemble_rows_parallel<double>(
+        size, [&](uint32_t row, TripletList& triplets) { fill_row(row, size, triplets); }, 5);
+    REQUIRE(rows.rows() == size);
+
+    Matrix matrix(size, size);
+    matrix.reserve(rows.non_zeros());
+    types::append_rows(matrix, rows);
+    REQUIRE(matrix.non_zeros() == rows.non_zeros());
+
+    // serial construction of the same matrix
+    Matrix reference(size, size);
+    TripletList triplets;
+    for(uint32_t row = 0; row < size; ++row) {
+        fill_row(row, size, triplets);
+        for(const auto& triplet : triplets) {
+            reference.append(row, triplet.column, triplet.value);
+        }
+        reference.finalize(row);
+    }
+    REQUIRE(matrix.row_pointers() == reference.row_pointers());
+    REQUIRE(matrix.column_indices() == reference.column_indices());
+    REQUIRE(matrix.values() == reference.values());
+
+    Vector x(size), y(size);
+    for(uint32_t i = 0; i < size; ++i) {
+        x[i] = std::complex<double>(i, 1.);
+    }
+    matrix.multiply(x, y);
+    for(uint32_t row = 0; row < size; ++row) {
+        const auto expected = -2. * x[row] + (row + 2.5) * x[(row + 1) % size];
+        REQUIRE(std::abs(y[row] - expected) < 1e-12);
+    }
+}
+
+TEST_CASE("assign_rows")
+{
+    const uint32_t size = 100;
+    auto assemble       = [&] {
+        return types::assemble_rows_parallel<double>(
+            size, [&](uint32_t row, TripletList& triplets) { fill_row(row, size, triplets); }, 5);
+    };
+
+    Matrix reference(size, size);
+    types::append_rows(reference, assemble());
+
+    // takes over the arrays
+    Matrix matrix;
+    types::assign_rows(matrix, size, assemble());
+    REQUIRE(matrix.rows() == size);
+    REQUIRE(matrix.columns() == size);
+    REQUIRE(matrix.row_pointers() == reference.row_pointers());
+    REQUIRE(matrix.column_indices() == reference.column_indices());
+    REQUIRE(matrix.values() == reference.values());
+
+    // converts the row pointers
+    types::CompressedRowMatrix<double, uint32_t, uint32_t> narrow;
+    types::assign_rows(narrow, size, assemble());
+    REQUIRE(narrow.non_zeros() == reference.non_zeros());
+    for(uint32_t row = 0; row <= size; ++row) {
+        REQUIRE(narrow.row_pointers()[row] == reference.row_pointers()[row]);
+    }
+    REQUIRE(narrow.column_indices() == reference.column_indices());
+    REQUIRE(narrow.values() == reference.values());
+}
+
+TEST_CASE("CompressedRowMatrix index range")
+{
+    types::CompressedRowMatrix<double, uint8_t> matrix;
+    REQUIRE_THROWS(matrix.resize(300, 2));
+    matrix.resize(255, 255);
+    REQUIRE(matrix.rows() == 255);
+}
@@ -0,0 +1,112 @@
+#define CATCH_CONFIG_MAIN
+#include <catch.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <cstdint>
+#include <vector>
+
+#include <ieompp/types/blaze.hpp>
+#include <ieompp/types/compressed_row_matrix.hpp>
+#include <ieompp/types/growing_row_matrix.hpp>
+#include <ieompp/types/multiply_assign.hpp>
+using namespace ieompp;
+
+using Matrix = types::GrowingRowMatrix<double>;
+using Vector = blaze::DynamicVector<std::complex<double>>;
+
+// element (row, column) of a tridiagonal test matrix
+double element(uint32_t row, uint32_t column)
+{
+    return std::cos(row + 0.5 * column);
+}
+
+// append the elements of the tridiagonal matrix that are not in the first rows and columns of
+// matrix, which have been appended before
+void append_elements(Matrix& matrix, uint32_t rows, uint32_t columns)
+{
+    for(uint32_t row = 0; row < matrix.rows(); ++row) {
+        const uint32_t begin = std::max((row < rows) ? columns : 0, (row == 0) ? 0 : row - 1);
+        for(uint32_t column = begin; column < std::min(matrix.columns(), row + 2); ++column) {
+            matrix.append(row, column, element(row, column));
+        }
+    }
+}
+
+TEST_CASE("grow")
+{
+    // the matrix grows in two steps, the new columns are appended to the rows of the first step
+    Matrix matrix(10, 10);
+    append_elements(matrix, 0, 0);
+    REQUIRE(matrix.non_zeros() == 3 * 10 - 2);
+
+    matrix.resize(25, 25);
+    REQUIRE(matrix.rows() == 25);
+    REQUIRE(matrix.columns() == 25);
+    append_elements(matrix, 10, 10);
+    REQUIRE(matrix.non_zeros() == 3 * 25 - 2);
+
+    // same elements as a matrix built at its final size
+    types::CompressedRowMatrix<double> reference(25, 25);
+    for(uint32_t row = 0; row < 25; ++row) {
+        for(uint32_t column = (row == 0) ? 0 : row - 1; column < std::min(25u, row + 2);
+            ++column) {
+            reference.append(row, column, element(row, column));
+        }
+        reference.finalize(row);
+    }
+    for(uint32_t row = 0; row < 25; ++row) {
+        const auto& columns = matrix.column_indices(row);
+        const auto& values  = matrix.values(row);
+        REQUIRE(columns.size() == values.size());
+
+        std::size_t pos = 0;
+        for(auto it = reference.begin(row); it != reference.end(row); ++it, ++pos) {
+            REQUIRE(pos < columns.size());
+            REQUIRE(columns[pos] == it->index());
+            REQUIRE(values[pos] == it->value());
+        }
+        REQUIRE(pos == columns.size());
+    }
+
+    Vector x(25), y(25), y_reference(25);
+    for(uint32_t i = 0; i < 25; ++i) {
+        x[i] = std::complex<double>(std::sin(0.3 * i), i);
+    }
+    matrix.multiply(x, y);
+    reference.multiply(x, y_reference);
+    for(uint32_t i = 0; i < 25; ++i) {
+        REQUIRE(std::abs(y[i] - y_reference[i]) < 1e-12);
+    }
+
+    // the stage vectors of the integrators are of a different type than the vector
+    std::vector<std::complex<double>> z(25);
+    matrix.multiply(x, z);
+    for(uint32_t i = 0; i < 25; ++i) {
+        REQUIRE(z[i] == y[i]);
+    }
+
+    types::multiply_assign(matrix, x);
+    for(uint32_t i = 0; i < 25; ++i) {
+        REQUIRE(x[i] == y[i]);
+    }
+}
+
+TEST_CASE("reset")
+{
+    Matrix matrix(5, 5);
+    append_elements(matrix, 0, 0);
+    matrix.reset();
+    REQUIRE(matrix.non_zeros() == 0);
+    REQUIRE(matrix.rows() == 5);
+    for(uint32_t row = 0; row < 5; ++row) {
+        REQUIRE(matrix.column_indices(row).empty());
+    }
+}
+
+TEST_CASE("GrowingRowMatrix index range")
+{
+    types::GrowingRowMatrix<double, uint8_t> matrix(200, 200);
+    REQUIRE_THROWS(matrix.resize(300, 300));
+}
@@ -0,0 +1,78 @@
+#define CATCH_CONFIG_MAIN
+#include <catch.hpp>
+
+#include <cstdint>
+#include <vector>
+
+#include <ieompp/types/hash_index.hpp>
+using namespace ieompp;
+
+using HashIndex = types::HashIndex<uint64_t>;
+
+// distinct keys spread over the whole range of uint64_t
+uint64_t key(uint64_t i)
+{
+    return i * 0x9e3779b97f4a7c15ull + 3;
+}
+
+TEST_CASE("construction")
+{
+    std::vector<uint64_t> keys(1000);
+    for(uint64_t i = 0; i < keys.size(); ++i) {
+        keys[i] = key(i);
+    }
+    const HashIndex index(keys);
+
+    REQUIRE(index.size() == keys.size());
+    for(uint64_t i = 0; i < keys.size(); ++i) {
+        REQUIRE(index.find(keys[i]) == i);
+    }
+    REQUIRE(index.find(key(1000)) == HashIndex::not_found);
+
+    const HashIndex empty;
+    REQUIRE(empty.size() == 0);
+    REQUIRE(empty.find(key(0)) == HashIndex::not_found);
+}
+
+TEST_CASE("insert")
+{
+    // the partitions of the small initial table are rehashed many times
+    std::vector<uint64_t> keys(100);
+    for(uint64_t i = 0; i < keys.size(); ++i) {
+        keys[i] = key(i);
+    }
+    HashIndex index(keys);
+
+    const uint64_t size = 20000;
+    for(uint64_t i = keys.size(); i < size; ++i) {
+        const auto result = index.insert(key(i), i);
+        REQUIRE(result.first == i);
+        REQUIRE(result.second);
+    }
+    REQUIRE(index.size() == size);
+
+    // the elements of the constructor and of all partitions survive the rehashing
+    for(uint64_t i = 0; i < size; ++i) {
+        REQUIRE(index.find(key(i)) == i);
+    }
+    for(uint64_t i = size; i < 2 * size; ++i) {
+        REQUIRE(index.find(key(i)) == HashIndex::not_found);
+    }
+
+    // contained keys keep their value
+    const auto result = index.insert(key(42), 7);
+    REQUIRE(result.first == 42);
+    REQUIRE(!result.second);
+    REQUIRE(index.size() == size);
+}
+
+TEST_CASE("insert into empty index")
+{
+    HashIndex index;
+    for(uint64_t i = 0; i < 1000; ++i) {
+        REQUIRE(index.insert(key(i), i).second);
+    }
+    for(uint64_t i = 0; i < 1000; ++i) {
+        REQUIRE(index.find(key(i)) == i);
+    }
+}
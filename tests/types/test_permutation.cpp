@@ -0,0 +1,98 @@
+#define CATCH_CONFIG_MAIN
+#include <catch.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <cstdint>
+#include <vector>
+
+#include <ieompp/types/blaze.hpp>
+#include <ieompp/types/compressed_row_matrix.hpp>
+#include <ieompp/types/permutation.hpp>
+using namespace ieompp;
+
+using Matrix      = types::CompressedRowMatrix<double>;
+using Permutation = types::Permutation<uint32_t>;
+using Vector      = blaze::DynamicVector<std::complex<double>>;
+
+// new index i is the old index (7 * i) % size, a permutation for sizes that are not divisible by 7
+Permutation make_permutation(uint32_t size)
+{
+    std::vector<uint32_t> new_to_old(size);
+    for(uint32_t i = 0; i < size; ++i) {
+        new_to_old[i] = (7 * i) % size;
+    }
+    return Permutation(std::move(new_to_old));
+}
+
+Vector make_vector(uint32_t size)
+{
+    Vector x(size);
+    for(uint32_t i = 0; i < size; ++i) {
+        x[i] = std::complex<double>(i, -0.5 * i);
+    }
+    return x;
+}
+
+TEST_CASE("apply and restore")
+{
+    const uint32_t size    = 30;
+    const auto permutation = make_permutation(size);
+    const auto x           = make_vector(size);
+
+    const auto permuted = permutation.apply(x);
+    for(uint32_t i = 0; i < size; ++i) {
+        REQUIRE(permutation.new_index(permutation.old_index(i)) == i);
+        REQUIRE(permuted[i] == x[permutation.old_index(i)]);
+    }
+
+    const auto restored = permutation.restore(permuted);
+    for(uint32_t i = 0; i < size; ++i) {
+        REQUIRE(restored[i] == x[i]);
+    }
+
+    // the inverse permutation undoes apply
+    const auto inverse = permutation.inverse().apply(permuted);
+    for(uint32_t i = 0; i < size; ++i) {
+        REQUIRE(inverse[i] == x[i]);
+    }
+
+    const auto identity = Permutation::identity(size).apply(x);
+    for(uint32_t i = 0; i < size; ++i) {
+        REQUIRE(identity[i] == x[i]);
+    }
+}
+
+TEST_CASE("permute matrix")
+{
+    // an open chain with next and second-next neighbor hopping, a band matrix of bandwidth 2
+    const uint32_t size = 30;
+    Matrix matrix(size, size);
+    for(uint32_t row = 0; row < size; ++row) {
+        for(uint32_t column = (row < 2) ? 0 : row - 2; column < std::min(size, row + 3);
+            ++column) {
+            matrix.append(row, column, std::cos(double(row + 2 * column)));
+        }
+        matrix.finalize(row);
+    }
+
+    // multiplying in the permuted order and restoring the result gives the original product
+    const auto permutation = make_permutation(size);
+    const auto permuted    = types::permute(matrix, permutation);
+    REQUIRE(permuted.non_zeros() == matrix.non_zeros());
+
+    const auto x = make_vector(size);
+    Vector y(size), y_permuted(size);
+    matrix.multiply(x, y);
+    permuted.multiply(permutation.apply(x), y_permuted);
+    const auto y_restored = permutation.restore(y_permuted);
+    for(uint32_t i = 0; i < size; ++i) {
+        REQUIRE(std::abs(y_restored[i] - y[i]) < 1e-12);
+    }
+
+    // reverse Cuthill-McKee undoes the scrambling of the band
+    const auto rcm = types::reverse_cuthill_mckee(permuted);
+    REQUIRE(types::bandwidth(permuted) > types::bandwidth(matrix));
+    REQUIRE(types::bandwidth(types::permute(permuted, rcm)) <= 2 * types::bandwidth(matrix));
+}
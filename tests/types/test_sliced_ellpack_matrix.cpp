@@ -0,0 +1,117 @@
+#define CATCH_CONFIG_MAIN
+#include <catch.hpp>
+
+#include <cmath>
+#include <complex>
+#include <cstdint>
+#include <vector>
+
+#include <ieompp/types/blaze.hpp>
+#include <ieompp/types/compressed_row_matrix.hpp>
+#include <ieompp/types/multiply_assign.hpp>
+#include <ieompp/types/sliced_ellpack_matrix.hpp>
+using namespace ieompp;
+
+using Matrix = types::CompressedRowMatrix<double>;
+using Vector = blaze::DynamicVector<std::complex<double>>;
+
+// rows of very different lengths including empty ones, the number of rows is no multiple of the
+// chunk sizes
+Matrix make_irregular_matrix(uint32_t size)
+{
+    Matrix matrix(size, size);
+    for(uint32_t row = 0; row < size; ++row) {
+        if(row % 7 != 3) {
+            const uint32_t stride = size / ((row * 13) % 11 + 1) + 1;
+            for(uint32_t column = row % 5; column < size; column += stride) {
+                matrix.append(row, column, std::sin(row + 0.1 * column));
+            }
+        }
+        matrix.finalize(row);
+    }
+    return matrix;
+}
+
+Vector make_vector(uint32_t size)
+{
+    Vector x(size);
+    for(uint32_t i = 0; i < size; ++i) {
+        x[i] = std::complex<double>(std::cos(0.3 * i), std::sin(0.7 * i));
+    }
+    return x;
+}
+
+TEST_CASE("multiply")
+{
+    for(const uint32_t size : {1u, 7u, 61u, 200u}) {
+        const auto matrix = make_irregular_matrix(size);
+        const auto x      = make_vector(size);
+        Vector y(size), y_8(size), y_3(size), y_4(size);
+        matrix.multiply(x, y);
+
+        const types::SlicedEllpackMatrix<double> sliced_ellpack(matrix);
+        const types::SlicedEllpackMatrix<double, uint32_t, 3> sliced_ellpack_3(matrix, 7);
+        const types::SlicedEllpackMatrix<double, uint32_t, 4> sliced_ellpack_4(matrix, 1);
+        REQUIRE(sliced_ellpack.rows() == size);
+        REQUIRE(sliced_ellpack.columns() == size);
+        REQUIRE(sliced_ellpack.stored_elements() >= matrix.non_zeros());
+
+        sliced_ellpack.multiply(x, y_8);
+        sliced_ellpack_3.multiply(x, y_3);
+        sliced_ellpack_4.multiply(x, y_4);
+        for(uint32_t i = 0; i < size; ++i) {
+            REQUIRE(std::abs(y_8[i] - y[i]) < 1e-12);
+            REQUIRE(std::abs(y_3[i] - y[i]) < 1e-12);
+            REQUIRE(std::abs(y_4[i] - y[i]) < 1e-12);
+        }
+
+        Vector z = x;
+        types::multiply_assign(sliced_ellpack, z);
+        for(uint32_t i = 0; i < size; ++i) {
+            REQUIRE(std::abs(z[i] - y[i]) < 1e-12);
+        }
+    }
+}
+
+TEST_CASE("sorting window")
+{
+    // sorting the rows within windows reduces the padding but keeps the product
+    const uint32_t size = 200;
+    const auto matrix   = make_irregular_matrix(size);
+    const types::SlicedEllpackMatrix<double> unsorted(matrix, 1);
+    const types::SlicedEllpackMatrix<double> sorted(matrix, size);
+    REQUIRE(sorted.stored_elements() <= unsorted.stored_elements());
+
+    const auto x = make_vector(size);
+    Vector y_unsorted(size), y_sorted(size);
+    unsorted.multiply(x, y_unsorted);
+    sorted.multiply(x, y_sorted);
+    for(uint32_t i = 0; i < size; ++i) {
+        REQUIRE(std::abs(y_sorted[i] - y_unsorted[i]) < 1e-12);
+    }
+}
+
+TEST_CASE("chunk kernels")
+{
+    // matrices whose doubled column indices exceed 32 bits are multiplied with the scalar kernel,
+    // it has to agree with the kernel used for smaller matrices
+    constexpr std::size_t C = 8;
+    const std::size_t length = 5, size = 50;
+    std::vector<double> values(length * C);
+    std::vector<uint32_t> columns(length * C);
+    for(std::size_t i = 0; i < length * C; ++i) {
+        values[i]  = std::cos(double(i));
+        columns[i] = (i * 17) % size;
+    }
+    const auto x = make_vector(size);
+
+    using Value = std::complex<double>;
+    Value scalar[C], vectorized[C];
+    types::detail::SlicedEllpackScalarChunk<double, Value, uint32_t, C>::apply(
+        length, values.data(), columns.data(), &x[0], scalar);
+    types::detail::SlicedEllpackChunk<double, Value, uint32_t, C>::apply(
+        length, values.data(), columns.data(), &x[0], vectorized);
+    for(std::size_t r = 0; r < C; ++r) {
+        REQUIRE(std::abs(scalar[r] - vectorized[r]) < 1e-12);
+    }
+}